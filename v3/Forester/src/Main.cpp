@@ -44,6 +44,11 @@ using std::iterator;
 #include "treenet/TreeNETEnvironment.h"
 #include "treenet/utils/SubnetParser.h"
 #include "treenet/utils/IPDictionnaryParser.h"
+#include "treenet/utils/DatasetGenerator.h"
+#include "treenet/utils/Benchmark.h"
+#include "treenet/utils/SimulatedNetwork.h"
+#include "prober/trace/TraceReplayer.h"
+#include "treenet/utils/TelemetryReporter.h"
 #include "treenet/tree/NetworkTree.h"
 #include "treenet/tree/growth/classic/ClassicGrower.h"
 #include "treenet/tree/growth/graft/Grafter.h"
@@ -57,6 +62,7 @@ const static unsigned short REDO_MODE_NOTHING = 0;
 const static unsigned short REDO_MODE_ALIASES = 1;
 const static unsigned short REDO_MODE_ALIAS_HINTS = 2;
 const static unsigned short REDO_MODE_ROUTES = 3;
+const static unsigned short REDO_MODE_VERIFIED_ROUTES = 4;
 
 // Simple function to display usage.
 
@@ -198,7 +204,7 @@ void printUsage()
     cout << "Short   Verbose                             Expected value\n";
     cout << "-----   -------                             --------------\n";
     cout << "\n";
-    cout << "-m      --redo-mode                         0, 1, 2 or 3\n";
+    cout << "-m      --redo-mode                         0, 1, 2, 3 or 4\n";
     cout << "\n";
     cout << "Use this option to have Forester re-do algorithmic steps as performed by\n";
     cout << "Arborist in order to complete and/or \"fix\" the provided data. Each possible\n";
@@ -230,6 +236,14 @@ void printUsage()
     cout << "  reason, it also checks the contra-pivot interface(s) to re-position the IPs\n";
     cout << "  of the whole subnet if necessary.\n";
     cout << "\n";
+    cout << "* 4: same as above, except that the routes of the provided data are verified\n";
+    cout << "  before being re-computed. For each subnet, Forester probes a pivot IP at the\n";
+    cout << "  TTL of the last hop and at the TTL of the middle hop of its route (with a\n";
+    cout << "  fixed flow), and only runs a full traceroute towards it if the replies do\n";
+    cout << "  not match the known route. Unchanged routes are kept as they are (with the\n";
+    cout << "  state of each hop). This is the mode to favor to re-measure regularly a\n";
+    cout << "  network which is mostly stable, as it only costs a few probes per subnet.\n";
+    cout << "\n";
     cout << "-o      --parsing-omit-merging              None (flag)\n";
     cout << "\n";
     cout << "Because datasets can get quite large, checking at each newly parsed subnet\n";
@@ -238,6 +252,74 @@ void printUsage()
     cout << "should be merged, can be a waste of time. Add this flag to your command line\n";
     cout << "to ask Forester to omit this verification.\n";
     cout << "\n"; 
+    cout << "-g      --growth-delta                      String\n";
+    cout << "\n";
+    cout << "Use this option to provide the prefix of a subnet dump (i.e., without the\n";
+    cout << ".subnet extension) listing new or re-measured subnets, along their routes.\n";
+    cout << "The tree of the main input dataset is still grown in full (offline, as usual),\n";
+    cout << "then Forester inserts these subnets in the tree without growing it again:\n";
+    cout << "subnets of the tree which overlap a new subnet are removed first, and only the\n";
+    cout << "branches touched by these changes are updated. This option therefore saves the\n";
+    cout << "probing work, not the growth: alias resolution and the output files still\n";
+    cout << "cover every neighborhood. If alias resolution hints are collected again (re-do\n";
+    cout << "mode 2 or 3), only the touched neighborhoods and the neighborhoods with hints\n";
+    cout << "which are no longer fresh (see -u) are probed, while the others keep the hints\n";
+    cout << "of the input IP dictionnary. Without -u, no hint is fresh, therefore every\n";
+    cout << "neighborhood is probed again. This option is ignored in grafting mode.\n";
+    cout << "\n";
+    cout << "-j      --synthetic-dataset                 String (key=value,key=value,...)\n";
+    cout << "\n";
+    cout << "Use this option to generate a synthetic dataset rather than processing one. The\n";
+    cout << "main argument is then the prefix of the dataset to create: Forester writes a\n";
+    cout << ".subnet dump, a .ip dictionnary (with as many IP-IDs per IP as set with -w)\n";
+    cout << "and the corresponding .alias file (ground truth), then stops. The network is a\n";
+    cout << "trunk of routers followed by random branches, each subnet being located behind\n";
+    cout << "a router of the branches. The dataset only depends on the following settings,\n";
+    cout << "which keep their default value when omitted (an empty string is valid):\n";
+    cout << "\n";
+    cout << "* seed (default 1) and subnets (default 10000, i.e., amount of subnets).\n";
+    cout << "* trunk (3), fanout (4) and depth (6): length of the trunk, average amount of\n";
+    cout << "  children per router and depth of the branches after the trunk.\n";
+    cout << "* hedera (0.05): probability for a router to have two ingress interfaces.\n";
+    cout << "* anonymous (0.01), stretch (0.005), cycle (0.005): probabilities for a hop to\n";
+    cout << "  be anonymous, for a route to be stretched or to contain a cycle.\n";
+    cout << "* healthy (0.6), random (0.1), echo (0.1): probabilities for a router to have\n";
+    cout << "  a healthy, random or echo IP-ID counter (the others do not reply).\n";
+    cout << "* named (0.2): probability for a router to have host names.\n";
+    cout << "* prefixes (24:1/28:2/29:4/30:8/31:2): weights of the prefix lengths (each\n";
+    cout << "  prefix length being in [20,31]).\n";
+    cout << "\n";
+    cout << "Subnets are located in 100.0.0.0 to 223.255.255.255 and router interfaces in\n";
+    cout << "10.0.0.0/8: settings which do not fit are rejected before writing any file.\n";
+    cout << "\n";
+    cout << "For example: -j subnets=100000,seed=7,anonymous=0.05 synthetic\n";
+    cout << "\n";
+    cout << "-q      --benchmark                         String (file name)\n";
+    cout << "\n";
+    cout << "Use this option to benchmark the offline steps of Forester on the input\n";
+    cout << "dataset: parsing, IP dictionnary creation and look-ups, insertion of subnets in\n";
+    cout << "a set (with and without merging), route post-processing, tree growth, look-ups\n";
+    cout << "in the tree, alias resolution and the outputs of the climbers, then compares\n";
+    cout << "the conversions of IPs and integers from/to text with the functions they\n";
+    cout << "replaced (on a million values). No probing takes place (re-do modes are\n";
+    cout << "ignored). For each step, the amount of operations, the total time, the\n";
+    cout << "throughput, latency percentiles and the peak memory usage are written in the\n";
+    cout << "given file as tab-separated values. Combined with -j, the synthetic dataset is\n";
+    cout << "generated then benchmarked, e.g.:\n";
+    cout << "\n";
+    cout << "-j subnets=100000 -q results.tsv -o synthetic\n";
+    cout << "\n";
+    cout << "-P      --telemetry                         String (file name)\n";
+    cout << "\n";
+    cout << "Use this option to write performance figures of the run in the given file: for\n";
+    cout << "each probing phase, the amounts of probes, replies, timeouts and socket errors,\n";
+    cout << "the distribution of the round-trip times and the amounts of probing tasks (in\n";
+    cout << "total, in flight and in flight at most), and for each algorithmic step (from\n";
+    cout << "parsing to outputs), the time spent, the probes sent and the peak memory usage.\n";
+    cout << "The file is re-written every 10 seconds during the run, then a last time at the\n";
+    cout << "end. It is written as Prometheus text if its name ends with .prom or .txt, and\n";
+    cout << "as JSON otherwise.\n";
+    cout << "\n";
     cout << "-e      --probing-egress-interface          IP or DNS\n";
     cout << "\n";
     cout << "Interface name through which probing/response packets exit/enter (default is\n";
@@ -285,6 +367,44 @@ void printUsage()
     cout << "pre-scanning phase (i.e., phase where the liveness of target IPs is checked).\n";
     cout << "By default, this value is set to 2500 (2,5 seconds).\n";
     cout << "\n";
+    cout << "-n      --probing-simulated                 String (key=value,key=value,...)\n";
+    cout << "\n";
+    cout << "Use this option to answer the probes with a simulated network rather than\n";
+    cout << "sending them, e.g., to test the probing phases or measure their performance\n";
+    cout << "without privileges nor network access. The network is built from the input\n";
+    cout << "dataset (its routes, its IP dictionnary and its .alias file, if any, which\n";
+    cout << "gives the routers and therefore the IP-ID counters) and answers immediately:\n";
+    cout << "latencies and the schedule of the IP-IDs collection follow a virtual clock\n";
+    cout << "rather than being waited for. It is configured with the following settings,\n";
+    cout << "which keep their default value when omitted (an empty string is valid):\n";
+    cout << "\n";
+    cout << "* seed (default 1): all random decisions derive from it and the probes.\n";
+    cout << "* latency (1000) and jitter (500): delay per hop and maximum jitter of the\n";
+    cout << "  replies, in microseconds (a reply arriving after the timeout is lost).\n";
+    cout << "* ratelimit (0): maximum amount of replies per second of a router (0 means no\n";
+    cout << "  limit).\n";
+    cout << "* loadbalancing (0), anonymous (0), loss (0): probabilities for a hop to be\n";
+    cout << "  load-balanced, for a router to never reply to expired probes and for a probe\n";
+    cout << "  to be lost.\n";
+    cout << "\n";
+    cout << "For example: -n latency=2000,ratelimit=100 -m 3 -r 0 -d 0 synthetic\n";
+    cout << "\n";
+    cout << "-T      --probing-trace                     String (file name)\n";
+    cout << "\n";
+    cout << "Use this option to record every probe and its reply (time, round-trip time,\n";
+    cout << "flow, TTL, IP-IDs, reply type/code and source, phase and prober which sent it)\n";
+    cout << "and the host names obtained by reverse DNS in a compact binary file. Recording\n";
+    cout << "is cheap enough to be left on during a whole campaign, unlike debug mode.\n";
+    cout << "\n";
+    cout << "-R      --probing-replay                    String (file name)\n";
+    cout << "\n";
+    cout << "Use this option to answer the probes with the replies recorded in a trace (see\n";
+    cout << "-T) rather than sending them. Re-running Forester on the same input with the\n";
+    cout << "same settings then gets exactly the same answers from the network, e.g., to\n";
+    cout << "debug the probing phases or evaluate a change in the alias resolution. A probe\n";
+    cout << "gets the next recorded reply to a probe with the same destination and TTL, or\n";
+    cout << "no reply if there is none left. This option cannot be combined with -n.\n";
+    cout << "\n";
     cout << "-a      --concurrency-amount-threads        Integer (amount of threads)\n";
     cout << "\n";
     cout << "Use this option to edit the amount of threads used during any multi-threaded\n";
@@ -350,6 +470,17 @@ void printUsage()
     cout << "stay below a threshold to ensure the soundness of the values. By default, this\n";
     cout << "threshold is set to 0.35.\n";
     cout << "\n";
+    cout << "-u      --alias-resolution-hints-max-age    Positive integer (hours)\n";
+    cout << "\n";
+    cout << "Use this option to re-use alias resolution hints which are still fresh when\n";
+    cout << "re-doing the alias resolution hint collection (re-do mode 2 or 3). Forester\n";
+    cout << "writes the time at which each hint was collected in a .freshness file next to\n";
+    cout << "the IP dictionnary, and reads it (if it exists) along the input .ip file. Hints\n";
+    cout << "(UDP unreachable port, ICMP timestamp request and reverse DNS) collected less\n";
+    cout << "than the given amount of hours ago are then kept and not collected again. IP\n";
+    cout << "IDs are always collected again, as they are only meaningful when collected all\n";
+    cout << "at once. By default, this value is 0, i.e., every hint is collected again.\n";
+    cout << "\n";
     cout << "-l      --label-output                      String\n";
     cout << "\n";
     cout << "Use this option to edit the label that will be used to name the various output\n";
@@ -490,6 +621,19 @@ string elapsedTimeStr(unsigned long elapsedSeconds)
     return ss.str();    
 }
 
+// Simple function to stop the periodic output of the telemetry (if any) after a last output
+
+void stopTelemetry(TreeNETEnvironment *env, Thread *reporterThread)
+{
+    if(reporterThread == NULL)
+        return;
+    
+    env->getTelemetry()->leaveStep();
+    ((TelemetryReporter*) reporterThread->getRunnable())->stop();
+    reporterThread->join();
+    delete reporterThread; // Also deletes the reporter
+}
+
 // Main function; deals with inputs and launches thread(s)
 
 int main(int argc, char *argv[])
@@ -505,6 +649,7 @@ int main(int argc, char *argv[])
     unsigned short maxRollovers = 10; // Idem
     double baseTolerance = 0.2; // Idem
     double maxError = 0.35; // Idem
+    unsigned long hintsMaxAge = 0; // Idem (in hours)
     bool doubleProbe = false;
     bool useFixedFlowID = true;
     unsigned short redoMode = REDO_MODE_NOTHING;
@@ -513,6 +658,15 @@ int main(int argc, char *argv[])
     bool kickLogs = false;
     unsigned short nbThreads = 256;
     string labelOutputFiles = ""; // Gets a default value later if not set by user.
+    string growthDelta = ""; // Subnet dump inserted incrementally (if set by user)
+    string syntheticSettings = ""; // Settings of a synthetic dataset (if one should be generated)
+    bool generateDataset = false;
+    string benchmarkResults = ""; // Output file of the benchmarks (if they should be run)
+    string simulationSettings = ""; // Settings of the simulated network (if probes are simulated)
+    bool simulateProbing = false;
+    string traceFile = ""; // Trace recording the probes (if they should be recorded)
+    string replayFile = ""; // Trace answering the probes (if they should be replayed)
+    string telemetryFile = ""; // Output file of the telemetry (if it should be written)
     
     // Values to check if info, usage, version... should be displayed.
     bool displayInfo = false, displayUsage = false, displayVersion = false;
@@ -578,10 +732,14 @@ int main(int argc, char *argv[])
      
     int opt = 0;
     int longIndex = 0;
-    const char* const shortOpts = "a:b:cd:e:fhikl:m:op:r:st:v:w:x:y:z:";
+    const char* const shortOpts = "a:b:cd:e:fg:hij:kl:m:n:op:q:r:st:u:v:w:x:y:z:P:R:T:";
     const struct option longOpts[] = {
             {"redo-mode", required_argument, NULL, 'm'}, 
             {"parsing-omit-merging", no_argument, NULL, 'o'}, 
+            {"growth-delta", required_argument, NULL, 'g'}, 
+            {"synthetic-dataset", required_argument, NULL, 'j'}, 
+            {"benchmark", required_argument, NULL, 'q'}, 
+            {"telemetry", required_argument, NULL, 'P'}, 
             {"probing-egress-interface", required_argument, NULL, 'e'}, 
             {"probing-no-fixed-flow", no_argument, NULL, 'f'}, 
             {"probing-payload-message", required_argument, NULL, 'p'}, 
@@ -589,12 +747,16 @@ int main(int argc, char *argv[])
             {"probing-regulating-period", required_argument, NULL, 'r'}, 
             {"probing-second-opinion", no_argument, NULL, 's'}, 
             {"probing-timeout-period", required_argument, NULL, 't'}, 
+            {"probing-simulated", required_argument, NULL, 'n'}, 
+            {"probing-trace", required_argument, NULL, 'T'}, 
+            {"probing-replay", required_argument, NULL, 'R'}, 
             {"concurrency-amount-threads", required_argument, NULL, 'a'}, 
             {"concurrency-delay-threading", required_argument, NULL, 'd'}, 
             {"alias-resolution-amount-ip-ids", required_argument, NULL, 'w'}, 
             {"alias-resolution-rollovers-max", required_argument, NULL, 'x'}, 
             {"alias-resolution-range-tolerance", required_argument, NULL, 'y'}, 
             {"alias-resolution-error-tolerance", required_argument, NULL, 'z'}, 
+            {"alias-resolution-hints-max-age", required_argument, NULL, 'u'}, 
             {"label-output", required_argument, NULL, 'l'}, 
             {"verbosity", required_argument, NULL, 'v'}, 
             {"external-logs", no_argument, NULL, 'k'}, 
@@ -650,18 +812,21 @@ int main(int argc, char *argv[])
             {
                 case 'm':
                     gotNb = std::atoi(optargSTR.c_str());
-                    if(gotNb >= 0 && gotNb <= 3)
+                    if(gotNb >= 0 && gotNb <= 4)
                         redoMode = (unsigned short) gotNb;
                     else
                     {
                         cout << "Warning for -m option: an unrecognized mode (i.e., value ";
-                        cout << "out of [0,3]) was provided. Forester will not re-compute ";
+                        cout << "out of [0,4]) was provided. Forester will not re-compute ";
                         cout << "anything.\n" << endl;
                     }
                     break;
                 case 'o':
                     parsingOmitMerging = true;
                     break;
+                case 'g':
+                    growthDelta = optargSTR;
+                    break;
                 case 'e':
                     try
                     {
@@ -836,6 +1001,38 @@ int main(int argc, char *argv[])
                         cout << "value for this option (= 0.35).\n" << endl;
                     }
                     break;
+                case 'u':
+                    gotNb = std::atoi(optargSTR.c_str());
+                    if(gotNb >= 0)
+                    {
+                        hintsMaxAge = (unsigned long) gotNb;
+                    }
+                    else
+                    {
+                        cout << "Warning for -u option: a negative value was provided. Forester ";
+                        cout << "will use the default value for this option (= 0).\n" << endl;
+                    }
+                    break;
+                case 'j':
+                    syntheticSettings = optargSTR;
+                    generateDataset = true;
+                    break;
+                case 'q':
+                    benchmarkResults = optargSTR;
+                    break;
+                case 'P':
+                    telemetryFile = optargSTR;
+                    break;
+                case 'n':
+                    simulationSettings = optargSTR;
+                    simulateProbing = true;
+                    break;
+                case 'T':
+                    traceFile = optargSTR;
+                    break;
+                case 'R':
+                    replayFile = optargSTR;
+                    break;
                 case 'l':
                     labelOutputFiles = optargSTR;
                     break;
@@ -891,6 +1088,81 @@ int main(int argc, char *argv[])
         return 0;
     }
     
+    /*
+     * SYNTHETIC DATASET
+     *
+     * With -j, the main argument is the prefix of a synthetic dataset to create rather than the 
+     * input files. No environment is needed: Forester writes the dataset and stops, unless it 
+     * should be benchmarked right after (-q).
+     */
+    
+    if(generateDataset)
+    {
+        DatasetGenerator generator(nbIPIDs);
+        string error = "";
+        if(!generator.configure(syntheticSettings, &error))
+        {
+            cout << "Error for -j option: " << error << endl;
+            cout << "Use -h or --help to get more details on how to use TreeNET." << endl;
+            return 1;
+        }
+        
+        if(!generator.generate(inputsStr, &cout))
+            return 1;
+        if(benchmarkResults.length() == 0)
+            return 0;
+        cout << endl;
+    }
+    
+    // Benchmarks never probe
+    if(benchmarkResults.length() > 0)
+    {
+        if(inputsStr.find(',') != std::string::npos)
+        {
+            cout << "Benchmarks can only be run on a single dataset." << endl;
+            return 1;
+        }
+        redoMode = REDO_MODE_NOTHING;
+    }
+    
+    // Simulated network (built after parsing, as it relies on the input dataset)
+    SimulatedNetwork *simulatedNetwork = NULL;
+    if(simulateProbing && redoMode != REDO_MODE_NOTHING)
+    {
+        simulatedNetwork = new SimulatedNetwork();
+        string error = "";
+        if(!simulatedNetwork->configure(simulationSettings, &error))
+        {
+            cout << "Error for -n option: " << error << endl;
+            cout << "Use -h or --help to get more details on how to use TreeNET." << endl;
+            delete simulatedNetwork;
+            return 1;
+        }
+    }
+    
+    // Replay of a trace (answers the probes just like the simulated network)
+    TraceReplayer *traceReplayer = NULL;
+    if(replayFile.length() > 0 && redoMode != REDO_MODE_NOTHING)
+    {
+        if(simulatedNetwork != NULL)
+        {
+            cout << "Error for -R option: probes cannot be both replayed and simulated (-n)." << endl;
+            cout << "Use -h or --help to get more details on how to use TreeNET." << endl;
+            delete simulatedNetwork;
+            return 1;
+        }
+        
+        traceReplayer = new TraceReplayer();
+        string error = "";
+        if(!traceReplayer->load(replayFile, &error))
+        {
+            cout << "Error for -R option: " << error << endl;
+            delete traceReplayer;
+            return 1;
+        }
+    }
+    bool probesAnswered = simulatedNetwork != NULL || traceReplayer != NULL;
+    
     /*
      * SETTING THE ENVIRONMENT
      *
@@ -902,7 +1174,7 @@ int main(int argc, char *argv[])
      * able to access.
      */
 
-    if(localIPAddress.isUnset() && redoMode != REDO_MODE_NOTHING)
+    if(localIPAddress.isUnset() && redoMode != REDO_MODE_NOTHING && !probesAnswered)
     {
         try
         {
@@ -924,7 +1196,7 @@ int main(int argc, char *argv[])
      * later in the program.
      */
     
-    if(redoMode >= REDO_MODE_ALIAS_HINTS)
+    if(redoMode >= REDO_MODE_ALIAS_HINTS && !probesAnswered)
     {
         try
         {
@@ -991,15 +1263,70 @@ int main(int argc, char *argv[])
                                                      maxRollovers, 
                                                      baseTolerance, 
                                                      maxError, 
+                                                     hintsMaxAge * 3600, 
                                                      displayMode, 
                                                      nbThreads);
     
+    // The environment becomes the owner of the simulated network or the replayed trace (if any)
+    if(simulatedNetwork != NULL)
+        env->setSimulatedNetwork(simulatedNetwork);
+    else if(traceReplayer != NULL)
+        env->setSimulatedNetwork(traceReplayer);
+    
+    // Same for the trace recording the probes
+    ProbeTrace *probeTrace = NULL;
+    if(traceFile.length() > 0 && redoMode != REDO_MODE_NOTHING)
+    {
+        probeTrace = new ProbeTrace();
+        if(!probeTrace->open(traceFile))
+        {
+            cout << "Error for -T option: could not create " << traceFile << "." << endl;
+            delete probeTrace;
+            delete env;
+            return 1;
+        }
+        env->setProbeTrace(probeTrace);
+    }
+    
     // Gets quick access to subnet set
     SubnetSiteSet *set = env->getSubnetSet();
     
     // Some welcome message
     cout << "TreeNET v3.2 \"Forester\" (time at start: " << getCurrentTimeStr() << ")\n" << endl;
     
+    if(traceReplayer != NULL)
+    {
+        cout << "Probes will be answered by the replies recorded in " << replayFile;
+        cout << " (no probe will be sent).\n" << endl;
+    }
+    if(probeTrace != NULL)
+        cout << "Probes will be recorded in " << traceFile << ".\n" << endl;
+    
+    /*
+     * BENCHMARKS
+     *
+     * With -q, the offline steps are run on the input dataset as benchmarks (see Benchmark 
+     * class) rather than as a normal run, and their measurements are written in a file.
+     */
+    
+    if(benchmarkResults.length() > 0)
+    {
+        Benchmark *benchmark = new Benchmark(env, inputsStr, newFileName);
+        bool benchmarkResult = benchmark->run();
+        if(benchmarkResult)
+        {
+            benchmark->outputResults(benchmarkResults);
+            cout << "\nBenchmark results have been written in " << benchmarkResults << "." << endl;
+        }
+        else
+        {
+            cout << "Could not parse any subnet. The benchmarks cannot be run." << endl;
+        }
+        delete benchmark;
+        delete env;
+        return benchmarkResult ? 0 : 1;
+    }
+    
     /*
      * INPUT FILE PARSING
      *
@@ -1061,6 +1388,7 @@ int main(int argc, char *argv[])
     if(!graftingMode)
     {
         cout << "--- Start of input file parsing ---" << endl;
+        env->getTelemetry()->enterStep(Telemetry::STEP_PARSING);
         timeval parsingStart, parsingEnd;
         gettimeofday(&parsingStart, NULL);
         
@@ -1075,6 +1403,8 @@ int main(int argc, char *argv[])
             
             IPDictionnaryParser *idp = new IPDictionnaryParser(env);
             bool ipParsingResult = idp->parse(ipDictPath);
+            if(ipParsingResult)
+                idp->parseFreshness(inputsStr + ".freshness");
             delete idp;
             
             if(!ipParsingResult)
@@ -1093,6 +1423,14 @@ int main(int argc, char *argv[])
         gettimeofday(&parsingEnd, NULL);
         unsigned long parsingElapsed = parsingEnd.tv_sec - parsingStart.tv_sec;
         cout << "Elapsed time: " << elapsedTimeStr(parsingElapsed) << "\n" << endl;
+        
+        // Probes are answered by a network modelled after the dataset (see SimulatedNetwork)
+        if(simulatedNetwork != NULL)
+        {
+            simulatedNetwork->build(env, inputsStr + ".alias");
+            cout << "Probes will be answered by a simulated network built from the input ";
+            cout << "dataset (no probe will be sent).\n" << endl;
+        }
     }
     else
     {
@@ -1180,6 +1518,14 @@ int main(int argc, char *argv[])
         }
     }
     
+    // Telemetry is written periodically from now on (see TelemetryReporter)
+    Thread *telemetryThread = NULL;
+    if(telemetryFile.length() > 0)
+    {
+        telemetryThread = new Thread(new TelemetryReporter(env->getTelemetry(), telemetryFile));
+        telemetryThread->start();
+    }
+    
     Grower *g = NULL;
     Climber *cuckoo = NULL;
     Soil *result = NULL;
@@ -1211,7 +1557,7 @@ int main(int argc, char *argv[])
             inferenceStream = env->getOutputStream();
         }
         
-        g = new ClassicGrower(env);
+        g = new ClassicGrower(env, redoMode == REDO_MODE_VERIFIED_ROUTES);
         
         /*
          * The "preparation" is normally already done if the dataset is complete, so this step 
@@ -1227,10 +1573,34 @@ int main(int argc, char *argv[])
         
         (*inferenceStream) << "Growing network tree..." << endl;
         
+        env->getTelemetry()->enterStep(Telemetry::STEP_GROWTH);
         g->grow();
         
         (*inferenceStream) << "Growth complete." << endl;
         
+        // Incremental growth with the subnets of the delta dump (if any)
+        if(growthDelta.length() > 0)
+        {
+            (*inferenceStream) << "\nInserting subnets from " << growthDelta << ".subnet..." << endl;
+            
+            SubnetParser *sp = new SubnetParser(env);
+            bool deltaParsingResult = sp->parse(growthDelta + ".subnet");
+            delete sp;
+            
+            if(deltaParsingResult)
+            {
+                env->fillIPDictionnary();
+                ((ClassicGrower*) g)->growIncrementally(g->getResult());
+                (*inferenceStream) << "Incremental growth complete." << endl;
+            }
+            else
+            {
+                (*inferenceStream) << "Could not parse " << growthDelta << ".subnet. The tree ";
+                (*inferenceStream) << "will not be updated." << endl;
+                growthDelta = "";
+            }
+        }
+        
         result = g->getResult();
         delete g;
         g = NULL;
@@ -1253,6 +1623,7 @@ int main(int argc, char *argv[])
         env->resetProbeAmounts();
         
         // New save of the subnets
+        env->getTelemetry()->enterStep(Telemetry::STEP_OUTPUT);
         result->outputSubnets(newFileName + ".subnet");
         
         // Tree text display (to an output file)
@@ -1289,16 +1660,27 @@ int main(int argc, char *argv[])
             timeval aliasResoStart, aliasResoEnd;
             gettimeofday(&aliasResoStart, NULL);
             
-            env->getIPTable()->clearAliasHints();
+            /*
+             * With a growth delta, IP IDs are only cleared in the neighborhoods Cuckoo visits 
+             * (i.e., neighborhoods touched by the delta or with hints which are no longer fresh), 
+             * since those of the other neighborhoods remain consistent with each other.
+             */
+            
+            bool incremental = growthDelta.length() > 0;
+            unsigned int freshHints = env->getIPTable()->clearAliasHints(time(NULL), env->getHintsMaxAges(), incremental);
+            if(freshHints > 0)
+                cout << "Fresh alias resolution hints kept from previous collection: " << freshHints << "\n" << endl;
             
             if(kickLogs)
                 env->openLogStream("Log_" + newFileName + "_alias_resolution");
             
-            cuckoo = new Cuckoo(env);
+            env->getTelemetry()->enterStep(Telemetry::STEP_HINTS_COLLECTION);
+            cuckoo = new Cuckoo(env, incremental);
             cuckoo->climb(result);
             delete cuckoo;
             cuckoo = NULL;
             
+            env->getTelemetry()->enterStep(Telemetry::STEP_ALIAS_RESOLUTION);
             Climber *crow = new Crow(env);
             crow->climb(result);
             ((Crow *) crow)->outputAliases(newFileName + ".alias");
@@ -1314,12 +1696,22 @@ int main(int argc, char *argv[])
             cout << "Elapsed time: " << elapsedTimeStr(aliasResoElapsed) << endl;
             cout << "Total amount of probes: " << env->getTotalProbes() << endl;
             cout << "Total amount of successful probes: " << env->getTotalSuccessfulProbes();
-            cout << " (" << successRate << "%)\n" << endl;
+            cout << " (" << successRate << "%)" << endl;
+            unsigned int reusedUDP = env->getTotalReusedHints(IPTableEntry::HINT_PORT_UNREACHABLE);
+            unsigned int reusedTS = env->getTotalReusedHints(IPTableEntry::HINT_TIMESTAMP_REPLY);
+            unsigned int reusedDNS = env->getTotalReusedHints(IPTableEntry::HINT_REVERSE_DNS);
+            if(reusedUDP + reusedTS + reusedDNS > 0)
+            {
+                cout << "Re-used fresh hints (UDP, timestamp, reverse DNS): " << reusedUDP;
+                cout << ", " << reusedTS << ", " << reusedDNS << endl;
+            }
+            cout << endl;
             env->resetProbeAmounts();
         }
         // Re-does only the "actual" alias resolution (+ save of the new .alias file if asked).
         else
         {
+            env->getTelemetry()->enterStep(Telemetry::STEP_ALIAS_RESOLUTION);
             Climber *crow = new Crow(env);
             crow->climb(result);
             if(redoMode >= REDO_MODE_ALIASES)
@@ -1328,6 +1720,7 @@ int main(int argc, char *argv[])
         }
         
         // Internal node exploration and actual alias resolution are only done now.
+        env->getTelemetry()->enterStep(Telemetry::STEP_OUTPUT);
         env->openLogStream(newFileName + ".neighborhoods", false);
         Climber *cat = new Cat(env);
         cat->climb(result);
@@ -1353,6 +1746,10 @@ int main(int argc, char *argv[])
             env->getIPTable()->outputDictionnary(newFileName + ".ip");
             cout << "IP dictionnary with new alias resolution hints has been saved in an output file ";
             cout << newFileName << ".ip." << endl;
+            
+            env->getIPTable()->outputFreshness(newFileName + ".freshness");
+            cout << "Collection times of these hints have been saved in an output file ";
+            cout << newFileName << ".freshness." << endl;
         }
         
         if(redoMode >= REDO_MODE_ALIASES)
@@ -1370,6 +1767,24 @@ int main(int argc, char *argv[])
         
         cout << "L2 estimation (experimental) has been written in a file ";
         cout << newFileName << ".l2." << endl;
+        
+        if(simulatedNetwork != NULL)
+        {
+            cout << endl;
+            simulatedNetwork->outputSummary(&cout);
+        }
+        else if(traceReplayer != NULL)
+        {
+            cout << endl;
+            traceReplayer->outputSummary(&cout);
+        }
+        
+        if(probeTrace != NULL)
+        {
+            cout << "\nProbe trace: " << probeTrace->getNbEntries() << " probes recorded in ";
+            cout << traceFile << " (" << probeTrace->getLength() << " bytes, ";
+            cout << probeTrace->getNbWrites() << " writes)." << endl;
+        }
 
         delete result;
         result = NULL;
@@ -1397,16 +1812,21 @@ int main(int argc, char *argv[])
         if(result != NULL)
             delete result;
         
+        stopTelemetry(env, telemetryThread);
         delete env;
         return 1;
     }
     catch(InvalidParameterException &e)
     {
         cout << "Use \"--help\" or \"-h\" parameter to reach help" << endl;
+        stopTelemetry(env, telemetryThread);
         delete env;
         return 1;
     }
     
+    stopTelemetry(env, telemetryThread);
+    if(telemetryThread != NULL)
+        cout << "\nTelemetry has been written in " << telemetryFile << "." << endl;
     delete env;
     return 0;
 }
@@ -380,6 +380,14 @@ void InetAddress::setInetAddress(unsigned long int address) throw(InetAddressExc
 
 void InetAddress::setInetAddress(const string &address) throw(InetAddressException)
 {
+    // Usual case (dotted-decimal notation, as in all dumps); the system functions handle the rest
+    unsigned long parsed = 0;
+    if(TextCodec::parseIPv4(address.data(), address.length(), &parsed))
+    {
+        this->ip = parsed;
+        return;
+    }
+
     bool isHostName = false;
     for(unsigned int i = 0; i < address.length(); i++)
     {
@@ -399,9 +407,8 @@ void InetAddress::setInetAddress(const string &address) throw(InetAddressExcepti
 
 auto_ptr<string> InetAddress::getHumanReadableRepresentation() const
 {
-    struct in_addr addr;
-    addr.s_addr = htonl(this->ip);
-    auto_ptr<string> str(new string(inet_ntoa(addr)));
+    char text[TextCodec::MAX_IPV4_LENGTH];
+    auto_ptr<string> str(new string(text, TextCodec::formatIPv4(this->ip, text)));
     return str;
 }
 
@@ -22,6 +22,7 @@ using std::vector;
 
 #include "InetAddressException.h"
 #include "../utils/StringUtils.h"
+#include "../utils/TextCodec.h"
 
 // VERY NICE SOURCE http://www.lemoda.net/freebsd/net-interfaces/index.html
 
@@ -32,7 +33,8 @@ public:
 	static const int ULONG_BIT_LENGTH;
 	friend ostream &operator<<(ostream &out, const InetAddress &ip)
 	{
-		out << *(ip.getHumanReadableRepresentation()); /* +string("(")+StringUtils::Ulong2string(ip.getULongAddress())+string(")") */
+		char text[TextCodec::MAX_IPV4_LENGTH];
+		out.write(text, TextCodec::formatIPv4(ip.ip, text));
 		return out;
 	}
 	static auto_ptr<vector<InetAddress> > getLocalAddressList() throw(InetAddressException);
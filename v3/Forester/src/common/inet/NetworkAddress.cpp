@@ -7,6 +7,7 @@ using std::cout;
 using std::endl;
 
 #include "../utils/StringUtils.h"
+#include "../utils/TextCodec.h"
 #include "NetworkAddressSet.h"
 
 #include "NetworkAddress.h"
@@ -113,8 +114,11 @@ void NetworkAddress::resetSubnetPrefix(){
 	prefix.setInetAddress(tmpAddr);
 }
 auto_ptr<string> NetworkAddress::getHumanReadableRepresentation()const{
-	auto_ptr<string> tmp=this->prefix.getHumanReadableRepresentation();
-	auto_ptr<string> rep(new string(*tmp+string("/")+StringUtils::Uchar2string(prefixLength)));
+	char text[TextCodec::MAX_IPV4_LENGTH+4];//4 comes from /mn (+1 spare)
+	size_t length=TextCodec::formatIPv4(prefix.getULongAddress(),text);
+	text[length++]='/';
+	length+=TextCodec::formatULong(prefixLength,text+length);
+	auto_ptr<string> rep(new string(text,length));
 	return rep;
 }
 
@@ -10,6 +10,7 @@
 
 
 #include "StringUtils.h"
+#include "TextCodec.h"
 #include <cassert>
 
 
@@ -115,9 +116,8 @@ string StringUtils::int2string(int numeric){
 	return out.str();
 }
 string StringUtils::Uint2string(unsigned int numeric){
-	std::stringstream out;
-	out<<numeric;
-	return out.str();
+	char text[TextCodec::MAX_ULONG_LENGTH];
+	return string(text,TextCodec::formatULong(numeric,text));
 }
 string StringUtils::long2string(long numeric){
 	std::stringstream out;
@@ -125,9 +125,8 @@ string StringUtils::long2string(long numeric){
 	return out.str();
 }
 string StringUtils::Ulong2string(unsigned long numeric){
-	std::stringstream out;
-	out<<numeric;
-	return out.str();
+	char text[TextCodec::MAX_ULONG_LENGTH];
+	return string(text,TextCodec::formatULong(numeric,text));
 }
 string StringUtils::longlong2string(long long numeric){
 	std::stringstream out;
@@ -145,9 +144,8 @@ string StringUtils::char2string(char numeric){
 	return out.str();
 }
 string StringUtils::Uchar2string(unsigned char numeric){
-	std::stringstream out;
-	out<<(unsigned int)numeric;
-	return out.str();
+	char text[TextCodec::MAX_ULONG_LENGTH];
+	return string(text,TextCodec::formatULong(numeric,text));
 }
 
 string StringUtils::double2string(double numeric){
@@ -0,0 +1,127 @@
+/*
+ * TextCodec.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in TextCodec.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include "TextCodec.h"
+
+size_t TextCodec::formatIPv4(unsigned long ip, char *buffer)
+{
+    size_t pos = 0;
+    for(short shift = 24; shift >= 0; shift -= 8)
+    {
+        unsigned int byte = (unsigned int) ((ip >> shift) & 0xFF);
+
+        // All digits are written, but the cursor only moves past the significant ones
+        buffer[pos] = (char) ('0' + byte / 100);
+        pos += (byte >= 100);
+        buffer[pos] = (char) ('0' + (byte / 10) % 10);
+        pos += (byte >= 10);
+        buffer[pos++] = (char) ('0' + byte % 10);
+        if(shift > 0)
+            buffer[pos++] = '.';
+    }
+    return pos;
+}
+
+size_t TextCodec::formatULong(unsigned long n, char *buffer)
+{
+    size_t length = 1;
+    for(unsigned long rest = n / 10; rest > 0; rest /= 10)
+        length++;
+
+    for(size_t i = length; i > 0; i--)
+    {
+        buffer[i - 1] = (char) ('0' + n % 10);
+        n /= 10;
+    }
+    return length;
+}
+
+size_t TextCodec::formatULongLong(unsigned long long n, char *buffer)
+{
+    // Values which fit in an unsigned long avoid the (slower) 64-bit divisions on 32-bit hosts
+    if(n <= (unsigned long long) ((unsigned long) -1))
+        return formatULong((unsigned long) n, buffer);
+
+    size_t length = 1;
+    for(unsigned long long rest = n / 10; rest > 0; rest /= 10)
+        length++;
+
+    for(size_t i = length; i > 0; i--)
+    {
+        buffer[i - 1] = (char) ('0' + n % 10);
+        n /= 10;
+    }
+    return length;
+}
+
+bool TextCodec::parseIPv4(const char *text, size_t length, unsigned long *ip)
+{
+    if(length < 7 || length > MAX_IPV4_LENGTH)
+        return false;
+
+    unsigned long result = 0;
+    unsigned int byte = 0, digits = 0, dots = 0;
+    for(size_t i = 0; i < length; i++)
+    {
+        char c = text[i];
+        if(c == '.')
+        {
+            if(digits == 0 || dots == 3)
+                return false;
+            result = (result << 8) | byte;
+            byte = 0;
+            digits = 0;
+            dots++;
+        }
+        else if(c >= '0' && c <= '9')
+        {
+            // Leading zeros are rejected (octal notation for inet_aton())
+            if(digits > 0 && byte == 0)
+                return false;
+            byte = byte * 10 + (unsigned int) (c - '0');
+            if(byte > 255)
+                return false;
+            digits++;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if(digits == 0 || dots != 3)
+        return false;
+
+    (*ip) = (result << 8) | byte;
+    return true;
+}
+
+bool TextCodec::parseULong(const char *text, size_t length, unsigned long *n)
+{
+    if(length == 0 || length > MAX_ULONG_LENGTH)
+        return false;
+
+    const unsigned long maxValue = ~((unsigned long) 0);
+    unsigned long result = 0;
+    for(size_t i = 0; i < length; i++)
+    {
+        char c = text[i];
+        if(c < '0' || c > '9')
+            return false;
+
+        unsigned long digit = (unsigned long) (c - '0');
+        if(result > (maxValue - digit) / 10)
+            return false;
+        result = result * 10 + digit;
+    }
+
+    (*n) = result;
+    return true;
+}
@@ -0,0 +1,46 @@
+/*
+ * TextCodec.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * TextCodec gathers the functions converting IPv4 addresses and unsigned integers from/to text,
+ * as found in every dump TreeNET reads or writes (e.g. "192.168.1.1 - 6"). They work on buffers
+ * provided by the calling code, i.e., they never allocate memory (unlike going through a
+ * stringstream or InetAddress::getHumanReadableRepresentation(), which used inet_ntoa() and
+ * returned a new string at each call). Writing methods return the amount of written characters
+ * and do not write a terminating null character.
+ *
+ * Formatting gives the same text as inet_ntoa() or an output stream. Parsing is strict: an IPv4
+ * address must consist of exactly 4 decimal bytes separated by dots, without leading zeros
+ * (inet_aton() would read them as octal), and an integer must only consist of decimal digits.
+ * Anything else is rejected, such that the calling code can fall back on the permissive (but
+ * slower) system functions.
+ */
+
+#ifndef TEXTCODEC_H_
+#define TEXTCODEC_H_
+
+#include <cstddef>
+using std::size_t;
+
+class TextCodec
+{
+public:
+
+    // Maximum lengths of formatted values (buffers must be at least this large)
+    static const size_t MAX_IPV4_LENGTH = 15;
+    static const size_t MAX_ULONG_LENGTH = 20;
+
+    // Formatting methods (ip is in host order, i.e., most significant byte first in the text)
+    static size_t formatIPv4(unsigned long ip, char *buffer);
+    static size_t formatULong(unsigned long n, char *buffer);
+    static size_t formatULongLong(unsigned long long n, char *buffer); // E.g. 64-bit counters
+
+    // Parsing methods (return false and leave the result unchanged if the text is malformed)
+    static bool parseIPv4(const char *text, size_t length, unsigned long *ip);
+    static bool parseULong(const char *text, size_t length, unsigned long *n);
+
+};
+
+#endif /* TEXTCODEC_H_ */
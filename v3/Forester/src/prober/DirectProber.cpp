@@ -103,34 +103,21 @@ probeCountStatistic(0),
 verbose(v), 
 log(""),
 nbProbes(0),
-nbSuccessfulProbes(0)
+nbSuccessfulProbes(0),
+phase(ProbeTrace::PHASE_UNKNOWN),
+nbTimeouts(0),
+nbSocketErrors(0),
+RTTSum(0),
+trace(NULL),
+traceTask(0),
+traceBuffer(NULL),
+traceBuffered(0)
 {
     this->setAttentionMsg(attentionMessage);
+    for(unsigned short i = 0; i < NB_RTT_BUCKETS; i++)
+        RTTHistogram[i] = 0;
 
-    // Ensures that the protocol is ICMP, UDP, or TCP
-    if(probingProtocol != IPPROTO_ICMP && probingProtocol != IPPROTO_UDP && probingProtocol != IPPROTO_TCP)
-    {
-        throw SocketException("Unsupported protocol. DirectProber only supports IPPROTO_ICMP, IPPROTO_UDP, and IPPROTO_TCP.");
-    }
-    // Ensures the lower and upper bounds of TCP - UDP ports or ICMP id/sequence are correct
-    if(lowBoundSrcPortICMPid >= upBoundSrcPortICMPid)
-    {
-        if(probingProtocol == IPPROTO_ICMP)
-            throw SocketException("Lower bound ICMP identifier is not less than the upper bound ICMP identifier.");
-        else if(probingProtocol == IPPROTO_UDP)
-            throw SocketException("Lower bound UDP source port is not less than the upper bound UDP source port.");
-        else
-            throw SocketException("Lower bound TCP source port is not less than the upper bound TCP source port.");
-    }
-    if(lowBoundDstPortICMPseq >= upBoundDstPortICMPseq)
-    {
-        if(probingProtocol == IPPROTO_ICMP)
-            throw SocketException("Lower bound ICMP sequence is not less than the upper bound ICMP sequence.");
-        else if(probingProtocol == IPPROTO_UDP)
-            throw SocketException("Lower bound UDP destination port is not less than the upper bound UDP destination port.");
-        else
-            throw SocketException("Lower bound TCP destination port is not less than the upper bound TCP destination port.");
-    }
+    this->checkSettings();
 
     /*
      * Ensures the socket fds won't be 0, 1 or 2 
@@ -320,8 +307,92 @@ nbSuccessfulProbes(0)
     srand(time(0));
 }
 
+DirectProber::DirectProber(string &attentionMessage, 
+                           int proto, 
+                           const TimeVal &timeoutSeconds, 
+                           const TimeVal &prp, 
+                           unsigned short lowBoundSrcPortICMPid, 
+                           unsigned short upBoundSrcPortICMPid, 
+                           unsigned short lowBoundDstPortICMPseq, 
+                           unsigned short upBoundDstPortICMPseq, 
+                           bool v) throw(SocketException):
+sendSocketRAW(-1),
+icmpReceiveSocketRAW(-1),
+tcpudpReceiveSocketCount(1),
+tcpudpReceiveSockets(0),
+tcpudpReceivePorts(0),
+activeTCPUDPReceiveSocketIndex(0),
+probingProtocol(proto),
+timeout(timeoutSeconds),
+probeRegulatingPausePeriod(prp),
+lastProbeTime(0, 0),
+lowerBoundSrcPortICMPid(lowBoundSrcPortICMPid),
+upperBoundSrcPortICMPid(upBoundSrcPortICMPid),
+lowerBoundDstPortICMPseq(lowBoundDstPortICMPseq),
+upperBoundDstPortICMPseq(upBoundDstPortICMPseq),
+probeCountStatistic(0),
+verbose(v), 
+log(""),
+nbProbes(0),
+nbSuccessfulProbes(0),
+phase(ProbeTrace::PHASE_UNKNOWN),
+nbTimeouts(0),
+nbSocketErrors(0),
+RTTSum(0),
+trace(NULL),
+traceTask(0),
+traceBuffer(NULL),
+traceBuffered(0)
+{
+    this->setAttentionMsg(attentionMessage);
+    for(unsigned short i = 0; i < NB_RTT_BUCKETS; i++)
+        RTTHistogram[i] = 0;
+    this->checkSettings();
+    
+    // Fictive receive socket, bound to the lowest source port (see getAvailableSrcPortICMPid())
+    if(probingProtocol == IPPROTO_TCP || probingProtocol == IPPROTO_UDP)
+    {
+        tcpudpReceiveSockets = new int[1];
+        tcpudpReceivePorts = new unsigned short int[1];
+        tcpudpReceiveSockets[0] = -1;
+        tcpudpReceivePorts[0] = lowerBoundSrcPortICMPid;
+    }
+}
+
+void DirectProber::checkSettings() throw(SocketException)
+{
+    // Ensures that the protocol is ICMP, UDP, or TCP
+    if(probingProtocol != IPPROTO_ICMP && probingProtocol != IPPROTO_UDP && probingProtocol != IPPROTO_TCP)
+    {
+        throw SocketException("Unsupported protocol. DirectProber only supports IPPROTO_ICMP, IPPROTO_UDP, and IPPROTO_TCP.");
+    }
+    // Ensures the lower and upper bounds of TCP - UDP ports or ICMP id/sequence are correct
+    if(lowerBoundSrcPortICMPid >= upperBoundSrcPortICMPid)
+    {
+        if(probingProtocol == IPPROTO_ICMP)
+            throw SocketException("Lower bound ICMP identifier is not less than the upper bound ICMP identifier.");
+        else if(probingProtocol == IPPROTO_UDP)
+            throw SocketException("Lower bound UDP source port is not less than the upper bound UDP source port.");
+        else
+            throw SocketException("Lower bound TCP source port is not less than the upper bound TCP source port.");
+    }
+    if(lowerBoundDstPortICMPseq >= upperBoundDstPortICMPseq)
+    {
+        if(probingProtocol == IPPROTO_ICMP)
+            throw SocketException("Lower bound ICMP sequence is not less than the upper bound ICMP sequence.");
+        else if(probingProtocol == IPPROTO_UDP)
+            throw SocketException("Lower bound UDP destination port is not less than the upper bound UDP destination port.");
+        else
+            throw SocketException("Lower bound TCP destination port is not less than the upper bound TCP destination port.");
+    }
+}
+
 DirectProber::~DirectProber()
 {
+    this->flushTrace();
+    if(traceBuffer != NULL)
+        delete[] traceBuffer;
+
     FD_ZERO(&(this->receiveSet));
     if(sendSocketRAW >= 0 && close(sendSocketRAW) == -1)
         cout << "[ITOM] Can NOT close the send raw socket" << endl;
@@ -343,6 +414,68 @@ DirectProber::~DirectProber()
     }
 }
 
+void DirectProber::setTrace(ProbeTrace *trace)
+{
+    this->flushTrace();
+    this->trace = trace;
+    if(trace == NULL)
+        return;
+    
+    this->traceTask = trace->newTask();
+    if(traceBuffer == NULL)
+        traceBuffer = new uint8_t[ProbeTrace::BUFFER_CAPACITY * ProbeTrace::ENTRY_LENGTH];
+}
+
+void DirectProber::flushTrace()
+{
+    if(trace != NULL && traceBuffered > 0)
+        trace->write(traceBuffer, traceBuffered * ProbeTrace::ENTRY_LENGTH);
+    traceBuffered = 0;
+}
+
+void DirectProber::recordProbe(const InetAddress &src, 
+                               unsigned short IPIdentifier, 
+                               unsigned short srcPortORICMPid, 
+                               unsigned short dstPortORICMPseq, 
+                               const ProbeRecord *record)
+{
+    if(record->isAnonymousRecord())
+    {
+        nbTimeouts++;
+    }
+    else
+    {
+        TimeVal RTTVal = record->getRplyTime() - record->getReqTime();
+        unsigned long RTT = 0;
+        if(RTTVal.isPositive())
+            RTT = (unsigned long) (RTTVal.getSecondsPart() * 1000000 + RTTVal.getMicroSecondsPart());
+        
+        unsigned short bucket = 0;
+        while(bucket < NB_RTT_BUCKETS - 1 && RTT >= getRTTBucketBound(bucket))
+            bucket++;
+        RTTHistogram[bucket]++;
+        RTTSum += RTT;
+    }
+    
+    if(trace == NULL)
+        return;
+    
+    ProbeTrace::encode(traceBuffer + traceBuffered * ProbeTrace::ENTRY_LENGTH, 
+                       phase, 
+                       traceTask, 
+                       probingProtocol, 
+                       this->sendsTimestampRequests(), 
+                       src, 
+                       IPIdentifier, 
+                       srcPortORICMPid, 
+                       dstPortORICMPseq, 
+                       record);
+    
+    traceBuffered++;
+    if(traceBuffered == ProbeTrace::BUFFER_CAPACITY)
+        this->flushTrace();
+}
+
 unsigned char DirectProber::estimateHopDistanceSingleProbe(const InetAddress &src, 
                                                            const InetAddress &dst, 
                                                            unsigned char middleTTL, 
@@ -604,6 +737,18 @@ void DirectProber::regulateProbingFrequency()
     }
 }
 
+TimeVal DirectProber::getCurrentTime()
+{
+    return *(TimeVal::getCurrentSystemTime());
+}
+
+void DirectProber::waitUntil(const TimeVal &time)
+{
+    TimeVal current = *(TimeVal::getCurrentSystemTime());
+    if(time > current)
+        Thread::invokeSleep(time - current);
+}
+
 unsigned short DirectProber::getAvailableSrcPortICMPid(bool useFixedFlowID)
 {
     if(probingProtocol == IPPROTO_TCP || probingProtocol == IPPROTO_UDP)
@@ -31,6 +31,7 @@ using std::endl;
 #include "exception/SocketSendException.h"
 #include "exception/SocketReceiveException.h"
 #include "../common/date/TimeVal.h"
+#include "trace/ProbeTrace.h"
 
 class DirectProber
 {
@@ -192,9 +193,70 @@ public:
     
     inline unsigned int getNbProbes() { return this->nbProbes; }
     inline unsigned int getNbSuccessfulProbes() { return this->nbSuccessfulProbes; }
+    
+    
+    // Phase the probes of this prober belong to (see ProbeTrace.h), set by its creator
+    inline void setPhase(unsigned char phase) { this->phase = phase; }
+    inline unsigned char getPhase() { return this->phase; }
+    
+    /*
+     * Records all subsequent probes of this prober in a trace (see ProbeTrace.h). The entries 
+     * are buffered by the prober and written in the trace by blocks; flushTrace() (also called 
+     * by the destructor) writes the remaining entries.
+     */
+    
+    void setTrace(ProbeTrace *trace);
+    void flushTrace();
+    inline unsigned int getTraceTask() { return this->traceTask; }
+    
+    /*
+     * Statistics of this prober for the telemetry (see Telemetry.h): probes which got no reply 
+     * (i.e., timeouts), exceptions raised while sending/receiving probes and histogram of the 
+     * round-trip times. The i-th bucket of the histogram counts the RTTs lower than 
+     * getRTTBucketBound(i) microseconds which do not fit in a previous bucket; the last bucket 
+     * counts all other RTTs. Being kept by each prober (hence by a single thread), these 
+     * statistics are updated without any lock.
+     */
+    
+    static const unsigned short NB_RTT_BUCKETS = 18;
+    static unsigned long getRTTBucketBound(unsigned short bucket) { return 128UL << bucket; }
+    
+    inline unsigned int getNbTimeouts() { return this->nbTimeouts; }
+    inline unsigned int getNbSocketErrors() { return this->nbSocketErrors; }
+    inline unsigned int getNbRTTs(unsigned short bucket) { return this->RTTHistogram[bucket]; }
+    inline unsigned long long getRTTSum() { return this->RTTSum; }
+    
+    /*
+     * Clock of this prober, which code timing its probes (e.g., to collect IP-IDs) should read 
+     * and wait on rather than the system clock. It is the system clock for probers using the 
+     * network, but a simulated prober keeps a virtual clock (see SimulatedProber.h) which its 
+     * probes and waitUntil() only move forward, without sleeping.
+     */
+    
+    virtual TimeVal getCurrentTime();
+    virtual void waitUntil(const TimeVal &time);
 
 protected:
 
+    /*
+     * Constructor for probers which do not send actual packets (e.g., SimulatedProber): same 
+     * checks as the public constructor, but no socket is opened. A single fictive TCP/UDP 
+     * receive socket is set up, so that the round robin over these sockets stays valid.
+     */
+    
+    DirectProber(string &attentionMessage, 
+                 int probingProtocol, 
+                 const TimeVal &timeoutSeconds, 
+                 const TimeVal &probeRegulatingPausePeriod, 
+                 unsigned short lowerBoundSrcPortICMPid, 
+                 unsigned short upperBoundSrcPortICMPid, 
+                 unsigned short lowerBoundDstPortICMPseq, 
+                 unsigned short upperBoundDstPortICMPseq, 
+                 bool verbose) throw (SocketException);
+    
+    // Checks the protocol and the bounds of ports/ICMP fields (throws a SocketException if wrong)
+    void checkSettings() throw (SocketException);
+
     // Prepares and sends a probe packet.
     ProbeRecord *singleProbe(const InetAddress &src, 
             const InetAddress &dst, 
@@ -205,15 +267,25 @@ protected:
             unsigned short dstPortORICMPseq) throw (SocketSendException, SocketReceiveException)
     {
         fillRandomDataBuffer();
-        ProbeRecord *result = basic_probe(src, 
-                                          dst, 
-                                          IPIdentifier, 
-                                          TTL, 
-                                          usingFixedFlowID, 
-                                          srcPortORICMPid, 
-                                          dstPortORICMPseq);
+        ProbeRecord *result = NULL;
+        try
+        {
+            result = basic_probe(src, 
+                                 dst, 
+                                 IPIdentifier, 
+                                 TTL, 
+                                 usingFixedFlowID, 
+                                 srcPortORICMPid, 
+                                 dstPortORICMPseq);
+        }
+        catch(SocketException &e)
+        {
+            nbSocketErrors++;
+            throw;
+        }
         result->setProbingCost(1);
         probeCountStatistic++;
+        recordProbe(src, IPIdentifier, srcPortORICMPid, dstPortORICMPseq, result);
         if(probingProtocol == IPPROTO_UDP || probingProtocol == IPPROTO_TCP)
         {
             activeTCPUDPReceiveSocketIndex = getNextActiveTCPUDPreceiveSocketIndex();
@@ -231,27 +303,38 @@ protected:
                              unsigned short dstPortORICMPseq) throw (SocketSendException, SocketReceiveException)
     {
         fillRandomDataBuffer();
-        ProbeRecord *result = basic_probe(src, 
-                                          dst, 
-                                          IPIdentifier, 
-                                          TTL,  
-                                          usingFixedFlowID, 
-                                          srcPortORICMPid, 
-                                          dstPortORICMPseq);
-        result->setProbingCost(1);
-        probeCountStatistic++;
-        if(result->isAnonymousRecord())
+        ProbeRecord *result = NULL;
+        try
         {
-            delete result;
             result = basic_probe(src, 
                                  dst, 
                                  IPIdentifier, 
-                                 TTL, 
+                                 TTL,  
                                  usingFixedFlowID, 
                                  srcPortORICMPid, 
                                  dstPortORICMPseq);
-            result->setProbingCost(2);
+            result->setProbingCost(1);
             probeCountStatistic++;
+            recordProbe(src, IPIdentifier, srcPortORICMPid, dstPortORICMPseq, result);
+            if(result->isAnonymousRecord())
+            {
+                delete result;
+                result = basic_probe(src, 
+                                     dst, 
+                                     IPIdentifier, 
+                                     TTL, 
+                                     usingFixedFlowID, 
+                                     srcPortORICMPid, 
+                                     dstPortORICMPseq);
+                result->setProbingCost(2);
+                probeCountStatistic++;
+                recordProbe(src, IPIdentifier, srcPortORICMPid, dstPortORICMPseq, result);
+            }
+        }
+        catch(SocketException &e)
+        {
+            nbSocketErrors++;
+            throw;
         }
         if(probingProtocol == IPPROTO_UDP || probingProtocol == IPPROTO_TCP)
         {
@@ -268,6 +351,20 @@ protected:
             unsigned short srcPortORICMPid, 
             unsigned short dstPortORICMPseq) throw (SocketSendException, SocketReceiveException) = 0;
 
+    // Whether the probes are ICMP timestamp requests (only recorded in traces)
+    virtual bool sendsTimestampRequests() { return false; }
+    
+    /*
+     * Updates the statistics with a probe and its record, and encodes both in the trace buffer 
+     * (written in the trace once full) if the probes are recorded.
+     */
+    
+    void recordProbe(const InetAddress &src, 
+                     unsigned short IPIdentifier, 
+                     unsigned short srcPortORICMPid, 
+                     unsigned short dstPortORICMPseq, 
+                     const ProbeRecord *record);
+
     void RESET_SELECT_SET();
     int GET_READY_SOCKET_DESCRIPTOR();
     void fillRandomDataBuffer();
@@ -344,6 +441,21 @@ protected:
     
     unsigned int nbProbes;
     unsigned int nbSuccessfulProbes;
+    
+    // Fields for the telemetry (see Telemetry.h)
+    
+    unsigned char phase;
+    unsigned int nbTimeouts;
+    unsigned int nbSocketErrors;
+    unsigned int RTTHistogram[NB_RTT_BUCKETS];
+    unsigned long long RTTSum;
+    
+    // Fields to record the probes in a trace (NULL if they are not recorded)
+    
+    ProbeTrace *trace;
+    unsigned int traceTask;
+    uint8_t *traceBuffer;
+    unsigned int traceBuffered; // Amount of entries in the buffer
 };
 
 #endif /* DIRECTPROBER_H_ */
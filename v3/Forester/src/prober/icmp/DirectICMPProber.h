@@ -65,6 +65,7 @@ public:
     
     // Addition by J.-F. Grailet (up to "private:" part included) to implement Timestamp request
     inline void useTimestampRequests() { this->usingTimestampRequests = true; }
+    inline bool sendsTimestampRequests() { return this->usingTimestampRequests; }
     
 private:
     
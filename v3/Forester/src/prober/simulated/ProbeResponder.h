@@ -0,0 +1,64 @@
+/*
+ * ProbeResponder.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * ProbeResponder is the interface of the objects which stand for the network when probes are not
+ * actually sent, i.e., when using a SimulatedProber. Given the content of a probe, a responder
+ * builds the record of the reply the probe would have got, or an anonymous record if it would
+ * have got no reply (or a reply arriving after the timeout).
+ *
+ * A responder is shared by all probers (and therefore all threads) which rely on it, so its
+ * methods must be thread-safe.
+ *
+ * Probes are timed with a virtual clock rather than the system clock: each prober keeps its own
+ * time (see SimulatedProber), gives it as the time of each probe, and moves it to the time of
+ * the reply (or of the timeout). The clock of the responder is the latest time reached by its
+ * probers, and is where new probers start from.
+ */
+
+#ifndef PROBERESPONDER_H_
+#define PROBERESPONDER_H_
+
+#include <string>
+using std::string;
+
+#include "../../common/inet/InetAddress.h"
+#include "../../common/date/TimeVal.h"
+#include "../structure/ProbeRecord.h"
+
+class ProbeResponder
+{
+public:
+
+    virtual ~ProbeResponder() {}
+
+    /*
+     * Builds the record of a probe (protocol being IPPROTO_ICMP, IPPROTO_UDP or IPPROTO_TCP). The
+     * flow ID is the pair of source port/ICMP identifier and destination port/ICMP sequence, as
+     * load balancers hash it to select a path. reqTime is the time at which the probe is sent,
+     * the time of the reply being reqTime plus its round-trip time. The caller becomes the owner
+     * of the record.
+     */
+
+    virtual ProbeRecord *respond(const InetAddress &dst,
+                                 unsigned short IPIdentifier,
+                                 unsigned char TTL,
+                                 int protocol,
+                                 bool timestampRequest,
+                                 bool usingFixedFlowID,
+                                 unsigned short srcPortORICMPid,
+                                 unsigned short dstPortORICMPseq,
+                                 const TimeVal &timeout,
+                                 const TimeVal &reqTime) = 0;
+    
+    // Current time of the virtual clock
+    virtual TimeVal getCurrentTime() = 0;
+
+    // Reverse DNS look-up (empty string if there is no host name)
+    virtual string resolveHostName(const InetAddress &ip) = 0;
+
+};
+
+#endif /* PROBERESPONDER_H_ */
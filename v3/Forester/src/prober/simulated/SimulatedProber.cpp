@@ -0,0 +1,101 @@
+/*
+ * SimulatedProber.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in SimulatedProber.h (see this file to learn further about the
+ * goals of such class).
+ */
+
+#include <sstream>
+using std::stringstream;
+
+#include "SimulatedProber.h"
+
+SimulatedProber::SimulatedProber(ProbeResponder *r,
+                                 string &attentionMessage,
+                                 int probingProtocol,
+                                 const TimeVal &timeoutPeriod,
+                                 const TimeVal &prp,
+                                 unsigned short lowerBoundSrcPortICMPid,
+                                 unsigned short upperBoundSrcPortICMPid,
+                                 unsigned short lowerBoundDstPortICMPseq,
+                                 unsigned short upperBoundDstPortICMPseq,
+                                 bool verbose) throw(SocketException):
+DirectProber(attentionMessage,
+             probingProtocol,
+             timeoutPeriod,
+             prp,
+             lowerBoundSrcPortICMPid,
+             upperBoundSrcPortICMPid,
+             lowerBoundDstPortICMPseq,
+             upperBoundDstPortICMPseq,
+             verbose),
+responder(r),
+usingTimestampRequests(false)
+{
+    this->clock = responder->getCurrentTime();
+}
+
+SimulatedProber::~SimulatedProber()
+{
+}
+
+ProbeRecord *SimulatedProber::basic_probe(const InetAddress &,
+                                          const InetAddress &dst,
+                                          unsigned short IPIdentifier,
+                                          unsigned char TTL,
+                                          bool usingFixedFlowID,
+                                          unsigned short srcPortORICMPid,
+                                          unsigned short dstPortORICMPseq) throw (SocketSendException, SocketReceiveException)
+{
+    bool timestampRequest = this->sendsTimestampRequests();
+    if(probeRegulatingPausePeriod.isPositive() && clock < lastProbeTime + probeRegulatingPausePeriod)
+        clock = lastProbeTime + probeRegulatingPausePeriod;
+    lastProbeTime = clock;
+    
+    ProbeRecord *record = responder->respond(dst,
+                                             IPIdentifier,
+                                             TTL,
+                                             probingProtocol,
+                                             timestampRequest,
+                                             usingFixedFlowID,
+                                             srcPortORICMPid,
+                                             dstPortORICMPseq,
+                                             timeout,
+                                             clock);
+    record->setUsingFixedFlowID(usingFixedFlowID);
+    clock = record->getRplyTime();
+
+    nbProbes++;
+    if(!record->isAnonymousRecord())
+        nbSuccessfulProbes++;
+
+    if(verbose)
+    {
+        stringstream ss;
+        ss << "Simulated probe to " << dst << " (TTL = " << (unsigned short) TTL << "): ";
+        if(record->isAnonymousRecord())
+            ss << "no reply.\n";
+        else
+        {
+            ss << "reply from " << record->getRplyAddress() << " (ICMP type = ";
+            ss << (unsigned short) record->getRplyICMPtype() << ").\n";
+        }
+        this->log += ss.str();
+    }
+
+    return record;
+}
+
+TimeVal SimulatedProber::getCurrentTime()
+{
+    return this->clock;
+}
+
+void SimulatedProber::waitUntil(const TimeVal &time)
+{
+    if(time > this->clock)
+        this->clock = time;
+}
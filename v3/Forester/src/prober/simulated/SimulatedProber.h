@@ -0,0 +1,65 @@
+/*
+ * SimulatedProber.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * SimulatedProber is a DirectProber which does not open any socket: each probe is handed over to
+ * a ProbeResponder, which returns the record of the reply. It supports the three probing
+ * protocols and ICMP timestamp requests, such that it can replace any of the other probers. The
+ * probing phases can therefore be run without any privilege and without touching the network
+ * (e.g., to test them or measure their performance on a simulated network).
+ *
+ * A simulated probe is answered immediately: the prober never waits for the timeout nor the
+ * regulating pause period. Instead, it keeps a virtual clock (starting from the clock of the
+ * responder) which each probe moves to the time of its reply (or of its timeout), after moving
+ * it by the regulating pause period if needed. waitUntil() only moves this clock, such that the
+ * units timing their probes with it (e.g., IPIDUnit) never sleep either.
+ */
+
+#ifndef SIMULATEDPROBER_H_
+#define SIMULATEDPROBER_H_
+
+#include "../DirectProber.h"
+#include "ProbeResponder.h"
+
+class SimulatedProber : public DirectProber
+{
+public:
+
+    SimulatedProber(ProbeResponder *responder,
+                    string &attentionMessage,
+                    int probingProtocol,
+                    const TimeVal &timeoutPeriod,
+                    const TimeVal &probeRegulatorPausePeriod,
+                    unsigned short lowerBoundSrcPortICMPid,
+                    unsigned short upperBoundSrcPortICMPid,
+                    unsigned short lowerBoundDstPortICMPseq,
+                    unsigned short upperBoundDstPortICMPseq,
+                    bool verbose = false) throw(SocketException);
+    virtual ~SimulatedProber();
+    virtual ProbeRecord *basic_probe(const InetAddress &src,
+                                     const InetAddress &dst,
+                                     unsigned short IPIdentifier,
+                                     unsigned char TTL,
+                                     bool usingFixedFlowID,
+                                     unsigned short srcPortORICMPid,
+                                     unsigned short dstPortORICMPseq) throw (SocketSendException, SocketReceiveException);
+    
+    // Virtual clock of this prober
+    virtual TimeVal getCurrentTime();
+    virtual void waitUntil(const TimeVal &time);
+
+    // Same as in DirectICMPProber (only relevant with ICMP)
+    inline void useTimestampRequests() { this->usingTimestampRequests = true; }
+    inline bool sendsTimestampRequests() { return this->usingTimestampRequests && probingProtocol == IPPROTO_ICMP; }
+
+private:
+
+    ProbeResponder *responder;
+    bool usingTimestampRequests;
+    TimeVal clock;
+
+};
+
+#endif /* SIMULATEDPROBER_H_ */
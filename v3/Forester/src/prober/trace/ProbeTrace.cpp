@@ -0,0 +1,293 @@
+/*
+ * ProbeTrace.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in ProbeTrace.h (see this file to learn further about the goals
+ * of such class).
+ */
+
+#include <fstream>
+using std::ifstream;
+
+#include "ProbeTrace.h"
+
+/*
+ * Layout of a probe entry (ENTRY_LENGTH bytes, offsets in bytes):
+ *  0: kind (ENTRY_PROBE)     1: phase                  2: protocol             3: TTL
+ *  4: reply TTL              5: reply ICMP type        6: reply ICMP code      7: payload TTL
+ *  8: flags                  9-11: reserved            12: time (64 bits)      20: RTT
+ * 24: task                  28: source                32: destination         36: reply source
+ * 40: originate timestamp   44: receive timestamp     48: transmit timestamp
+ * 52: source port/ICMP id   54: destination port/ICMP seq.                     56: IP-ID
+ * 58: reply IP-ID           60: payload length        62-63: reserved
+ *
+ * Layout of a host name entry: kind (ENTRY_HOST_NAME), IP (32 bits), length of the name (16
+ * bits), then the name itself.
+ *
+ * Layout of the header: MAGIC (32 bits), VERSION (16 bits), ENTRY_LENGTH (16 bits), time of
+ * creation of the trace (64 bits, in microseconds since the epoch).
+ */
+
+ProbeTrace::ProbeTrace():
+traceMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    this->opened = false;
+    this->nextTask = 1;
+    this->nbEntries = 0;
+    this->nbWrites = 0;
+    this->length = 0;
+}
+
+ProbeTrace::~ProbeTrace()
+{
+    this->close();
+}
+
+bool ProbeTrace::open(string filename)
+{
+    file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+        return false;
+    this->opened = true;
+
+    TimeVal now = *(TimeVal::getCurrentSystemTime());
+    uint64_t start = (uint64_t) now.getSecondsPart() * 1000000 + (uint64_t) now.getMicroSecondsPart();
+
+    uint8_t header[HEADER_LENGTH];
+    put32(header, MAGIC);
+    put16(header + 4, VERSION);
+    put16(header + 6, (uint16_t) ENTRY_LENGTH);
+    put64(header + 8, start);
+    file.write((const char*) header, HEADER_LENGTH);
+    this->length = HEADER_LENGTH;
+    return true;
+}
+
+void ProbeTrace::close()
+{
+    traceMutex.lock();
+    if(opened)
+    {
+        file.close();
+        this->opened = false;
+    }
+    traceMutex.unlock();
+}
+
+unsigned int ProbeTrace::newTask()
+{
+    traceMutex.lock();
+    unsigned int task = nextTask++;
+    traceMutex.unlock();
+    return task;
+}
+
+void ProbeTrace::encode(uint8_t *out,
+                        unsigned char phase,
+                        unsigned int task,
+                        int protocol,
+                        bool timestampRequest,
+                        const InetAddress &src,
+                        unsigned short IPIdentifier,
+                        unsigned short srcPortORICMPid,
+                        unsigned short dstPortORICMPseq,
+                        const ProbeRecord *record)
+{
+    const TimeVal &reqTime = record->getReqTime();
+    uint64_t time = (uint64_t) reqTime.getSecondsPart() * 1000000 + (uint64_t) reqTime.getMicroSecondsPart();
+    TimeVal RTTVal = record->getRplyTime() - reqTime;
+    uint32_t RTT = 0;
+    if(RTTVal.isPositive())
+        RTT = (uint32_t) (RTTVal.getSecondsPart() * 1000000 + RTTVal.getMicroSecondsPart());
+
+    uint8_t flags = 0;
+    if(record->getUsingFixedFlowID())
+        flags |= FLAG_FIXED_FLOW_ID;
+    if(timestampRequest)
+        flags |= FLAG_TIMESTAMP_REQUEST;
+
+    out[0] = ENTRY_PROBE;
+    out[1] = phase;
+    out[2] = (uint8_t) protocol;
+    out[3] = record->getReqTTL();
+    out[4] = record->getRplyTTL();
+    out[5] = record->getRplyICMPtype();
+    out[6] = record->getRplyICMPcode();
+    out[7] = record->getPayloadTTL();
+    out[8] = flags;
+    out[9] = out[10] = out[11] = 0;
+    put64(out + 12, time);
+    put32(out + 20, RTT);
+    put32(out + 24, (uint32_t) task);
+    put32(out + 28, (uint32_t) src.getULongAddress());
+    put32(out + 32, (uint32_t) record->getDstAddress().getULongAddress());
+    put32(out + 36, (uint32_t) record->getRplyAddress().getULongAddress());
+    put32(out + 40, (uint32_t) record->getOriginateTs());
+    put32(out + 44, (uint32_t) record->getReceiveTs());
+    put32(out + 48, (uint32_t) record->getTransmitTs());
+    put16(out + 52, srcPortORICMPid);
+    put16(out + 54, dstPortORICMPseq);
+    put16(out + 56, IPIdentifier);
+    put16(out + 58, record->getRplyIPidentifier());
+    put16(out + 60, record->getPayloadLength());
+    out[62] = out[63] = 0;
+}
+
+void ProbeTrace::write(const uint8_t *entries, size_t length)
+{
+    traceMutex.lock();
+    if(opened)
+    {
+        file.write((const char*) entries, length);
+        this->nbEntries += length / ENTRY_LENGTH;
+        this->nbWrites++;
+        this->length += length;
+    }
+    traceMutex.unlock();
+}
+
+void ProbeTrace::writeHostName(const InetAddress &ip, const string &name)
+{
+    size_t nameLength = name.length();
+    if(nameLength > 65535)
+        nameLength = 65535;
+
+    uint8_t entry[7];
+    entry[0] = ENTRY_HOST_NAME;
+    put32(entry + 1, (uint32_t) ip.getULongAddress());
+    put16(entry + 5, (uint16_t) nameLength);
+
+    traceMutex.lock();
+    if(opened)
+    {
+        file.write((const char*) entry, 7);
+        file.write(name.c_str(), nameLength);
+        this->nbWrites++;
+        this->length += 7 + nameLength;
+    }
+    traceMutex.unlock();
+}
+
+bool ProbeTrace::load(string filename,
+                      vector<Entry> *entries,
+                      map<unsigned long, string> *hostNames,
+                      string *error)
+{
+    ifstream in;
+    in.open(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!in.is_open())
+    {
+        (*error) = "could not open " + filename + ".";
+        return false;
+    }
+
+    uint8_t header[HEADER_LENGTH];
+    in.read((char*) header, HEADER_LENGTH);
+    if((size_t) in.gcount() != HEADER_LENGTH || get32(header) != MAGIC)
+    {
+        (*error) = filename + " is not a probe trace.";
+        return false;
+    }
+    if(get16(header + 4) != VERSION || get16(header + 6) != ENTRY_LENGTH)
+    {
+        (*error) = filename + " was recorded by an incompatible version.";
+        return false;
+    }
+
+    uint8_t buffer[ENTRY_LENGTH];
+    char kind = 0;
+    while(in.get(kind))
+    {
+        if((uint8_t) kind == ENTRY_PROBE)
+        {
+            buffer[0] = (uint8_t) kind;
+            in.read((char*) buffer + 1, ENTRY_LENGTH - 1);
+            if((size_t) in.gcount() != ENTRY_LENGTH - 1)
+                break;
+
+            Entry e;
+            e.phase = buffer[1];
+            e.protocol = buffer[2];
+            e.TTL = buffer[3];
+            e.rplyTTL = buffer[4];
+            e.rplyICMPtype = buffer[5];
+            e.rplyICMPcode = buffer[6];
+            e.payloadTTL = buffer[7];
+            e.flags = buffer[8];
+            e.time = get64(buffer + 12);
+            e.RTT = get32(buffer + 20);
+            e.task = get32(buffer + 24);
+            e.src = get32(buffer + 28);
+            e.dst = get32(buffer + 32);
+            e.rplySrc = get32(buffer + 36);
+            e.originateTs = get32(buffer + 40);
+            e.receiveTs = get32(buffer + 44);
+            e.transmitTs = get32(buffer + 48);
+            e.srcPortORICMPid = get16(buffer + 52);
+            e.dstPortORICMPseq = get16(buffer + 54);
+            e.IPIdentifier = get16(buffer + 56);
+            e.rplyIPIdentifier = get16(buffer + 58);
+            e.payloadLength = get16(buffer + 60);
+            entries->push_back(e);
+        }
+        else if((uint8_t) kind == ENTRY_HOST_NAME)
+        {
+            in.read((char*) buffer, 6);
+            if(in.gcount() != 6)
+                break;
+            unsigned long ip = (unsigned long) get32(buffer);
+            size_t nameLength = (size_t) get16(buffer + 4);
+            string name(nameLength, '\0');
+            if(nameLength > 0)
+            {
+                in.read(&name[0], nameLength);
+                if((size_t) in.gcount() != nameLength)
+                    break;
+            }
+            (*hostNames)[ip] = name;
+        }
+        else
+        {
+            (*error) = filename + " is corrupted (unknown kind of entry).";
+            return false;
+        }
+    }
+
+    // A truncated last entry (e.g., the run was interrupted) is ignored
+    return true;
+}
+
+void ProbeTrace::put16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t) (value & 0xFF);
+    out[1] = (uint8_t) (value >> 8);
+}
+
+void ProbeTrace::put32(uint8_t *out, uint32_t value)
+{
+    put16(out, (uint16_t) (value & 0xFFFF));
+    put16(out + 2, (uint16_t) (value >> 16));
+}
+
+void ProbeTrace::put64(uint8_t *out, uint64_t value)
+{
+    put32(out, (uint32_t) (value & 0xFFFFFFFF));
+    put32(out + 4, (uint32_t) (value >> 32));
+}
+
+uint16_t ProbeTrace::get16(const uint8_t *in)
+{
+    return (uint16_t) (in[0] | (in[1] << 8));
+}
+
+uint32_t ProbeTrace::get32(const uint8_t *in)
+{
+    return (uint32_t) get16(in) | ((uint32_t) get16(in + 2) << 16);
+}
+
+uint64_t ProbeTrace::get64(const uint8_t *in)
+{
+    return (uint64_t) get32(in) | ((uint64_t) get32(in + 4) << 32);
+}
@@ -0,0 +1,154 @@
+/*
+ * ProbeTrace.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * ProbeTrace records every probe sent by the probers (and its reply, if any) in a compact binary
+ * file, as an alternative to the debug mode whose text logs are too heavy to be used on large
+ * campaigns. Each entry gives the time of the probe, its round-trip time, the flow (source,
+ * destination, protocol, source port/ICMP identifier and destination port/ICMP sequence), the
+ * TTL and IP-ID of the probe, the content of the reply (source, type, code, TTL, IP-ID, payload
+ * and timestamps) and the phase and task (i.e., prober) which sent it. The host names obtained
+ * by reverse DNS are recorded as well, such that a trace holds all the answers of the network.
+ *
+ * Probers do not write in the trace directly: each prober (which is used by a single thread)
+ * encodes its entries in its own buffer and hands it over to the trace once it is full (or when
+ * the prober is deleted), so the mutex of the trace is only taken once per BUFFER_CAPACITY
+ * probes. As a consequence, entries of different tasks are interleaved by blocks in the file,
+ * but the entries of a same task always appear in the order they were sent.
+ *
+ * The file starts with a header (MAGIC, VERSION and ENTRY_LENGTH, see open()). All integers are
+ * written in little endian, whatever the host is. A trace can be read back with load(), e.g., by
+ * a TraceReplayer (see TraceReplayer.h) to feed the recorded replies to a new run.
+ */
+
+#ifndef PROBETRACE_H_
+#define PROBETRACE_H_
+
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include <map>
+using std::map;
+#include <fstream>
+using std::ofstream;
+#include <inttypes.h>
+
+#include "../../common/inet/InetAddress.h"
+#include "../../common/thread/Mutex.h"
+#include "../structure/ProbeRecord.h"
+
+class ProbeTrace
+{
+public:
+
+    // Phases (i.e., units which send probes)
+    const static unsigned char PHASE_UNKNOWN = 0;
+    const static unsigned char PHASE_TRACEROUTE = 1;
+    const static unsigned char PHASE_ANONYMOUS_CHECK = 2;
+    const static unsigned char PHASE_IP_ID = 3;
+    const static unsigned char PHASE_TIMESTAMP = 4;
+    const static unsigned char PHASE_UDP_UNREACHABLE_PORT = 5;
+
+    // Kinds of entries (first byte of each entry)
+    const static uint8_t ENTRY_PROBE = 1;
+    const static uint8_t ENTRY_HOST_NAME = 2;
+
+    // File format
+    const static uint32_t MAGIC = 0x45435254; // "TRCE"
+    const static uint16_t VERSION = 1;
+    const static size_t HEADER_LENGTH = 16;
+    const static size_t ENTRY_LENGTH = 64; // Probe entries (host names have a variable length)
+
+    // Amount of entries a prober buffers before writing them in the trace
+    const static unsigned int BUFFER_CAPACITY = 256;
+
+    // Flags of a probe entry
+    const static uint8_t FLAG_FIXED_FLOW_ID = 1;
+    const static uint8_t FLAG_TIMESTAMP_REQUEST = 2;
+
+    // Decoded probe entry
+    struct Entry
+    {
+        uint64_t time; // Microseconds since the epoch
+        uint32_t RTT; // Microseconds (time until the timeout if there is no reply)
+        uint32_t task;
+        uint32_t src, dst, rplySrc;
+        uint32_t originateTs, receiveTs, transmitTs;
+        uint16_t srcPortORICMPid, dstPortORICMPseq;
+        uint16_t IPIdentifier, rplyIPIdentifier;
+        uint16_t payloadLength;
+        uint8_t phase, protocol, TTL, rplyTTL, rplyICMPtype, rplyICMPcode, payloadTTL, flags;
+    };
+
+    // Constructor, destructor (closes the file)
+    ProbeTrace();
+    ~ProbeTrace();
+
+    // Creates the file and writes its header (returns false if it cannot be created)
+    bool open(string filename);
+    void close();
+
+    // Gives the identifier of a new task (i.e., a prober which starts recording its probes)
+    unsigned int newTask();
+
+    /*
+     * Encodes a probe and its record at the given position of a buffer (which must have room for
+     * ENTRY_LENGTH bytes). Used by the probers to fill their own buffer.
+     */
+
+    static void encode(uint8_t *out,
+                       unsigned char phase,
+                       unsigned int task,
+                       int protocol,
+                       bool timestampRequest,
+                       const InetAddress &src,
+                       unsigned short IPIdentifier,
+                       unsigned short srcPortORICMPid,
+                       unsigned short dstPortORICMPseq,
+                       const ProbeRecord *record);
+
+    // Writes a block of encoded entries (thread-safe)
+    void write(const uint8_t *entries, size_t length);
+
+    // Records the host name of an IP (thread-safe, written immediately)
+    void writeHostName(const InetAddress &ip, const string &name);
+
+    /*
+     * Reads a whole trace, appending its probe entries to entries (in the order of the file) and
+     * its host names to hostNames. Returns false and sets error if the file cannot be read or is
+     * not a trace.
+     */
+
+    static bool load(string filename,
+                     vector<Entry> *entries,
+                     map<unsigned long, string> *hostNames,
+                     string *error);
+
+    // Statistics
+    inline unsigned long getNbEntries() { return this->nbEntries; }
+    inline unsigned long getNbWrites() { return this->nbWrites; }
+    inline unsigned long long getLength() { return this->length; }
+
+private:
+
+    ofstream file;
+    bool opened;
+    Mutex traceMutex;
+    unsigned int nextTask;
+    unsigned long nbEntries, nbWrites;
+    unsigned long long length; // In bytes
+
+    // Little endian encoding/decoding
+    static void put16(uint8_t *out, uint16_t value);
+    static void put32(uint8_t *out, uint32_t value);
+    static void put64(uint8_t *out, uint64_t value);
+    static uint16_t get16(const uint8_t *in);
+    static uint32_t get32(const uint8_t *in);
+    static uint64_t get64(const uint8_t *in);
+
+};
+
+#endif /* PROBETRACE_H_ */
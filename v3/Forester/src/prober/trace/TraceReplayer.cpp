@@ -0,0 +1,170 @@
+/*
+ * TraceReplayer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in TraceReplayer.h (see this file to learn further about the goals
+ * of such class).
+ */
+
+#include <algorithm>
+using std::stable_sort;
+#include <iostream>
+using std::endl;
+
+#include "TraceReplayer.h"
+
+TraceReplayer::TraceReplayer():
+replayMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    this->nbProbes = 0;
+    this->nbReplayed = 0;
+    this->nbMissing = 0;
+    this->nbTimeouts = 0;
+    this->clock = *(TimeVal::getCurrentSystemTime());
+}
+
+TraceReplayer::~TraceReplayer()
+{
+}
+
+bool TraceReplayer::load(string filename, string *error)
+{
+    if(!ProbeTrace::load(filename, &entries, &hostNames, error))
+        return false;
+
+    stable_sort(entries.begin(), entries.end(), TraceReplayer::compareEntries);
+    for(unsigned int i = 0; i < entries.size(); i++)
+    {
+        ProbeTrace::Entry &e = entries[i];
+        bool timestampRequest = (e.flags & ProbeTrace::FLAG_TIMESTAMP_REQUEST) != 0;
+        uint64_t key = getKey(e.dst, e.TTL, e.protocol, timestampRequest);
+
+        map<uint64_t, Sequence>::iterator it = sequences.find(key);
+        if(it == sequences.end())
+        {
+            Sequence newSequence;
+            newSequence.next = 0;
+            it = sequences.insert(std::pair<uint64_t, Sequence>(key, newSequence)).first;
+        }
+        it->second.entries.push_back(i);
+    }
+    return true;
+}
+
+ProbeRecord *TraceReplayer::respond(const InetAddress &dst,
+                                    unsigned short IPIdentifier,
+                                    unsigned char TTL,
+                                    int protocol,
+                                    bool timestampRequest,
+                                    bool,
+                                    unsigned short,
+                                    unsigned short,
+                                    const TimeVal &timeout,
+                                    const TimeVal &reqTime)
+{
+    ProbeRecord *record = new ProbeRecord(dst,
+                                          InetAddress(0),
+                                          reqTime,
+                                          reqTime + timeout,
+                                          TTL,
+                                          0,
+                                          255,
+                                          255,
+                                          IPIdentifier);
+
+    replayMutex.lock();
+    nbProbes++;
+
+    // Next recorded probe with the same key, if any
+    ProbeTrace::Entry *e = NULL;
+    map<uint64_t, Sequence>::iterator it = sequences.find(getKey(dst.getULongAddress(), TTL, protocol, timestampRequest));
+    if(it != sequences.end() && it->second.next < it->second.entries.size())
+    {
+        e = &(entries[it->second.entries[it->second.next]]);
+        it->second.next++;
+    }
+
+    if(e == NULL)
+    {
+        nbMissing++;
+        if(record->getRplyTime() > clock)
+            clock = record->getRplyTime();
+        replayMutex.unlock();
+        return record;
+    }
+
+    nbReplayed++;
+    unsigned long timeoutMicro = timeout.getSecondsPart() * 1000000 + timeout.getMicroSecondsPart();
+    if(e->rplySrc != 0 && (unsigned long) e->RTT > timeoutMicro)
+    {
+        nbTimeouts++;
+    }
+    else if(e->rplySrc != 0)
+    {
+        TimeVal rplyTime = reqTime + TimeVal(e->RTT / 1000000, e->RTT % 1000000);
+        unsigned short rplyIPIdentifier = e->rplyIPIdentifier;
+        if(rplyIPIdentifier == e->IPIdentifier)
+            rplyIPIdentifier = IPIdentifier;
+
+        record->setRplyAddress(InetAddress((unsigned long) e->rplySrc));
+        record->setRplyTime(rplyTime);
+        record->setRplyTTL(e->rplyTTL);
+        record->setRplyICMPtype(e->rplyICMPtype);
+        record->setRplyICMPcode(e->rplyICMPcode);
+        record->setRplyIPidentifier(rplyIPIdentifier);
+        record->setPayloadTTL(e->payloadTTL);
+        record->setPayloadLength(e->payloadLength);
+        record->setOriginateTs(e->originateTs);
+        record->setReceiveTs(e->receiveTs);
+        record->setTransmitTs(e->transmitTs);
+    }
+    if(record->getRplyTime() > clock)
+        clock = record->getRplyTime();
+    replayMutex.unlock();
+
+    return record;
+}
+
+TimeVal TraceReplayer::getCurrentTime()
+{
+    replayMutex.lock();
+    TimeVal current = clock;
+    replayMutex.unlock();
+    return current;
+}
+
+string TraceReplayer::resolveHostName(const InetAddress &ip)
+{
+    map<unsigned long, string>::iterator it = hostNames.find(ip.getULongAddress());
+    if(it != hostNames.end())
+        return it->second;
+    return "";
+}
+
+void TraceReplayer::outputSummary(ostream *out)
+{
+    replayMutex.lock();
+    (*out) << "Replayed trace: " << entries.size() << " recorded probes (" << sequences.size();
+    (*out) << " distinct destination/TTL pairs) and " << hostNames.size() << " host names.\n";
+    (*out) << "Replayed probes: " << nbProbes << " (" << nbReplayed << " matched a recorded ";
+    (*out) << "probe, " << nbMissing << " did not, " << nbTimeouts << " recorded replies ";
+    (*out) << "arrived after the timeout)." << endl;
+    replayMutex.unlock();
+}
+
+uint64_t TraceReplayer::getKey(unsigned long dst, unsigned char TTL, int protocol, bool timestampRequest)
+{
+    uint64_t key = (uint64_t) (dst & 0xFFFFFFFFUL) << 32;
+    key |= (uint64_t) TTL << 16;
+    key |= (uint64_t) (protocol & 0xFF) << 8;
+    if(timestampRequest)
+        key |= 1;
+    return key;
+}
+
+bool TraceReplayer::compareEntries(const ProbeTrace::Entry &e1, const ProbeTrace::Entry &e2)
+{
+    return e1.time < e2.time;
+}
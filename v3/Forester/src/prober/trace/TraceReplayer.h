@@ -0,0 +1,99 @@
+/*
+ * TraceReplayer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * TraceReplayer answers the probes of SimulatedProber objects with the replies recorded in a
+ * probe trace (see ProbeTrace.h), such that the probing phases of a past run can be re-run with
+ * exactly the same answers from the network, e.g., to debug them or to evaluate a change in the
+ * post-processing or in the alias resolution without probing again.
+ *
+ * A probe is matched with the recorded probes which had the same destination, TTL, protocol and
+ * kind (echo or timestamp request). Matching probes are answered in the order they were sent
+ * during the recording (the first probe gets the first recorded reply, the second probe the
+ * second one, and so on), which is the order in which a replayed unit sends them as long as the
+ * replies are the same. A probe with no recorded probe left gets no reply. The flow ID is not
+ * part of the match, as the source ports/ICMP identifiers given to each thread may differ from
+ * one run to another.
+ *
+ * Recorded replies which echoed the IP-ID of their probe echo the IP-ID of the replayed probe,
+ * so echo counters are still detected as such. Other IP-IDs are replayed as they are, but note
+ * that the delays between them are the ones of the new run, as IP-IDs are timed by the units
+ * (with the virtual clock of their prober, see ProbeResponder.h, which follows the recorded
+ * round-trip times and the schedule of the units rather than the speed of the replay).
+ */
+
+#ifndef TRACEREPLAYER_H_
+#define TRACEREPLAYER_H_
+
+#include <ostream>
+using std::ostream;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include <map>
+using std::map;
+#include <inttypes.h>
+
+#include "ProbeTrace.h"
+#include "../simulated/ProbeResponder.h"
+#include "../../common/thread/Mutex.h"
+
+class TraceReplayer : public ProbeResponder
+{
+public:
+
+    // Constructor, destructor
+    TraceReplayer();
+    ~TraceReplayer();
+
+    // Loads a trace (returns false and sets error if it cannot be read)
+    bool load(string filename, string *error);
+
+    // Methods of ProbeResponder (see ProbeResponder.h)
+    ProbeRecord *respond(const InetAddress &dst,
+                         unsigned short IPIdentifier,
+                         unsigned char TTL,
+                         int protocol,
+                         bool timestampRequest,
+                         bool usingFixedFlowID,
+                         unsigned short srcPortORICMPid,
+                         unsigned short dstPortORICMPseq,
+                         const TimeVal &timeout,
+                         const TimeVal &reqTime);
+    TimeVal getCurrentTime();
+    string resolveHostName(const InetAddress &ip);
+
+    // Sums up the trace and the probes which were answered so far
+    void outputSummary(ostream *out);
+
+private:
+
+    // Recorded probes sharing a same key, and next one to replay
+    struct Sequence
+    {
+        vector<unsigned int> entries;
+        unsigned int next;
+    };
+
+    // Trace
+    vector<ProbeTrace::Entry> entries; // Sorted by time
+    map<uint64_t, Sequence> sequences;
+    map<unsigned long, string> hostNames;
+
+    // State and statistics (protected by the mutex)
+    Mutex replayMutex;
+    TimeVal clock; // Latest time reached by the probers (see ProbeResponder.h)
+    unsigned long nbProbes, nbReplayed, nbMissing, nbTimeouts;
+
+    // Key of a probe (destination, TTL, protocol and kind)
+    static uint64_t getKey(unsigned long dst, unsigned char TTL, int protocol, bool timestampRequest);
+
+    // Orders entries by time (stable, so entries of a same task keep their order)
+    static bool compareEntries(const ProbeTrace::Entry &e1, const ProbeTrace::Entry &e2);
+
+};
+
+#endif /* TRACEREPLAYER_H_ */
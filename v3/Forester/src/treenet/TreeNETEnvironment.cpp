@@ -9,6 +9,7 @@
  */
 
 #include <sys/stat.h> // For CHMOD edition
+#include <ctime> // For time() (freshness of alias resolution hints)
 
 #include "TreeNETEnvironment.h"
 
@@ -30,6 +31,7 @@ TreeNETEnvironment::TreeNETEnvironment(ostream *cOut,
                                        unsigned short mRollovers, 
                                        double bTol, 
                                        double mError, 
+                                       unsigned long hMaxAge, 
                                        unsigned short dMode, 
                                        unsigned short mT):
 consoleOut(cOut), 
@@ -56,12 +58,33 @@ flagEmergencyStop(false)
 {
     this->IPTable = new IPLookUpTable(nIDs);
     this->subnetSet = new SubnetSiteSet();
+    this->aliasSet = new AliasSet();
+    this->routeStore = new RouteStore();
+    this->simulatedNetwork = NULL;
+    this->probeTrace = NULL;
+    this->telemetry = new Telemetry();
+    
+    for(unsigned short i = 0; i < IPTableEntry::NB_HINT_TYPES; i++)
+    {
+        if(i == IPTableEntry::HINT_IP_IDS)
+            hintsMaxAges[i] = 0;
+        else
+            hintsMaxAges[i] = hMaxAge;
+        totalReusedHints[i] = 0;
+    }
 }
 
 TreeNETEnvironment::~TreeNETEnvironment()
 {
+    delete aliasSet;
     delete IPTable;
     delete subnetSet;
+    delete routeStore;
+    if(simulatedNetwork != NULL)
+        delete simulatedNetwork;
+    if(probeTrace != NULL)
+        delete probeTrace;
+    delete telemetry;
 }
 
 ostream* TreeNETEnvironment::getOutputStream()
@@ -98,12 +121,73 @@ void TreeNETEnvironment::updateProbeAmounts(DirectProber *proberObject)
 {
     totalProbes += proberObject->getNbProbes();
     totalSuccessfulProbes += proberObject->getNbSuccessfulProbes();
+    telemetry->mergeProber(proberObject);
+}
+
+SimulatedProber *TreeNETEnvironment::newSimulatedProber(const TimeVal &timeout, 
+                                                       unsigned short lbii, 
+                                                       unsigned short ubii, 
+                                                       unsigned short lbis, 
+                                                       unsigned short ubis)
+{
+    int protocol = DirectProber::ICMP_PROTOCOL;
+    if(probingProtocol == PROBING_PROTOCOL_UDP)
+        protocol = DirectProber::UDP_PROTOCOL;
+    else if(probingProtocol == PROBING_PROTOCOL_TCP)
+        protocol = DirectProber::TCP_PROTOCOL;
+    
+    return new SimulatedProber(simulatedNetwork, 
+                               probeAttentionMessage, 
+                               protocol, 
+                               timeout, 
+                               probeRegulatingPeriod, 
+                               lbii, 
+                               ubii, 
+                               lbis, 
+                               ubis, 
+                               this->debugMode());
+}
+
+void TreeNETEnvironment::pauseProbing(const TimeVal &period)
+{
+    if(simulatedNetwork == NULL)
+        Thread::invokeSleep(period);
+}
+
+TimeVal TreeNETEnvironment::getCurrentTime()
+{
+    if(simulatedNetwork != NULL)
+        return simulatedNetwork->getCurrentTime();
+    return *(TimeVal::getCurrentSystemTime());
+}
+
+void TreeNETEnvironment::registerProber(DirectProber *prober, unsigned char phase)
+{
+    prober->setPhase(phase);
+    telemetry->newProber(phase);
+    if(probeTrace != NULL)
+        prober->setTrace(probeTrace);
+}
+
+void TreeNETEnvironment::traceHostName(const InetAddress &ip, const string &hostName)
+{
+    if(probeTrace != NULL)
+        probeTrace->writeHostName(ip, hostName);
 }
 
 void TreeNETEnvironment::resetProbeAmounts()
 {
     totalProbes = 0;
     totalSuccessfulProbes = 0;
+    for(unsigned short i = 0; i < IPTableEntry::NB_HINT_TYPES; i++)
+        totalReusedHints[i] = 0;
+}
+
+bool TreeNETEnvironment::isHintFresh(IPTableEntry *entry, unsigned short hintType)
+{
+    if(entry == NULL)
+        return false;
+    return entry->isHintFresh(hintType, (unsigned long) time(NULL), hintsMaxAges[hintType]);
 }
 
 void TreeNETEnvironment::openLogStream(string filename, bool message)
@@ -152,6 +236,7 @@ bool TreeNETEnvironment::triggerStop()
 
 void TreeNETEnvironment::resetIPDictionnary()
 {
+    aliasSet->clear();
     delete IPTable;
     IPTable = new IPLookUpTable(nbIPIDs);
 }
@@ -176,8 +261,8 @@ void TreeNETEnvironment::fillIPDictionnary()
         
         // IPs appearing in routes
         unsigned short routeSize = curSubnet->getRouteSize();
-        RouteInterface *route = curSubnet->getRoute();
-        if(routeSize > 0 && route != NULL)
+        RouteView route = curSubnet->getRouteView();
+        if(routeSize > 0 && !route.isEmpty())
         {
             for(unsigned short i = 0; i < routeSize; i++)
             {
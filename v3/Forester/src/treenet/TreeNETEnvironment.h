@@ -26,9 +26,13 @@ using std::ofstream;
 #include "../common/date/TimeVal.h"
 #include "../common/inet/InetAddress.h"
 #include "../prober/DirectProber.h"
+#include "../prober/simulated/SimulatedProber.h"
+#include "utils/Telemetry.h"
 #include "utils/StopException.h" // Not used directly here, but provided to all classes that need it this way
 #include "structure/IPLookUpTable.h"
 #include "structure/SubnetSiteSet.h"
+#include "structure/AliasSet.h"
+#include "structure/RouteStore.h"
 
 class TreeNETEnvironment
 {
@@ -64,6 +68,7 @@ public:
                        unsigned short maxRollovers, 
                        double baseTolerance, 
                        double maxError, 
+                       unsigned long hintsMaxAge, 
                        unsigned short displayMode, 
                        unsigned short maxThreads);
     ~TreeNETEnvironment();
@@ -76,6 +81,8 @@ public:
     // Accessers
     inline IPLookUpTable *getIPTable() { return this->IPTable; }
     inline SubnetSiteSet *getSubnetSet() { return this->subnetSet; }
+    inline AliasSet *getAliasSet() { return this->aliasSet; }
+    inline RouteStore *getRouteStore() { return this->routeStore; }
     
     // Accesser to the output stream is not inline, because it depends of the settings
     ostream *getOutputStream();
@@ -97,6 +104,17 @@ public:
     inline double getBaseTolerance() { return this->baseTolerance; }
     inline double getMaxError() { return this->maxError; }
     
+    /*
+     * Freshness policy for alias resolution hints: a hint of a given type (see 
+     * IPTableEntry::AliasHintTypes) collected less than getHintsMaxAges()[type] seconds ago does 
+     * not need to be collected again. IP IDs are never considered as fresh, since probe tokens 
+     * only make sense within a same collection. The other types are kept for the max. age 
+     * selected by the user (0 by default, i.e., every hint is collected again).
+     */
+    
+    inline const unsigned long *getHintsMaxAges() { return this->hintsMaxAges; }
+    bool isHintFresh(IPTableEntry *entry, unsigned short hintType);
+    
     inline unsigned short getDisplayMode() { return this->displayMode; }
     inline bool debugMode() { return (this->displayMode == DISPLAY_MODE_DEBUG); }
     inline unsigned short getMaxThreads() { return this->maxThreads; }
@@ -118,6 +136,10 @@ public:
     inline unsigned int getTotalProbes() { return this->totalProbes; }
     inline unsigned int getTotalSuccessfulProbes() { return this->totalSuccessfulProbes; }
     
+    // Same for the amount of hints which were not collected again because they were still fresh
+    inline void updateReusedHints(unsigned short hintType, unsigned int amount) { totalReusedHints[hintType] += amount; }
+    inline unsigned int getTotalReusedHints(unsigned short hintType) { return this->totalReusedHints[hintType]; }
+    
     // Method to handle the output stream writing in an output file.
     void openLogStream(string filename, bool message = true);
     void closeLogStream();
@@ -143,12 +165,56 @@ public:
     
     void resetIPDictionnary();
     void fillIPDictionnary();
+    
+    /*
+     * October 2026: probes can be answered by a simulated network rather than being sent (see 
+     * SimulatedNetwork) or by the replay of a trace (see TraceReplayer). The environment becomes the owner of the responder, and the probing 
+     * units get their prober with newSimulatedProber() (same parameters as the other probers, 
+     * the protocol being the one selected by the user) whenever a responder is set.
+     */
+    
+    inline void setSimulatedNetwork(ProbeResponder *responder) { this->simulatedNetwork = responder; }
+    inline ProbeResponder *getSimulatedNetwork() { return this->simulatedNetwork; }
+    SimulatedProber *newSimulatedProber(const TimeVal &timeout, 
+                                        unsigned short lbii, 
+                                        unsigned short ubii, 
+                                        unsigned short lbis, 
+                                        unsigned short ubis);
+    
+    /*
+     * Pauses between probes or between probing threads, which are only meant to spare the 
+     * probed routers. They are skipped when probes are simulated (the scheduling of the IP-IDs 
+     * collection, however, is kept, as it determines the observed velocities: it is followed on 
+     * the virtual clock of the probers, see DirectProber::waitUntil()). getCurrentTime() gives 
+     * the clock probes are timed with, i.e., the one of the responder if probes are simulated.
+     */
+    
+    void pauseProbing(const TimeVal &period);
+    TimeVal getCurrentTime();
+    
+    /*
+     * Each new prober must be registered with the phase it belongs to (see ProbeTrace), for the 
+     * telemetry (see Telemetry) and to record its probes if a trace is set (the environment 
+     * becomes the owner of the trace). traceHostName() records the result of a reverse DNS 
+     * look-up in the trace, if any.
+     */
+    
+    void registerProber(DirectProber *prober, unsigned char phase);
+    inline void setProbeTrace(ProbeTrace *trace) { this->probeTrace = trace; }
+    inline ProbeTrace *getProbeTrace() { return this->probeTrace; }
+    void traceHostName(const InetAddress &ip, const string &hostName);
+    inline Telemetry *getTelemetry() { return this->telemetry; }
 
 private:
 
     // Structures
     IPLookUpTable *IPTable;
     SubnetSiteSet *subnetSet;
+    AliasSet *aliasSet; // Alias decisions over all neighborhoods (relies on IPTable entries)
+    RouteStore *routeStore; // Shared routes of subnets (must outlive the subnets)
+    ProbeResponder *simulatedNetwork; // NULL unless probes are simulated
+    ProbeTrace *probeTrace; // NULL unless probes are recorded
+    Telemetry *telemetry;
     
     /*
      * Output streams (main console output and file stream for the external logs). Having both is 
@@ -174,6 +240,7 @@ private:
     unsigned short maxRollovers;
     double baseTolerance;
     double maxError;
+    unsigned long hintsMaxAges[IPTableEntry::NB_HINT_TYPES];
     
     // Field for maintaining display mode (max. value = 3, amounts to debug mode)
     unsigned short displayMode;
@@ -184,6 +251,7 @@ private:
     // Fields to record the amount of (successful) probes used during some stage (can be reset)
     unsigned int totalProbes;
     unsigned int totalSuccessfulProbes;
+    unsigned int totalReusedHints[IPTableEntry::NB_HINT_TYPES];
     
     // Flag for emergency exit
     bool flagEmergencyStop;
@@ -8,6 +8,10 @@
  * goals of such class).
  */
 
+#include <ctime>
+#include <vector>
+using std::vector;
+
 #include "AliasHintCollector.h"
 #include "IPIDUnit.h"
 #include "UDPUnreachablePortUnit.h"
@@ -15,10 +19,13 @@
 #include "ReverseDNSUnit.h"
 #include "../../common/thread/Thread.h"
 
-AliasHintCollector::AliasHintCollector(TreeNETEnvironment *env)
+AliasHintCollector::AliasHintCollector(TreeNETEnvironment *env):
+IPIDMutex(Mutex::ERROR_CHECKING_MUTEX), 
+IPIDCondition(&IPIDMutex)
 {
     this->env = env;
     tokenCounter = 1;
+    IPIDInFlight = 0;
     
     printSteps = false;
     debug = false;
@@ -75,10 +82,15 @@ void AliasHintCollector::collect()
     for(unsigned short i = 0; i < nbThreads; i++)
         th[i] = NULL;
 
-    // Does a copy of the IPs list for next hints
-    list<InetAddress> backUp1(this->IPsToProbe);
-    list<InetAddress> backUp2(this->IPsToProbe);
-    list<InetAddress> backUp3(this->IPsToProbe);
+    // Lists the IPs for which next hints must be collected (i.e., hints are missing or outdated)
+    list<InetAddress> UDPTargets = this->listStaleTargets(IPTableEntry::HINT_PORT_UNREACHABLE);
+    list<InetAddress> TSTargets = this->listStaleTargets(IPTableEntry::HINT_TIMESTAMP_REPLY);
+    list<InetAddress> DNSTargets = this->listStaleTargets(IPTableEntry::HINT_REVERSE_DNS);
+    
+    // Does a copy of these lists (the copies are emptied during probing)
+    list<InetAddress> backUp1(UDPTargets);
+    list<InetAddress> backUp2(TSTargets);
+    list<InetAddress> backUp3(DNSTargets);
     
     if(printSteps)
     {
@@ -97,138 +109,145 @@ void AliasHintCollector::collect()
     }
 
     /*
-     * Starts scheduling for IP-ID collection; the code proceeds by rounds, i.e., it will probe 
-     * all candidate during the first round and wait for a reply. It is only after getting a reply 
-     * or a timeout for each that the next round can start.
+     * Starts scheduling for IP-ID collection. All targets are put on a single timeline: the k-th 
+     * probe of the j-th target is sent at start + k * spacing + j * stagger. The spacing is the 
+     * time needed to go through the whole list of targets once with a stagger of 
+     * IPID_PROBE_STAGGER, but bounded by IPID_MIN_SPACING and IPID_MAX_SPACING, such that the 
+     * delay between two IP-IDs of a same target does not grow with the neighborhood (which would 
+     * cause rollovers). The stagger is then spacing / nbIPs. The probes of all targets are 
+     * therefore interleaved just like with the former rounds (and the probe tokens of any two IPs 
+     * overlap, which AliasResolver relies on), but there is no barrier between two rounds 
+     * anymore: the (k + 1)-th probe of a target is scheduled as soon as its k-th probe got a 
+     * reply, and an IP which did not reply is not probed anymore.
+     *
+     * The probes are sent by a pool of nbThreads IPIDUnit workers, each taking the earliest 
+     * scheduled probe (see nextIPIDProbe()) and waiting for its time before sending it (if late, 
+     * the probe is sent right away). Tuples are saved by probe index (i.e., the former "rounds") 
+     * for the post-processing.
      */
     
-    list<InetAddress> roundTargets = this->IPsToProbe;
-    for(unsigned short i = 0; i < nbIPIDs; i++)
+    unsigned long spacingMicro = nbIPs * IPID_PROBE_STAGGER;
+    if(spacingMicro < IPID_MIN_SPACING)
+        spacingMicro = IPID_MIN_SPACING;
+    else if(spacingMicro > IPID_MAX_SPACING)
+        spacingMicro = IPID_MAX_SPACING;
+    unsigned long staggerMicro = spacingMicro / nbIPs;
+    
+    IPIDTargets.clear();
+    IPIDTimeouts.clear();
+    IPIDCollected.clear();
+    for(list<InetAddress>::iterator it = IPsToProbe.begin(); it != IPsToProbe.end(); ++it)
     {
-        list<IPIDTuple> tuples;
-        
-        // Schedules one IPIDUnit per IP
-        unsigned short range = (DirectProber::DEFAULT_UPPER_SRC_PORT_ICMP_ID - DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID) / maxThreads;
-        unsigned short j = 0;
-        while(roundTargets.size() > 0)
+        // Timeout of each target (a higher timeout can be suggested for some IP)
+        TimeVal timeout = env->getTimeoutPeriod();
+        IPTableEntry *IPEntry = table->lookUp((*it));
+        if(IPEntry != NULL && IPEntry->getPreferredTimeout() > timeout)
+            timeout = IPEntry->getPreferredTimeout();
+        
+        IPIDTargets.push_back((*it));
+        IPIDTimeouts.push_back(timeout);
+        IPIDCollected.resize(IPIDCollected.size() + nbIPIDs, IPIDTuple((*it)));
+    }
+    
+    IPIDMutex.lock();
+    IPIDStart = env->getCurrentTime();
+    IPIDSpacing = TimeVal(spacingMicro / 1000000, spacingMicro % 1000000);
+    IPIDStagger = TimeVal(staggerMicro / 1000000, staggerMicro % 1000000);
+    IPIDInFlight = 0;
+    for(unsigned int j = 0; j < IPIDTargets.size(); j++)
+        this->scheduleIPIDProbe(j, 0);
+    IPIDMutex.unlock();
+    
+    // Schedules the workers
+    unsigned short range = (DirectProber::DEFAULT_UPPER_SRC_PORT_ICMP_ID - DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID) / maxThreads;
+    for(unsigned short j = 0; j < nbThreads; j++)
+    {
+        Runnable *task = NULL;
+        try
         {
-            InetAddress IPToProbe(roundTargets.front());
-            roundTargets.pop_front();
-            
-            // If current thread not null, waits for completion before scheduling the new IPIDUnit
-            if(th[j] != NULL)
-            {
-                th[j]->join();
-                IPIDUnit *curUnit = (IPIDUnit*) th[j]->getRunnable();
-                
-                if(env->debugMode())
-                    (*out) << curUnit->getDebugLog();
-                
-                if(curUnit->hasExploitableResults())
-                    tuples.push_back(curUnit->getTuple());
-                
-                delete th[j];
-                th[j] = NULL;
-            }
-            
-            // Schedules the new IPIDUnit
-            Runnable *task = NULL;
-            try
-            {
-                task = new IPIDUnit(this->env, 
-                                    this, 
-                                    IPToProbe, 
-                                    DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + (j * range), 
-                                    DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + (j * range) + range - 1, 
-                                    DirectProber::DEFAULT_LOWER_DST_PORT_ICMP_SEQ, 
-                                    DirectProber::DEFAULT_UPPER_DST_PORT_ICMP_SEQ);
-                th[j] = new Thread(task);
-            }
-            catch(SocketException &se)
+            task = new IPIDUnit(this->env, 
+                                this, 
+                                DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + (j * range), 
+                                DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + (j * range) + range - 1, 
+                                DirectProber::DEFAULT_LOWER_DST_PORT_ICMP_SEQ, 
+                                DirectProber::DEFAULT_UPPER_DST_PORT_ICMP_SEQ);
+            th[j] = new Thread(task);
+        }
+        catch(SocketException &se)
+        {
+            // Cleans remaining threads (if any is set)
+            for(unsigned short k = 0; k < nbThreads; k++)
             {
-                // Cleans remaining threads (if any is set)
-                for(unsigned short k = 0; k < nbThreads; k++)
+                if(th[k] != NULL)
                 {
-                    if(th[k] != NULL)
-                    {
-                        th[k]->join();
-                        delete th[k];
-                        th[k] = NULL;
-                    }
+                    th[k]->join();
+                    delete th[k];
+                    th[k] = NULL;
                 }
-                
-                delete[] th;
-                
-                throw StopException();
             }
-            catch(ThreadException &te)
-            {
-                (*out) << "\nUnable to create more threads." << endl;
             
-                delete task;
+            delete[] th;
             
-                // Cleans remaining threads (if any is set)
-                for(unsigned short k = 0; k < nbThreads; k++)
+            throw StopException();
+        }
+        catch(ThreadException &te)
+        {
+            (*out) << "\nUnable to create more threads." << endl;
+        
+            delete task;
+        
+            // Cleans remaining threads (if any is set)
+            for(unsigned short k = 0; k < nbThreads; k++)
+            {
+                if(th[k] != NULL)
                 {
-                    if(th[k] != NULL)
-                    {
-                        th[k]->join();
-                        delete th[k];
-                        th[k] = NULL;
-                    }
+                    th[k]->join();
+                    delete th[k];
+                    th[k] = NULL;
                 }
-                
-                delete[] th;
-            
-                throw StopException();
             }
             
-            // Starts and moves to next thread
-            th[j]->start();
-            
-            j++;
-            if(j == nbThreads)
-                j = 0;
-            
-            // 0,01s of delay before next thread
-            Thread::invokeSleep(TimeVal(0, 10000));
-            
-            if(env->isStopping())
-                break;
+            delete[] th;
+        
+            throw StopException();
         }
-
-        // Waiting for all remaining threads to complete
-        for(j = 0; j < nbThreads; j++)
+        
+        th[j]->start();
+    }
+    
+    // Waiting for all workers to complete
+    for(unsigned short j = 0; j < nbThreads; j++)
+    {
+        if(th[j] != NULL)
         {
-            if(th[j] != NULL)
-            {
-                th[j]->join();
-                IPIDUnit *curUnit = (IPIDUnit*) th[j]->getRunnable();
-                
-                if(env->debugMode())
-                    (*out) << curUnit->getDebugLog();
-                
-                if(curUnit->hasExploitableResults())
-                    tuples.push_back(curUnit->getTuple());
-                
-                delete th[j];
-                th[j] = NULL;
-            }
+            th[j]->join();
+            IPIDUnit *curUnit = (IPIDUnit*) th[j]->getRunnable();
+            
+            if(env->debugMode())
+                (*out) << curUnit->getDebugLog();
+            
+            delete th[j];
+            th[j] = NULL;
         }
-        
-        /*
-         * End of current round, we do a quick post-processing of the tuples to schedule the next 
-         * round and re-order IP-IDs which clearly form a sequence but came out-of-order due to 
-         * network delays.
-         */
-        
-        tuples.sort(IPIDTuple::compareByTime);
-        for(list<IPIDTuple>::iterator it = tuples.begin(); it != tuples.end(); ++it)
-            roundTargets.push_back((*it).target);
-        
+    }
+    
+    vector<list<IPIDTuple> > tuplesByIndex(nbIPIDs);
+    for(unsigned int j = 0; j < IPIDTargets.size(); j++)
+        for(unsigned short i = 0; i < nbIPIDs; i++)
+            if(IPIDCollected[j * nbIPIDs + i].probeToken != 0)
+                tuplesByIndex[i].push_back(IPIDCollected[j * nbIPIDs + i]);
+    
+    /*
+     * Quick post-processing of the tuples of each probe index to re-order IP-IDs which clearly 
+     * form a sequence but came out-of-order due to network delays.
+     */
+    
+    unsigned short reordered = 0;
+    for(unsigned short i = 0; i < nbIPIDs && !env->isStopping(); i++)
+    {
+        list<IPIDTuple> tuples = tuplesByIndex[i];
         tuples.sort(IPIDTuple::compareByID);
         IPIDTuple prev;
-        unsigned short reordered = 0;
         for(list<IPIDTuple>::iterator it = tuples.begin(); it != tuples.end(); ++it)
         {
             if(prev.probeToken != 0)
@@ -288,24 +307,14 @@ void AliasHintCollector::collect()
                 tuplesArray[i] = curTuple;
             }
         }
-        
-        if(env->isStopping())
-            break;
-        
-        if(printSteps)
-        {
-            if(i == 0)
-                (*out) << endl;
-            (*out) << "Done with round " << (i + 1) << ".";
-            if(reordered > 0)
-            {
-                if(reordered > 1)
-                    (*out) << " Changed position of " << reordered << " tokens.";
-                else
-                    (*out) << " Changed position of one token.";
-            }
-            (*out) << endl;
-        }
+    }
+    
+    if(printSteps && reordered > 0)
+    {
+        if(reordered > 1)
+            (*out) << "Changed position of " << reordered << " tokens." << endl;
+        else
+            (*out) << "Changed position of one token." << endl;
     }
     
     if(env->isStopping())
@@ -315,11 +324,11 @@ void AliasHintCollector::collect()
     }
     
     /*
-     * For each initial target IP, computes the final data (uses backUp1 for this) to store in 
-     * the IP dictionnary, using the map.
+     * For each initial target IP, computes the final data to store in the IP dictionnary, using 
+     * the map.
      */
     
-    for(list<InetAddress>::iterator it = backUp1.begin(); it != backUp1.end(); ++it)
+    for(list<InetAddress>::iterator it = IPsToProbe.begin(); it != IPsToProbe.end(); ++it)
     {
         InetAddress curIP = (*it);
         map<InetAddress, IPIDTuple*>::iterator res = IPIDTuples.find(curIP);
@@ -385,6 +394,7 @@ void AliasHintCollector::collect()
                 targetEntry->setEchoInitialTTL(inferredInitialTTL);
         }
     }
+    this->stampHints(IPsToProbe, IPTableEntry::HINT_IP_IDS);
     
     if(printSteps)
     {
@@ -409,7 +419,6 @@ void AliasHintCollector::collect()
     
     // TODO: compile and debug
     
-    unsigned short range = (DirectProber::DEFAULT_UPPER_SRC_PORT_ICMP_ID - DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID) / maxThreads;
     unsigned short i = 0;
     while(backUp1.size() > 0)
     {
@@ -491,7 +500,7 @@ void AliasHintCollector::collect()
             i = 0;
         
         // 0,1s of delay before next thread (if same router, avoids to "bomb" it)
-        Thread::invokeSleep(TimeVal(0, 100000));
+        env->pauseProbing(TimeVal(0, 100000));
         
         if(env->isStopping())
             break;
@@ -522,10 +531,14 @@ void AliasHintCollector::collect()
         throw StopException();
     }
     
+    this->stampHints(UDPTargets, IPTableEntry::HINT_PORT_UNREACHABLE);
+    
     if(printSteps)
     {
         // Different output for debug mode
-        if(debug)
+        if(UDPTargets.size() == 0)
+            (*out) << "Skipped (all hints are fresh)." << endl;
+        else if(debug)
         {
             (*out) << "\nDone with UDP probing for this neighborhood.\n" << endl;
         }
@@ -623,7 +636,7 @@ void AliasHintCollector::collect()
             i = 0;
         
         // 0,1s of delay before next thread (if same router, avoids to "bomb" it)
-        Thread::invokeSleep(TimeVal(0, 100000));
+        env->pauseProbing(TimeVal(0, 100000));
         
         if(env->isStopping())
             break;
@@ -654,10 +667,14 @@ void AliasHintCollector::collect()
         throw StopException();
     }
     
+    this->stampHints(TSTargets, IPTableEntry::HINT_TIMESTAMP_REPLY);
+    
     if(printSteps)
     {
         // Different output for debug mode
-        if(debug)
+        if(TSTargets.size() == 0)
+            (*out) << "Skipped (all hints are fresh)." << endl;
+        else if(debug)
         {
             (*out) << "\nDone with timestamp requests for this neighborhood.\n" << endl;
         }
@@ -718,7 +735,7 @@ void AliasHintCollector::collect()
             i = 0;
         
         // 0,01s of delay before next thread
-        Thread::invokeSleep(TimeVal(0, 10000));
+        env->pauseProbing(TimeVal(0, 10000));
         
         if(env->isStopping())
             break;
@@ -742,6 +759,8 @@ void AliasHintCollector::collect()
         throw StopException();
     }
     
+    this->stampHints(DNSTargets, IPTableEntry::HINT_REVERSE_DNS);
+    
     /*
      * No condition on printSteps here because the "Done" follows the "Collecting hints..." and is 
      * therefore still relevant.
@@ -754,7 +773,78 @@ void AliasHintCollector::collect()
 
 unsigned long int AliasHintCollector::getProbeToken()
 {
-    unsigned long int token = tokenCounter;
-    tokenCounter++;
-    return token;
+    // Atomic increment (GCC built-in), as tokens are taken concurrently by IPIDUnit threads
+    return __sync_fetch_and_add(&tokenCounter, 1);
+}
+
+void AliasHintCollector::scheduleIPIDProbe(unsigned int target, unsigned short index)
+{
+    IPIDProbe probe;
+    probe.time = IPIDStart + IPIDSpacing * (float) index + IPIDStagger * (float) target;
+    probe.target = target;
+    probe.index = index;
+    probe.IP = IPIDTargets[target];
+    probe.timeout = IPIDTimeouts[target];
+    IPIDSchedule.push(probe);
+}
+
+bool AliasHintCollector::nextIPIDProbe(IPIDProbe *probe)
+{
+    IPIDCondition.lock();
+    while(IPIDSchedule.empty() && IPIDInFlight > 0 && !env->isStopping())
+        IPIDCondition.wait();
+    
+    if(IPIDSchedule.empty() || env->isStopping())
+    {
+        IPIDCondition.unlock();
+        return false;
+    }
+    
+    (*probe) = IPIDSchedule.top();
+    IPIDSchedule.pop();
+    IPIDInFlight++;
+    IPIDCondition.unlock();
+    return true;
+}
+
+void AliasHintCollector::completeIPIDProbe(const IPIDProbe &probe, IPIDTuple *tuple)
+{
+    IPIDCondition.lock();
+    IPIDInFlight--;
+    if(tuple != NULL)
+    {
+        IPIDCollected[probe.target * env->getNbIPIDs() + probe.index] = (*tuple);
+        if(probe.index + 1 < env->getNbIPIDs())
+            this->scheduleIPIDProbe(probe.target, probe.index + 1);
+    }
+    IPIDCondition.broadcast();
+    IPIDCondition.unlock();
+}
+
+list<InetAddress> AliasHintCollector::listStaleTargets(unsigned short hintType)
+{
+    IPLookUpTable *table = env->getIPTable();
+    list<InetAddress> targets;
+    unsigned int nbFresh = 0;
+    for(list<InetAddress>::iterator it = IPsToProbe.begin(); it != IPsToProbe.end(); ++it)
+    {
+        if(env->isHintFresh(table->lookUp((*it)), hintType))
+            nbFresh++;
+        else
+            targets.push_back((*it));
+    }
+    env->updateReusedHints(hintType, nbFresh);
+    return targets;
+}
+
+void AliasHintCollector::stampHints(list<InetAddress> targets, unsigned short hintType)
+{
+    IPLookUpTable *table = env->getIPTable();
+    unsigned long now = (unsigned long) time(NULL);
+    for(list<InetAddress>::iterator it = targets.begin(); it != targets.end(); ++it)
+    {
+        IPTableEntry *entry = table->lookUp((*it));
+        if(entry != NULL)
+            entry->setHintCollectionTime(hintType, now);
+    }
 }
@@ -8,12 +8,16 @@
  * probing a single IP and retrieving the IP identifier found in the response. This IP is later 
  * written inside the InetAddress object which corresponds to the probed IP. AliasHintCollector also
  * associates a "probe token" to each IP, which is a number taken from a single counter 
- * (synchronized with a Mutex object), which is later used to locate the IP identifiers in time.
+ * (incremented atomically), which is later used to locate the IP identifiers in time.
  *
  * This duo IP identifier/probe token is later used to resolve aliases in an internal node 
  * (obtained in the network tree), therefore allowing the inference of routers. The alias 
  * resolution itself is performed with the class AliasResolver.
  *
+ * Hints which are still fresh according to the freshness policy of the environment (see 
+ * TreeNETEnvironment::isHintFresh()) are not collected again; only the IP-IDs are always probed, 
+ * since the probe tokens only make sense within a same collection.
+ *
  * N.B.: here, the TTL of each probe is a constant. Indeed, TTL is not relevant for these new
  * probes. This constant is defined by the class AliasHintCollectorUnit.
  */
@@ -26,8 +30,13 @@ using std::list;
 #include <map>
 using std::map;
 using std::pair;
+#include <vector>
+using std::vector;
+#include <queue>
+using std::priority_queue;
 
 #include "../TreeNETEnvironment.h"
+#include "../../common/thread/ConditionVariable.h"
 #include "../../prober/DirectProber.h"
 #include "../../prober/icmp/DirectICMPProber.h"
 #include "IPIDTuple.h"
@@ -38,6 +47,25 @@ public:
 
     // Threshold for assuming that 2 consecutives IDs after sorting by IDs are from a same device
     static const unsigned short IPID_MAX_DIFF = 10;
+    
+    /*
+     * Scheduling of IP-ID probes (in microseconds): preferred delay between the timelines of two 
+     * consecutive targets, and bounds of the delay between two probes to a same target.
+     */
+    
+    static const unsigned long IPID_PROBE_STAGGER = 10000;
+    static const unsigned long IPID_MIN_SPACING = 100000;
+    static const unsigned long IPID_MAX_SPACING = 1000000;
+    
+    // Scheduled IP-ID probe (index-th IP-ID of the target-th IP to probe)
+    struct IPIDProbe
+    {
+        TimeVal time;
+        unsigned int target;
+        unsigned short index;
+        InetAddress IP;
+        TimeVal timeout;
+    };
 
     // Constructor, destructor
     AliasHintCollector(TreeNETEnvironment *env);
@@ -52,9 +80,20 @@ public:
     // Method to start the probing (note: this empties the IPsToProbe list)
     void collect();
     
-    // Method to get a token (used by IPIDUnit objects)
+    // Method to get a token (used by IPIDUnit objects; thread-safe, without lock)
     unsigned long int getProbeToken();
     
+    /*
+     * Methods used by the IPIDUnit workers (thread-safe). nextIPIDProbe() gives the earliest 
+     * scheduled IP-ID probe, waiting for probes in flight to schedule new ones if needed, and 
+     * returns false once there is nothing left to probe (or when the program is stopping). Each 
+     * probe obtained this way must then be completed with completeIPIDProbe(), along with the 
+     * resulting tuple (NULL if the target did not reply, in which case it is not probed again).
+     */
+    
+    bool nextIPIDProbe(IPIDProbe *probe);
+    void completeIPIDProbe(const IPIDProbe &probe, IPIDTuple *tuple);
+    
     /*
      * Method to let external methods (collectHintsRecursive() in NetworkTree class) know if every 
      * step is announced in the console output.
@@ -75,8 +114,43 @@ private:
     // Map to save collected IP-ID tuples before treating and storing them in the IP dictionnary
     map<InetAddress, IPIDTuple*> IPIDTuples;
     
+    // Orders scheduled IP-ID probes such that the earliest one is on top of the queue
+    struct LaterIPIDProbe
+    {
+        bool operator()(const IPIDProbe &p1, const IPIDProbe &p2) const { return p1.time > p2.time; }
+    };
+    
+    /*
+     * Timeline of the IP-ID collection: targets (with their timeout), collected tuples (nbIPIDs 
+     * per target), start time, spacing between two probes to a same target, delay between the 
+     * timelines of two consecutive targets, scheduled probes and amount of probes in flight (the 
+     * last three being protected by the condition variable).
+     */
+    
+    vector<InetAddress> IPIDTargets;
+    vector<TimeVal> IPIDTimeouts;
+    vector<IPIDTuple> IPIDCollected;
+    TimeVal IPIDStart, IPIDSpacing, IPIDStagger;
+    priority_queue<IPIDProbe, vector<IPIDProbe>, LaterIPIDProbe> IPIDSchedule;
+    unsigned int IPIDInFlight;
+    Mutex IPIDMutex;
+    ConditionVariable IPIDCondition;
+    
+    // Schedules the index-th probe of the target-th IP on the timeline (mutex must be locked)
+    void scheduleIPIDProbe(unsigned int target, unsigned short index);
+    
     // Debug stuff
     bool printSteps, debug;
+    
+    /*
+     * Lists the IPs to probe for which the hint of the given type is no longer fresh, and 
+     * records the amount of fresh (thus, re-used) hints in the environment.
+     */
+    
+    list<InetAddress> listStaleTargets(unsigned short hintType);
+    
+    // Records the current time as the collection time of the given hint type for the given IPs
+    void stampHints(list<InetAddress> targets, unsigned short hintType);
 
 };
 
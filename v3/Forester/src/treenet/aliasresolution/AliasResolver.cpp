@@ -18,10 +18,14 @@ AliasResolver::AliasResolver(TreeNETEnvironment *env)
 {
     this->env = env;
     this->currentTTL = 0;
+    this->evaluator = new IPIDCounterEvaluator(env->getNbIPIDs(), 
+                                               env->getMaxRollovers(), 
+                                               env->getMaxError());
 }
 
 AliasResolver::~AliasResolver()
 {
+    delete evaluator;
 }
 
 bool AliasResolver::portUnreachableAliasing(IPTableEntry *ip1, IPTableEntry *ip2)
@@ -176,186 +180,6 @@ unsigned short AliasResolver::groupAlly(Fingerprint isolatedIP,
     return ALLY_NO_SEQUENCE;
 }
 
-void AliasResolver::evaluateIPIDCounter(IPTableEntry *ip)
-{
-    // The first condition is just in case; normally calling code checks it first
-    if(ip != NULL && ip->hasIPIDData())
-    {
-        // Alias resolution parameters
-        unsigned short nbIPIDs = env->getNbIPIDs();
-        unsigned short maxRollovers = env->getMaxRollovers();
-        double maxError = env->getMaxError();
-        
-        // Checks if this is an IP that just echoes the ID provided in probes
-        unsigned short nbEchoes = 0;
-        for(unsigned short i = 0; i < nbIPIDs; i++)
-        {
-            if(ip->getEcho(i))
-            {
-                nbEchoes++;
-            }
-        }
-        
-        if(nbEchoes == nbIPIDs)
-        {
-            ip->setCounterType(IPTableEntry::ECHO_COUNTER);
-            ip->raiseFlagProcessed();
-            return;
-        }
-        
-        // Looks at the amount of negative deltas
-        unsigned short negativeDeltas = 0;
-        for(unsigned short i = 0; i < nbIPIDs - 1; i++)
-        {
-            unsigned short cur = ip->getIPIdentifier(i);
-            unsigned short next = ip->getIPIdentifier(i + 1);
-            if(cur > next)
-            {
-                negativeDeltas++;
-            }
-        }
-        
-        // If one or zero negative deltas, straightforward evaluation
-        if(negativeDeltas < 2)
-        {
-            double v[nbIPIDs - 1];
-            
-            // Velocity computation
-            for(unsigned short i = 0; i < nbIPIDs - 1; i++)
-            {
-                double b_i = (double) ip->getIPIdentifier(i);
-                double b_i_plus_1 = (double) ip->getIPIdentifier(i + 1);
-                double d_i = ip->getDelay(i);
-                
-                if(b_i_plus_1 > b_i)
-                    v[i] = (b_i_plus_1 - b_i) / d_i;
-                else
-                    v[i] = (b_i_plus_1 + (65535 - b_i)) / d_i;
-            }
-            
-            // Finds minimum/maximum velocity
-            double maxV = v[0], minV = v[0];
-            for(unsigned short i = 0; i < nbIPIDs - 1; i++)
-            {
-                if(v[i] > maxV)
-                    maxV = v[i];
-                if(v[i] < minV)
-                    minV = v[i];
-            }
-            
-            ip->setVelocityLowerBound(minV);
-            ip->setVelocityUpperBound(maxV);
-            ip->setCounterType(IPTableEntry::HEALTHY_COUNTER);
-            ip->raiseFlagProcessed();
-            return;
-        }
-    
-        // Otherwise, solving equations becomes necessary.
-        double d0 = (double) ip->getDelay(0);
-        double b0 = (double) ip->getIPIdentifier(0);
-        double b1 = (double) ip->getIPIdentifier(1);
-        
-        double x = 0.0;
-        double v[nbIPIDs - 1];
-        
-        bool success = false;
-        for(unsigned short i = 0; i < maxRollovers; i++)
-        {
-            // Computing speed for x
-            if(b1 > b0)
-                v[0] = (b1 - b0 + 65535 * x) / d0;
-            else
-                v[0] = (b1 + (65535 - b0) + 65535 * x) / d0;
-            
-            success = true;
-            for(unsigned short j = 1; j < nbIPIDs - 1; j++)
-            {
-                // Computing speed for cur
-                double b_j = (double) ip->getIPIdentifier(j);
-                double b_j_plus_1 = (double) ip->getIPIdentifier(j + 1);
-                double d_j = (double) ip->getDelay(j);
-                double cur = 0.0;
-                
-                cur += (d_j / d0) * x;
-                
-                if(b_j_plus_1 > b_j)
-                    cur -= ((b_j_plus_1 - b_j) / 65535);
-                else
-                    cur -= ((b_j_plus_1 + (65535 - b_j)) / 65535);
-                
-                if(b1 > b0)
-                    cur += (((d_j * b1) - (d_j * b0)) / (65535 * d0));
-                else
-                    cur += (((d_j * b1) + (d_j * (65535 - b0))) / (65535 * d0));
-                
-                // Flooring/ceiling cur
-                double floorCur = floor(cur);
-                double ceilCur = ceil(cur);
-                
-                double selectedCur = 0.0;
-                double gap = 0.0;
-                
-                if((cur - floorCur) > (ceilCur - cur))
-                {
-                    selectedCur = ceilCur;
-                    gap = ceilCur - cur;
-                }
-                else
-                {
-                    selectedCur = floorCur;
-                    gap = cur - floorCur;
-                }
-                
-                // Storing speed of current time interval
-                if(selectedCur > 0.0 && gap <= maxError)
-                {
-                    if(b_j_plus_1 > b_j)
-                        v[j] = (b_j_plus_1 - b_j + 65535 * selectedCur) / d_j;
-                    else
-                        v[j] = (b_j_plus_1 + (65535 - b_j) + 65535 * selectedCur) / d_j;
-                }
-                else
-                {
-                    success = false;
-                    break;
-                }
-            }
-            
-            if(success)
-            {
-                break;
-            }
-            
-            x += 1.0;
-        }
-        
-        if(success)
-        {
-            double maxV = v[0], minV = v[0];
-            for(unsigned short i = 0; i < nbIPIDs - 1; i++)
-            {
-                if(v[i] > maxV)
-                    maxV = v[i];
-                if(v[i] < minV)
-                    minV = v[i];
-            }
-            
-            ip->setVelocityLowerBound(minV);
-            ip->setVelocityUpperBound(maxV);
-            ip->setCounterType(IPTableEntry::HEALTHY_COUNTER);
-        }
-        else
-        {
-            // "Infinite" velocity: [0.0, 65535.0]; interpreted as a random counter
-            ip->setVelocityLowerBound(0.0);
-            ip->setVelocityUpperBound(65535.0);
-            ip->setCounterType(IPTableEntry::RANDOM_COUNTER);
-        }
-        
-        ip->raiseFlagProcessed();
-    }
-}
-
 bool AliasResolver::velocityOverlap(IPTableEntry *ip1, IPTableEntry *ip2)
 {
     if(ip1 == NULL || ip2 == NULL)
@@ -486,43 +310,27 @@ bool AliasResolver::reverseDNS(IPTableEntry *ip1, IPTableEntry *ip2)
     if(ip1 == NULL || ip2 == NULL)
         return false;
     
-    string hostName1 = ip1->getHostName();
-    string hostName2 = ip2->getHostName();
+    const vector<unsigned int> &hn1 = ip1->getHostNameLabels();
+    const vector<unsigned int> &hn2 = ip2->getHostNameLabels();
     
-    if(!hostName1.empty() && !hostName2.empty())
+    if(hn1.size() > 0 && hn2.size() > 0)
     {
-        list<string> hn1Chunks;
-        list<string> hn2Chunks;
-        string element;
-        
-        stringstream hn1(hostName1);
-        while (std::getline(hn1, element, '.'))
-        {
-            hn1Chunks.push_front(element);
-        }
+        /*
+         * Host names are interned with the top-level domain first (see HostNamePool.h). An empty 
+         * first label comes from a trailing dot and is not considered as a chunk, like before 
+         * host names were interned (they were split with getline(), which ignores it).
+         */
         
-        stringstream hn2(hostName2);
-        while (std::getline(hn2, element, '.'))
-        {
-            hn2Chunks.push_front(element);
-        }
+        size_t offset1 = (hn1[0] == HostNamePool::EMPTY_LABEL) ? 1 : 0;
+        size_t offset2 = (hn2[0] == HostNamePool::EMPTY_LABEL) ? 1 : 0;
         
-        if(hn1Chunks.size() == hn2Chunks.size())
+        if(hn1.size() - offset1 == hn2.size() - offset2)
         {
-            unsigned short size = (unsigned short) hn1Chunks.size();
+            unsigned short size = (unsigned short) (hn1.size() - offset1);
             unsigned short similarities = 0;
             
-            list<string>::iterator itBis = hn1Chunks.begin();
-            for(list<string>::iterator it = hn2Chunks.begin(); it != hn2Chunks.end(); ++it)
-            {
-                if((*it).compare((*itBis)) == 0)
-                {
-                    similarities++;
-                    itBis++;
-                }
-                else
-                    break;
-            }
+            while(similarities < size && hn1[offset1 + similarities] == hn2[offset2 + similarities])
+                similarities++;
             
             if(similarities >= (size - 1))
                 return true;
@@ -570,8 +378,8 @@ void AliasResolver::resolve(NetworkTreeNode *internal)
         if((*i)->getNbInterfaces() == 1)
         {
             InetAddress singleInterface = (*i)->getInterfacesList()->front()->ip;
-            list<NetworkTreeNode*> *children = internal->getChildren();
-            for(list<NetworkTreeNode*>::iterator j = children->begin(); j != children->end(); ++j)
+            vector<NetworkTreeNode*> *children = internal->getChildren();
+            for(vector<NetworkTreeNode*>::iterator j = children->begin(); j != children->end(); ++j)
             {
                 if((*j)->isLeaf())
                 {
@@ -581,8 +389,8 @@ void AliasResolver::resolve(NetworkTreeNode *internal)
                        ss->hasLiveInterface(singleInterface))
                     {
                         bool isALabel = false;
-                        list<InetAddress> *labels = internal->getLabels();
-                        for(list<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
+                        vector<InetAddress> *labels = internal->getLabels();
+                        for(vector<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
                         {
                             if((*k) == singleInterface)
                             {
@@ -633,6 +441,12 @@ void AliasResolver::resolve(NetworkTreeNode *internal)
             previousRouter = cur;
         }
     }
+    
+    // Records the alias decisions of this neighborhood in the alias set of the environment
+    AliasSet *aliasSet = env->getAliasSet();
+    IPLookUpTable *table = env->getIPTable();
+    for(list<Router*>::iterator i = results->begin(); i != results->end(); ++i)
+        aliasSet->addRouter(table, (*i));
 }
 
 void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress> interfaces)
@@ -652,8 +466,8 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
         previous = current;
     }
     
-    // Evaluates IP ID counters of each IP and creates a fingerprint list
-    list<Fingerprint> fingerprints;
+    // Gets the entries of each IP
+    vector<IPTableEntry*> entries;
     while(interfaces.size() > 0)
     {
         InetAddress cur = interfaces.front();
@@ -668,9 +482,15 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
             entryCur = newEntry;
         }
         
-        this->evaluateIPIDCounter(entryCur);
-        
-        Fingerprint curPrint(entryCur);
+        entries.push_back(entryCur);
+    }
+    
+    // Evaluates IP ID counters of the whole group and creates a fingerprint list
+    evaluator->evaluate(entries);
+    list<Fingerprint> fingerprints;
+    for(vector<IPTableEntry*>::iterator i = entries.begin(); i != entries.end(); ++i)
+    {
+        Fingerprint curPrint((*i));
         fingerprints.push_back(curPrint);
     }
     fingerprints.sort(Fingerprint::compare);
@@ -791,7 +611,7 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
              * assumed to have not enough host names to perform reverse DNS (due to sorting).
              */
              
-            if(!cur.hostName.empty() && !similar.front().hostName.empty())
+            if(cur.hasHostName && similar.front().hasHostName)
             {
                 Fingerprint ref = cur;
                 list<Fingerprint> toProcess = similar;
@@ -802,7 +622,7 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
                     Fingerprint subCur = toProcess.front();
                     toProcess.pop_front();
                     
-                    if(!subCur.hostName.empty())
+                    if(subCur.hasHostName)
                     {
                         if(this->reverseDNS(ref.ipEntry, subCur.ipEntry))
                             grouped.push_back(subCur);
@@ -829,14 +649,14 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
                             unsigned short aliasMethod = RouterInterface::GROUP_ECHO_DNS;
                             if(head.IPIDCounterType == IPTableEntry::RANDOM_COUNTER)
                             {
-                                if(!head.hostName.empty())
+                                if(head.hasHostName)
                                     aliasMethod = RouterInterface::GROUP_RANDOM_DNS;
                                 else
                                     aliasMethod = RouterInterface::GROUP_RANDOM;
                             }
                             else
                             {
-                                if(!head.hostName.empty())
+                                if(head.hasHostName)
                                     aliasMethod = RouterInterface::GROUP_ECHO_DNS;
                                 else
                                     aliasMethod = RouterInterface::GROUP_ECHO;
@@ -1070,7 +890,7 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
              */
             
             // First takes care of IPs with no data at all
-            if(cur.hostName.empty())
+            if(!cur.hasHostName)
             {
                 similar.push_front(cur);
                 while(similar.size() > 0)
@@ -1089,7 +909,7 @@ void AliasResolver::resolveGroup(NetworkTreeNode *neighborhood, list<InetAddress
                 for(list<Fingerprint>::iterator it = similar.begin(); it != similar.end(); ++it)
                 {
                     Fingerprint subCur = (*it);
-                    if(subCur.hostName.empty())
+                    if(!subCur.hasHostName)
                     {
                         Router *curRouter = new Router();
                         curRouter->addInterface(InetAddress((InetAddress) (*subCur.ipEntry)), 
@@ -19,6 +19,7 @@
 #include "../structure/Router.h"
 #include "../tree/NetworkTreeNode.h"
 #include "Fingerprint.h"
+#include "IPIDCounterEvaluator.h"
 
 class AliasResolver
 {
@@ -61,6 +62,9 @@ private:
     // currentTTL field (identical to AliasHintCollector)
     unsigned char currentTTL;
     
+    // Evaluator of IP ID counters (evaluates a whole group of IPs at once)
+    IPIDCounterEvaluator *evaluator;
+    
     /*
      * Method to perform the UDP unreachable port source IP method for alias resolution, which is 
      * implemented in the "iffinder" tool. As TreeNET sent a UDP probe with an unlikely high port 
@@ -105,15 +109,6 @@ private:
                              list<Fingerprint> group, 
                              unsigned short maxDiff);
     
-    /*
-     * Method to evaluate an IP ID counter, which amounts to computing its velocity and/or 
-     * labelling it with a (unsigned short) class defined in IPTableEntry.h. It returns nothing.
-     *
-     * @param IPTableEntry* ip  The IP for which the IP ID counter needs to be evaluated
-     */
-    
-    void evaluateIPIDCounter(IPTableEntry *ip);
-    
     /*
      * Method to check if the velocity ranges of two distinct IPs (given as IPTableEntry objects) 
      * overlap, if which case both IPs should be associated.
@@ -16,7 +16,7 @@ Fingerprint::Fingerprint(IPTableEntry *ip)
     this->initialTTL = ip->getEchoInitialTTL();
     this->portUnreachableSrcIP = ip->getPortUnreachableSrcIP();
     this->IPIDCounterType = ip->getIPIDCounterType();
-    this->hostName = ip->getHostName();
+    this->hasHostName = ip->hasDNS();
     this->replyingToTSRequest = ip->repliesToTSRequest();
 }
 
@@ -45,12 +45,11 @@ bool Fingerprint::compare(Fingerprint &f1, Fingerprint &f2)
             }
             else if(f1.IPIDCounterType == f2.IPIDCounterType)
             {
-                if(!f1.hostName.empty() && f2.hostName.empty())
+                if(f1.hasHostName && !f2.hasHostName)
                 {
                     return true;
                 }
-                else if((f1.hostName.empty() && f2.hostName.empty()) || 
-                        (!f1.hostName.empty() && !f2.hostName.empty()))
+                else if(f1.hasHostName == f2.hasHostName)
                 {
                     if(!f1.replyingToTSRequest && f2.replyingToTSRequest)
                     {
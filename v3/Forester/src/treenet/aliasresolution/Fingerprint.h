@@ -61,7 +61,7 @@ public:
                 break;
         }
         out << ",";
-        if(!f.hostName.empty())
+        if(f.hasHostName)
             out << "Yes";
         else
             out << "No";
@@ -83,7 +83,7 @@ public:
     unsigned char initialTTL;
     InetAddress portUnreachableSrcIP;
     unsigned short IPIDCounterType;
-    string hostName;
+    bool hasHostName; // The host name itself is interned in ipEntry (see HostNamePool.h)
     bool replyingToTSRequest;
     
     // Comparison method for sorting purposes
@@ -0,0 +1,204 @@
+/*
+ * IPIDCounterEvaluator.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in IPIDCounterEvaluator.h (see this file to learn further about
+ * the goals of such class).
+ */
+
+#include <cmath>
+
+#include "IPIDCounterEvaluator.h"
+
+IPIDCounterEvaluator::IPIDCounterEvaluator(unsigned short nbIPIDs,
+                                           unsigned short maxRollovers,
+                                           double maxError)
+{
+    this->nbIPIDs = nbIPIDs;
+    this->maxRollovers = maxRollovers;
+    this->maxError = maxError;
+}
+
+IPIDCounterEvaluator::~IPIDCounterEvaluator()
+{
+}
+
+void IPIDCounterEvaluator::setVelocityRange(IPTableEntry *ip, size_t k, size_t n)
+{
+    double maxV = velocities[k], minV = velocities[k];
+    for(unsigned short i = 0; i < nbIPIDs - 1; i++)
+    {
+        double v = velocities[i * n + k];
+        if(v > maxV)
+            maxV = v;
+        if(v < minV)
+            minV = v;
+    }
+
+    ip->setVelocityLowerBound(minV);
+    ip->setVelocityUpperBound(maxV);
+}
+
+void IPIDCounterEvaluator::evaluate(vector<IPTableEntry*> &group)
+{
+    // Only IPs with IP-ID data can be evaluated
+    vector<IPTableEntry*> IPs;
+    for(size_t k = 0; k < group.size(); k++)
+    {
+        if(group[k] != NULL && group[k]->hasIPIDData())
+            IPs.push_back(group[k]);
+    }
+
+    size_t n = IPs.size();
+    if(n == 0)
+        return;
+
+    // Fills the columns
+    unsigned short nbDeltas = nbIPIDs - 1;
+    IPIDs.resize(nbIPIDs * n);
+    delays.resize(nbDeltas * n);
+    deltas.resize(nbDeltas * n);
+    velocities.resize(nbDeltas * n);
+    nbEchoes.assign(n, 0);
+    negativeDeltas.assign(n, 0);
+    solved.assign(n, 0);
+    success.assign(n, 0);
+
+    for(size_t k = 0; k < n; k++)
+    {
+        IPTableEntry *ip = IPs[k];
+        for(unsigned short i = 0; i < nbIPIDs; i++)
+        {
+            IPIDs[i * n + k] = (double) ip->getIPIdentifier(i);
+            if(ip->getEcho(i))
+                nbEchoes[k]++;
+        }
+        for(unsigned short i = 0; i < nbDeltas; i++)
+            delays[i * n + k] = (double) ip->getDelay(i);
+    }
+
+    // Deltas between consecutive IP-IDs (wrapped around 65535) and amount of negative deltas
+    for(unsigned short i = 0; i < nbDeltas; i++)
+    {
+        const double *b_i = &IPIDs[i * n];
+        const double *b_i_plus_1 = &IPIDs[(i + 1) * n];
+        double *delta_i = &deltas[i * n];
+        for(size_t k = 0; k < n; k++)
+        {
+            bool increasing = b_i_plus_1[k] > b_i[k];
+            delta_i[k] = increasing ? (b_i_plus_1[k] - b_i[k]) : (b_i_plus_1[k] + (65535 - b_i[k]));
+            negativeDeltas[k] += (b_i[k] > b_i_plus_1[k]) ? 1 : 0;
+        }
+    }
+
+    /*
+     * Echo counters (every IP-ID is an echo) and counters with at most one negative delta, for
+     * which velocity is straightforward, are solved first.
+     */
+
+    for(unsigned short i = 0; i < nbDeltas; i++)
+    {
+        const double *delta_i = &deltas[i * n];
+        const double *d_i = &delays[i * n];
+        double *v_i = &velocities[i * n];
+        for(size_t k = 0; k < n; k++)
+            v_i[k] = delta_i[k] / d_i[k];
+    }
+
+    size_t nbUnsolved = 0;
+    for(size_t k = 0; k < n; k++)
+    {
+        IPTableEntry *ip = IPs[k];
+        if(nbEchoes[k] == nbIPIDs)
+        {
+            ip->setCounterType(IPTableEntry::ECHO_COUNTER);
+            ip->raiseFlagProcessed();
+            solved[k] = 1;
+        }
+        else if(negativeDeltas[k] < 2)
+        {
+            this->setVelocityRange(ip, k, n);
+            ip->setCounterType(IPTableEntry::HEALTHY_COUNTER);
+            ip->raiseFlagProcessed();
+            solved[k] = 1;
+        }
+        else
+            nbUnsolved++;
+    }
+
+    /*
+     * Otherwise, solving equations becomes necessary. Each rollover hypothesis x is tested on
+     * every unsolved IP at once; an IP is solved by the first hypothesis for which each time
+     * interval gets a positive amount of rollovers with a small enough rounding error.
+     */
+
+    const double *b0 = &IPIDs[0];
+    const double *b1 = &IPIDs[n];
+    const double *d0 = &delays[0];
+    double x = 0.0;
+    for(unsigned short h = 0; h < maxRollovers && nbUnsolved > 0; h++)
+    {
+        // Computing speed for x
+        for(size_t k = 0; k < n; k++)
+        {
+            velocities[k] = (deltas[k] + 65535 * x) / d0[k];
+            success[k] = 1;
+        }
+
+        for(unsigned short j = 1; j < nbDeltas; j++)
+        {
+            const double *d_j = &delays[j * n];
+            const double *delta_j = &deltas[j * n];
+            double *v_j = &velocities[j * n];
+            for(size_t k = 0; k < n; k++)
+            {
+                double cur = 0.0;
+                cur += (d_j[k] / d0[k]) * x;
+                cur -= (delta_j[k] / 65535);
+
+                double term = (b1[k] > b0[k]) ? ((d_j[k] * b1[k]) - (d_j[k] * b0[k]))
+                                              : ((d_j[k] * b1[k]) + (d_j[k] * (65535 - b0[k])));
+                cur += term / (65535 * d0[k]);
+
+                // Flooring/ceiling cur
+                double floorCur = floor(cur);
+                double ceilCur = ceil(cur);
+                bool ceiling = (cur - floorCur) > (ceilCur - cur);
+                double selectedCur = ceiling ? ceilCur : floorCur;
+                double gap = ceiling ? (ceilCur - cur) : (cur - floorCur);
+
+                // Storing speed of current time interval
+                v_j[k] = (delta_j[k] + 65535 * selectedCur) / d_j[k];
+                success[k] &= (selectedCur > 0.0 && gap <= maxError) ? 1 : 0;
+            }
+        }
+
+        for(size_t k = 0; k < n; k++)
+        {
+            if(!solved[k] && success[k])
+            {
+                this->setVelocityRange(IPs[k], k, n);
+                IPs[k]->setCounterType(IPTableEntry::HEALTHY_COUNTER);
+                IPs[k]->raiseFlagProcessed();
+                solved[k] = 1;
+                nbUnsolved--;
+            }
+        }
+
+        x += 1.0;
+    }
+
+    // "Infinite" velocity: [0.0, 65535.0]; interpreted as a random counter
+    for(size_t k = 0; k < n && nbUnsolved > 0; k++)
+    {
+        if(!solved[k])
+        {
+            IPs[k]->setVelocityLowerBound(0.0);
+            IPs[k]->setVelocityUpperBound(65535.0);
+            IPs[k]->setCounterType(IPTableEntry::RANDOM_COUNTER);
+            IPs[k]->raiseFlagProcessed();
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * IPIDCounterEvaluator.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * IPIDCounterEvaluator evaluates the IP-ID counters of a whole group of IPs at once, i.e., it
+ * labels each IP with a counter class (see IPTableEntry.h) and computes the velocity range of
+ * the healthy counters. It used to be a method of AliasResolver which handled one IP at a time,
+ * looping over the rollover hypotheses and then over the time intervals with many branches.
+ *
+ * The evaluator rather copies the IP-IDs and delays of the group in contiguous columns (column i
+ * holds the i-th IP-ID, or the i-th delay, of every IP of the group) and runs each step of the
+ * evaluation over a full column, with the branches turned into selections. The inner loops are
+ * therefore simple arithmetic over contiguous arrays of doubles, which the compiler can turn
+ * into SIMD code. The arithmetic expressions are the same as in the former per-IP method, so the
+ * classification and velocity bounds are identical.
+ */
+
+#ifndef IPIDCOUNTEREVALUATOR_H_
+#define IPIDCOUNTEREVALUATOR_H_
+
+#include <vector>
+using std::vector;
+
+#include "../structure/IPTableEntry.h"
+
+class IPIDCounterEvaluator
+{
+public:
+
+    // Constructor, destructor
+    IPIDCounterEvaluator(unsigned short nbIPIDs, unsigned short maxRollovers, double maxError);
+    ~IPIDCounterEvaluator();
+
+    /*
+     * Evaluates the IP-ID counter of every IP of the group that has IP-ID data (the others are
+     * left untouched). Evaluated IPs get their counter class, their velocity range (if relevant)
+     * and their "processed" flag (for alias resolution) set. The same IP can appear several
+     * times in the group.
+     *
+     * @param vector<IPTableEntry*> group  The IPs to evaluate
+     */
+
+    void evaluate(vector<IPTableEntry*> &group);
+
+private:
+
+    // Alias resolution parameters
+    unsigned short nbIPIDs;
+    unsigned short maxRollovers;
+    double maxError;
+
+    /*
+     * Columns (kept between calls to avoid re-allocating them for each group). For n IPs, the
+     * i-th IP-ID of the k-th IP is IPIDs[i * n + k]; same goes for delays, deltas (difference
+     * between two consecutive IP-IDs, wrapped around 65535) and velocities.
+     */
+
+    vector<double> IPIDs, delays, deltas, velocities;
+
+    // Per IP values
+    vector<unsigned short> nbEchoes, negativeDeltas;
+    vector<unsigned char> solved, success;
+
+    // Computes the velocity range of the k-th IP (out of n) from the velocities column
+    void setVelocityRange(IPTableEntry *ip, size_t k, size_t n);
+
+};
+
+#endif /* IPIDCOUNTEREVALUATOR_H_ */
@@ -11,40 +11,29 @@
 #include "IPIDUnit.h"
 #include "../../common/thread/Thread.h"
 
-Mutex IPIDUnit::collectorMutex(Mutex::ERROR_CHECKING_MUTEX);
-
 IPIDUnit::IPIDUnit(TreeNETEnvironment *e, 
                    AliasHintCollector *p, 
-                   InetAddress IP, 
                    unsigned short lbii, 
                    unsigned short ubii, 
                    unsigned short lbis, 
                    unsigned short ubis):
 env(e), 
 parent(p), 
-IPToProbe(IP), 
-resultTuple(IP), 
 log("")
 {
-    // Initial timeout
-    baseTimeout = env->getTimeoutPeriod();
-    
-    // If a higher timeout is suggested for this IP, uses it
-    IPLookUpTable *table = env->getIPTable();
-    IPTableEntry *IPEntry = table->lookUp(IPToProbe);
-    if(IPEntry != NULL)
-    {
-        TimeVal suggestedTimeout = IPEntry->getPreferredTimeout();
-        if(suggestedTimeout > baseTimeout)
-            baseTimeout = suggestedTimeout;
-    }
+    // Initial timeout (each probe then uses the timeout of its target)
+    TimeVal baseTimeout = env->getTimeoutPeriod();
 
     // Instantiates probing objects
     try
     {
         unsigned short protocol = env->getProbingProtocol();
         
-        if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
+        if(env->getSimulatedNetwork() != NULL)
+        {
+            prober = env->newSimulatedProber(baseTimeout, lbii, ubii, lbis, ubis);
+        }
+        else if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
         {
             int roundRobinSocketCount = DirectProber::DEFAULT_TCP_UDP_ROUND_ROBIN_SOCKET_COUNT;
             if(env->usingFixedFlowID())
@@ -87,6 +76,8 @@ log("")
                                           ubis, 
                                           env->debugMode());
         }
+        
+        env->registerProber(prober, ProbeTrace::PHASE_IP_ID);
     }
     catch(SocketException &se)
     {
@@ -143,23 +134,18 @@ ProbeRecord *IPIDUnit::probe(const InetAddress &dst, unsigned char TTL)
     return record;
 }
 
-void IPIDUnit::run()
+bool IPIDUnit::collect(const AliasHintCollector::IPIDProbe &scheduled, IPIDTuple *resultTuple)
 {
-    InetAddress target(this->IPToProbe);
+    InetAddress target(scheduled.IP);
     
     // Tries to get IP ID up to 2 times with increasing timeout
     for(unsigned int nbAttempts = 0; nbAttempts < 2; nbAttempts++)
     {
         // Gets a token
-        collectorMutex.lock();
         unsigned long int token = parent->getProbeToken();
-        collectorMutex.unlock();
         
-        // Adapts timeout
-        TimeVal currentTimeout = prober->getTimeout();
-        TimeVal suggestedTimeout = baseTimeout * (nbAttempts + 1);
-        if(suggestedTimeout > currentTimeout)
-            prober->setTimeout(suggestedTimeout);
+        // Adapts timeout (the prober is shared by all targets of this worker)
+        prober->setTimeout(scheduled.timeout * (nbAttempts + 1));
         
         // Performs the probe; gets and saves results and breaks out of current loop if successful
         ProbeRecord *newProbe = NULL;
@@ -170,32 +156,44 @@ void IPIDUnit::run()
         catch(SocketException &se)
         {
             this->stop();
-            return;
+            return false;
         }
         
         if(newProbe->getRplyICMPtype() == DirectProber::ICMP_TYPE_ECHO_REPLY && newProbe->getRplyAddress() == target)
         {
-            resultTuple.probeToken = token;
-            resultTuple.IPID = newProbe->getRplyIPidentifier();
-            gettimeofday(&(resultTuple.timeValue), NULL);
-            if(newProbe->getSrcIPidentifier() == resultTuple.IPID)
-                resultTuple.echo = true;
-            resultTuple.replyTTL = newProbe->getRplyTTL();
+            resultTuple->probeToken = token;
+            resultTuple->IPID = newProbe->getRplyIPidentifier();
+            TimeVal replyTime = prober->getCurrentTime();
+            resultTuple->timeValue = *(replyTime.getStructure());
+            if(newProbe->getSrcIPidentifier() == resultTuple->IPID)
+                resultTuple->echo = true;
+            resultTuple->replyTTL = newProbe->getRplyTTL();
 
             delete newProbe;
-            break;
+            return true;
         }
         
         delete newProbe;
         
         // Small delay of 0,01s before next probe
-        Thread::invokeSleep(TimeVal(0,10000));
+        prober->waitUntil(prober->getCurrentTime() + TimeVal(0,10000));
     }
+    return false;
 }
 
-bool IPIDUnit::hasExploitableResults()
+void IPIDUnit::run()
 {
-    if(resultTuple.probeToken != 0)
-        return true;
-    return false;
+    AliasHintCollector::IPIDProbe scheduled;
+    while(parent->nextIPIDProbe(&scheduled))
+    {
+        // Waits for the scheduled time of the probe (if late, probes right away)
+        prober->waitUntil(scheduled.time);
+        
+        // Like with the former rounds, an IP which did not reply is not probed anymore
+        IPIDTuple resultTuple(scheduled.IP);
+        if(!env->isStopping() && this->collect(scheduled, &resultTuple))
+            parent->completeIPIDProbe(scheduled, &resultTuple);
+        else
+            parent->completeIPIDProbe(scheduled, NULL);
+    }
 }
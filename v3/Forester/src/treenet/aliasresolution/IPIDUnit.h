@@ -9,6 +9,12 @@
  * calling code with a IPIDTuple object created by it.
  *
  * It was updated in early April 2017 to implement the new IP-ID collection scheduling strategy.
+ *
+ * In October 2026, it was updated again to become a worker of a pool: an IPIDUnit repeatedly 
+ * takes the earliest IP-ID probe scheduled by AliasHintCollector (on a single timeline for all 
+ * the targets of a neighborhood), waits for its scheduled time and sends it, until there is no 
+ * probe left. This bounds the delay between consecutive IP-IDs of a same IP, while the amount of 
+ * threads (and probers) remains capped by the maximum amount of threads.
  */
 
 #ifndef IPIDUNIT_H_
@@ -34,13 +40,9 @@ public:
     // TTL value used in all packets
     static const unsigned char PROBE_TTL = 64;
 
-    // Mutual exclusion object used when taking a probe token
-    static Mutex collectorMutex;
-    
     // Constructor
     IPIDUnit(TreeNETEnvironment *env, 
              AliasHintCollector *parent, 
-             InetAddress IPToProbe, 
              unsigned short lowerBoundICMPid = DirectICMPProber::DEFAULT_LOWER_ICMP_IDENTIFIER,
              unsigned short upperBoundICMPid = DirectICMPProber::DEFAULT_UPPER_ICMP_IDENTIFIER,
              unsigned short lowerBoundICMPseq = DirectICMPProber::DEFAULT_LOWER_ICMP_SEQUENCE,
@@ -50,10 +52,6 @@ public:
     ~IPIDUnit();
     void run();
     
-    // Methods to check results and get a IPIDTuple object after completion of run()
-    bool hasExploitableResults();
-    inline IPIDTuple getTuple() { return resultTuple; }
-    
     // Method to get the debug log of this thread
     inline string getDebugLog() { return this->log; }
     
@@ -64,10 +62,6 @@ private:
     
     // Private fields
     AliasHintCollector *parent;
-    InetAddress IPToProbe;
-    
-    // Resulting tuple
-    IPIDTuple resultTuple;
     
     // Debug log
     string log;
@@ -75,7 +69,9 @@ private:
     // Probing stuff
     DirectProber *prober;
     ProbeRecord *probe(const InetAddress &dst, unsigned char TTL);
-    TimeVal baseTimeout;
+    
+    // Performs a scheduled probe and fills the tuple (returns true if successful)
+    bool collect(const AliasHintCollector::IPIDProbe &scheduled, IPIDTuple *resultTuple);
     
     // Stop method (when loss of network connectivity)
     void stop();
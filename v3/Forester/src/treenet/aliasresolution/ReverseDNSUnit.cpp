@@ -31,10 +31,16 @@ void ReverseDNSUnit::run()
     if(entry == NULL)
         return;
 
-    // Gets host name
-    string hostName = *(target.getHostName());
+    // Gets host name (from the simulated network, if any)
+    string hostName = "";
+    ProbeResponder *simulatedNetwork = env->getSimulatedNetwork();
+    if(simulatedNetwork != NULL)
+        hostName = simulatedNetwork->resolveHostName(target);
+    else
+        hostName = *(target.getHostName());
     if(!hostName.empty())
     {
         entry->setHostName(hostName);
+        env->traceHostName(target, hostName);
     }
 }
@@ -37,7 +37,7 @@ private:
     
     // Private fields
     TreeNETEnvironment *env;
-    InetAddress &IPToProbe;
+    InetAddress IPToProbe; // Copy, as the caller reuses its variable for the next unit
 
 };
 
@@ -36,16 +36,27 @@ IPToProbe(IP)
     // Instantiates ICMP probing object (necessarily ICMP)
     try
     {
-        prober = new DirectICMPProber(env->getAttentionMessage(), 
-                                      baseTimeout, 
-                                      env->getProbeRegulatingPeriod(), 
-                                      lbii, 
-                                      ubii, 
-                                      lbis, 
-                                      ubis, 
-                                      env->debugMode());
+        if(env->getSimulatedNetwork() != NULL)
+        {
+            SimulatedProber *simulated = env->newSimulatedProber(baseTimeout, lbii, ubii, lbis, ubis);
+            simulated->useTimestampRequests();
+            prober = simulated;
+        }
+        else
+        {
+            prober = new DirectICMPProber(env->getAttentionMessage(), 
+                                          baseTimeout, 
+                                          env->getProbeRegulatingPeriod(), 
+                                          lbii, 
+                                          ubii, 
+                                          lbis, 
+                                          ubis, 
+                                          env->debugMode());
+            
+            ((DirectICMPProber*) prober)->useTimestampRequests();
+        }
         
-        ((DirectICMPProber*) prober)->useTimestampRequests();
+        env->registerProber(prober, ProbeTrace::PHASE_TIMESTAMP);
     }
     catch(SocketException &se)
     {
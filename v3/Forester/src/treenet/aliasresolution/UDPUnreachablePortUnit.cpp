@@ -36,21 +36,40 @@ IPToProbe(IP)
     // Instantiates UDP probing object
     try
     {
-        int roundRobinSocketCount = DirectProber::DEFAULT_TCP_UDP_ROUND_ROBIN_SOCKET_COUNT;
-        if(env->usingFixedFlowID())
-            roundRobinSocketCount = 1;
-        
-        prober = new DirectUDPWrappedICMPProber(env->getAttentionMessage(), 
-                                                roundRobinSocketCount, 
-                                                baseTimeout, 
-                                                env->getProbeRegulatingPeriod(), 
-                                                lbii, 
-                                                ubii, 
-                                                lbis, 
-                                                ubis, 
-                                                env->debugMode());
+        // Always UDP, including in a simulated network
+        if(env->getSimulatedNetwork() != NULL)
+        {
+            prober = new SimulatedProber(env->getSimulatedNetwork(), 
+                                         env->getAttentionMessage(), 
+                                         DirectProber::UDP_PROTOCOL, 
+                                         baseTimeout, 
+                                         env->getProbeRegulatingPeriod(), 
+                                         lbii, 
+                                         ubii, 
+                                         lbis, 
+                                         ubis, 
+                                         env->debugMode());
+        }
+        else
+        {
+            int roundRobinSocketCount = DirectProber::DEFAULT_TCP_UDP_ROUND_ROBIN_SOCKET_COUNT;
+            if(env->usingFixedFlowID())
+                roundRobinSocketCount = 1;
+            
+            prober = new DirectUDPWrappedICMPProber(env->getAttentionMessage(), 
+                                                    roundRobinSocketCount, 
+                                                    baseTimeout, 
+                                                    env->getProbeRegulatingPeriod(), 
+                                                    lbii, 
+                                                    ubii, 
+                                                    lbis, 
+                                                    ubis, 
+                                                    env->debugMode());
+            
+            ((DirectUDPWrappedICMPProber*) prober)->useHighPortNumber();
+        }
         
-        ((DirectUDPWrappedICMPProber*) prober)->useHighPortNumber();
+        env->registerProber(prober, ProbeTrace::PHASE_UDP_UNREACHABLE_PORT);
     }
     catch(SocketException &se)
     {
@@ -0,0 +1,211 @@
+/*
+ * AliasSet.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in AliasSet.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include "AliasSet.h"
+
+AliasSet::AliasSet()
+{
+    this->clear();
+}
+
+AliasSet::~AliasSet()
+{
+    // Entries belong to the IP dictionnary, which might already be deleted at this point
+}
+
+void AliasSet::clear()
+{
+    for(size_t i = 1; i < entries.size(); i++)
+        entries[i]->setAliasSlot(0);
+
+    entries.assign(1, (IPTableEntry*) NULL);
+    parents.assign(1, 0);
+    ranks.assign(1, 0);
+    methods.assign(1, RouterInterface::NOT_ALIASED);
+    sizes.assign(1, 0);
+    next.assign(1, 0);
+    decisions.clear();
+    nbSets = 0;
+}
+
+unsigned int AliasSet::find(unsigned int slot)
+{
+    unsigned int root = slot;
+    while(parents[root] != root)
+        root = parents[root];
+
+    // Path compression
+    while(parents[slot] != root)
+    {
+        unsigned int parent = parents[slot];
+        parents[slot] = root;
+        slot = parent;
+    }
+
+    return root;
+}
+
+unsigned int AliasSet::findRoot(unsigned int slot)
+{
+    while(parents[slot] != slot)
+        slot = parents[slot];
+    return slot;
+}
+
+unsigned int AliasSet::add(IPTableEntry *ip, unsigned short aliasMethod)
+{
+    unsigned int slot = ip->getAliasSlot();
+    if(slot == 0)
+    {
+        slot = (unsigned int) entries.size();
+        entries.push_back(ip);
+        parents.push_back(slot);
+        ranks.push_back(0);
+        methods.push_back(aliasMethod);
+        sizes.push_back(1);
+        next.push_back(slot);
+        ip->setAliasSlot(slot);
+        nbSets++;
+    }
+    else if(methods[slot] == RouterInterface::NOT_ALIASED ||
+            methods[slot] == RouterInterface::FIRST_IP)
+    {
+        if(aliasMethod != RouterInterface::NOT_ALIASED)
+            methods[slot] = aliasMethod;
+    }
+    return slot;
+}
+
+void AliasSet::unite(IPTableEntry *ip1, IPTableEntry *ip2, unsigned short aliasMethod)
+{
+    unsigned int slot1 = this->add(ip1, RouterInterface::FIRST_IP);
+    unsigned int slot2 = this->add(ip2, aliasMethod);
+
+    AliasDecision decision;
+    decision.slot1 = slot1;
+    decision.slot2 = slot2;
+    decision.aliasMethod = aliasMethod;
+    decisions.push_back(decision);
+
+    unsigned int root1 = this->find(slot1);
+    unsigned int root2 = this->find(slot2);
+    if(root1 == root2)
+        return;
+
+    // Union by rank
+    if(ranks[root1] < ranks[root2])
+    {
+        unsigned int tmp = root1;
+        root1 = root2;
+        root2 = tmp;
+    }
+    else if(ranks[root1] == ranks[root2])
+    {
+        ranks[root1]++;
+    }
+    parents[root2] = root1;
+    sizes[root1] += sizes[root2];
+    nbSets--;
+    
+    // Splices both circular lists of members together
+    unsigned int tmpNext = next[root1];
+    next[root1] = next[root2];
+    next[root2] = tmpNext;
+}
+
+void AliasSet::addRouter(IPLookUpTable *table, Router *router)
+{
+    list<RouterInterface*> *interfaces = router->getInterfacesList();
+    IPTableEntry *first = NULL;
+    for(list<RouterInterface*>::iterator i = interfaces->begin(); i != interfaces->end(); ++i)
+    {
+        IPTableEntry *entry = table->lookUp((*i)->ip);
+        if(entry == NULL)
+            continue;
+
+        if(first == NULL)
+        {
+            first = entry;
+            this->add(first, (*i)->aliasMethod);
+        }
+        else
+        {
+            this->unite(first, entry, (*i)->aliasMethod);
+        }
+    }
+}
+
+bool AliasSet::areAliases(IPTableEntry *ip1, IPTableEntry *ip2)
+{
+    unsigned int slot1 = ip1->getAliasSlot(), slot2 = ip2->getAliasSlot();
+    if(slot1 == 0 || slot2 == 0)
+        return false;
+    return this->find(slot1) == this->find(slot2);
+}
+
+unsigned int AliasSet::getRouterSize(IPTableEntry *ip)
+{
+    unsigned int slot = ip->getAliasSlot();
+    if(slot == 0)
+        return 0;
+
+    return sizes[this->findRoot(slot)];
+}
+
+unsigned int AliasSet::getRouterID(IPTableEntry *ip)
+{
+    unsigned int slot = ip->getAliasSlot();
+    if(slot == 0)
+        return 0;
+
+    return this->findRoot(slot);
+}
+
+list<InetAddress> AliasSet::listAliases(IPTableEntry *ip)
+{
+    list<InetAddress> result;
+    unsigned int slot = ip->getAliasSlot();
+    if(slot == 0)
+        return result;
+
+    unsigned int cur = slot;
+    do
+    {
+        result.push_back((InetAddress) (*entries[cur]));
+        cur = next[cur];
+    }
+    while(cur != slot);
+    result.sort(InetAddress::smaller);
+    return result;
+}
+
+list<Router*> AliasSet::getRouters()
+{
+    list<Router*> result;
+    vector<Router*> routerOf(entries.size(), (Router*) NULL);
+    for(size_t i = 1; i < entries.size(); i++)
+    {
+        unsigned int root = this->find((unsigned int) i);
+        if(routerOf[root] == NULL)
+        {
+            routerOf[root] = new Router();
+            result.push_back(routerOf[root]);
+        }
+
+        // Interfaces are sorted once the router is complete rather than at each insertion
+        RouterInterface *interface = new RouterInterface((InetAddress) (*entries[i]), methods[i]);
+        routerOf[root]->getInterfacesList()->push_back(interface);
+    }
+
+    for(list<Router*>::iterator i = result.begin(); i != result.end(); ++i)
+        (*i)->getInterfacesList()->sort(RouterInterface::smaller);
+    result.sort(Router::compare);
+    return result;
+}
@@ -0,0 +1,121 @@
+/*
+ * AliasSet.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * AliasSet is a disjoint-set (or "union-find") structure over the entries of the IP dictionnary
+ * which records every alias decision taken during alias resolution, whatever the neighborhood
+ * (or last hop group in a hedera) it was taken in. Indeed, routers are inferred one group of
+ * interfaces at a time, such that the same interface can end up in several Router objects (e.g.,
+ * in two last hop groups of a hedera). By uniting the interfaces of each inferred router in a
+ * single structure, AliasSet provides the transitive closure of all these decisions, i.e., the
+ * merged routers, in near-linear time (path compression + union by rank).
+ *
+ * Each registered IPTableEntry receives a slot (see IPTableEntry::getAliasSlot()), slot 0 meaning
+ * the IP was never registered. Slots are assigned in order of registration, which makes the
+ * structure a set of flat arrays rather than a map.
+ */
+
+#ifndef ALIASSET_H_
+#define ALIASSET_H_
+
+#include <vector>
+using std::vector;
+#include <list>
+using std::list;
+
+#include "IPLookUpTable.h"
+#include "Router.h"
+
+class AliasSet
+{
+public:
+
+    // Constructor, destructor
+    AliasSet();
+    ~AliasSet();
+
+    // Registers an IP (if not done yet) with the method that associated it to its router
+    unsigned int add(IPTableEntry *ip, unsigned short aliasMethod);
+
+    // Records the decision of aliasing two IPs (registers them if needed) with a given method
+    void unite(IPTableEntry *ip1, IPTableEntry *ip2, unsigned short aliasMethod);
+
+    /*
+     * Records all interfaces of a router inferred by AliasResolver: the first interface is
+     * registered alone, and every other interface is united with it with its own alias method.
+     * The IP dictionnary is needed to get the entry of each interface (interfaces without entry
+     * are ignored).
+     */
+
+    void addRouter(IPLookUpTable *table, Router *router);
+
+    // Checks two IPs belong to the same router, given all recorded decisions
+    bool areAliases(IPTableEntry *ip1, IPTableEntry *ip2);
+
+    /*
+     * Gets the amount of interfaces of the router of a given IP (0 if not registered). It does 
+     * not compress paths, such that it can be called concurrently (e.g., by Cat) as long as no 
+     * decision is being recorded.
+     */
+
+    unsigned int getRouterSize(IPTableEntry *ip);
+    
+    /*
+     * Gets an ID of the router of a given IP (0 if not registered), i.e., two IPs get the same ID 
+     * if and only if they are aliases. Like getRouterSize(), it can be called concurrently.
+     */
+    
+    unsigned int getRouterID(IPTableEntry *ip);
+
+    // Lists (sorted) the interfaces of the router of a given IP (empty if not registered)
+    list<InetAddress> listAliases(IPTableEntry *ip);
+
+    /*
+     * Builds the merged routers (one per disjoint set), sorted with Router::compare(). Each
+     * interface keeps the first method (other than FIRST_IP) it was aliased with. The calling
+     * code is responsible for deleting the routers.
+     */
+
+    list<Router*> getRouters();
+
+    // Accessers to amounts
+    inline unsigned int getNbInterfaces() { return (unsigned int) entries.size() - 1; }
+    inline unsigned int getNbDecisions() { return (unsigned int) decisions.size(); }
+    inline unsigned int getNbRouters() { return this->nbSets; }
+
+    // Forgets everything (e.g., when the IP dictionnary itself is reset)
+    void clear();
+
+private:
+
+    // Recorded alias decision
+    struct AliasDecision
+    {
+        unsigned int slot1, slot2;
+        unsigned short aliasMethod;
+    };
+
+    // Per slot data (slot 0 is a placeholder)
+    vector<IPTableEntry*> entries;
+    vector<unsigned int> parents;
+    vector<unsigned char> ranks;
+    vector<unsigned short> methods;
+    vector<unsigned int> sizes; // Only meaningful for representatives
+    vector<unsigned int> next; // Circular list of the members of each set (for listing them)
+
+    // All decisions, in the order they were taken
+    vector<AliasDecision> decisions;
+
+    unsigned int nbSets;
+
+    // Finds the representative of a slot (with path compression)
+    unsigned int find(unsigned int slot);
+
+    // Finds the representative of a slot without modifying the structure
+    unsigned int findRoot(unsigned int slot);
+
+};
+
+#endif /* ALIASSET_H_ */
@@ -0,0 +1,84 @@
+/*
+ * HostNamePool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in HostNamePool.h (see this file to learn further about the goals
+ * of such class).
+ */
+
+#include "HostNamePool.h"
+
+map<string, unsigned int> HostNamePool::IDs;
+vector<string> HostNamePool::labels(1, string(""));
+Mutex HostNamePool::poolMutex(Mutex::ERROR_CHECKING_MUTEX);
+
+vector<unsigned int> HostNamePool::intern(const string &hostName)
+{
+    vector<unsigned int> result;
+    if(hostName.empty())
+        return result;
+
+    // Labels are read right to left, so the result directly starts with the top-level domain
+    poolMutex.lock();
+    size_t end = hostName.size();
+    while(true)
+    {
+        size_t dot = string::npos;
+        if(end > 0)
+            dot = hostName.rfind('.', end - 1);
+        size_t start = (dot == string::npos) ? 0 : dot + 1;
+
+        unsigned int ID = EMPTY_LABEL;
+        if(end > start)
+        {
+            string label = hostName.substr(start, end - start);
+            map<string, unsigned int>::iterator it = IDs.find(label);
+            if(it != IDs.end())
+            {
+                ID = it->second;
+            }
+            else
+            {
+                ID = (unsigned int) labels.size();
+                labels.push_back(label);
+                IDs.insert(std::pair<string, unsigned int>(label, ID));
+            }
+        }
+        result.push_back(ID);
+
+        if(dot == string::npos)
+            break;
+        end = dot;
+    }
+    poolMutex.unlock();
+
+    return result;
+}
+
+string HostNamePool::toString(const vector<unsigned int> &labelIDs)
+{
+    string result = "";
+    if(labelIDs.size() == 0)
+        return result;
+
+    poolMutex.lock();
+    for(size_t i = labelIDs.size(); i > 0; i--)
+    {
+        result += labels[labelIDs[i - 1]];
+        if(i > 1)
+            result += ".";
+    }
+    poolMutex.unlock();
+
+    return result;
+}
+
+unsigned int HostNamePool::getNbLabels()
+{
+    poolMutex.lock();
+    unsigned int nbLabels = (unsigned int) labels.size() - 1;
+    poolMutex.unlock();
+    return nbLabels;
+}
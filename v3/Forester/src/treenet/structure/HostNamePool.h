@@ -0,0 +1,60 @@
+/*
+ * HostNamePool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * HostNamePool is a global dictionnary of the labels (i.e., the chunks between dots) found in the
+ * host names obtained through reverse DNS. Each distinct label is stored once and receives an
+ * integer ID, such that a host name can be stored as a vector of IDs in IPTableEntry rather than
+ * as a plain string. The vector is reversed (top-level domain first), since this is the order in
+ * which AliasResolver compares host names: the comparison then amounts to comparing two integer
+ * arrays, and the (many) duplicated domain suffixes of a dataset are only stored once.
+ *
+ * ID 0 is reserved for the empty label, which can appear with malformed host names or with a
+ * trailing dot. Keeping it in the interned form makes the conversion back to a string lossless.
+ *
+ * As host names are interned by ReverseDNSUnit threads, interning is protected by a mutex.
+ */
+
+#ifndef HOSTNAMEPOOL_H_
+#define HOSTNAMEPOOL_H_
+
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include <map>
+using std::map;
+
+#include "../../common/thread/Mutex.h"
+
+class HostNamePool
+{
+public:
+
+    // ID of the empty label
+    static const unsigned int EMPTY_LABEL = 0;
+
+    /*
+     * Interns a host name and returns its labels as IDs, last label (top-level domain) first.
+     * An empty host name gives an empty vector.
+     */
+
+    static vector<unsigned int> intern(const string &hostName);
+
+    // Rebuilds the host name from its interned form
+    static string toString(const vector<unsigned int> &labels);
+
+    // Amount of distinct labels currently stored (the empty label is not counted)
+    static unsigned int getNbLabels();
+
+private:
+
+    static map<string, unsigned int> IDs;
+    static vector<string> labels;
+    static Mutex poolMutex;
+
+};
+
+#endif /* HOSTNAMEPOOL_H_ */
@@ -8,7 +8,6 @@
  * of such class).
  */
  
-#include <fstream>
 #include <sys/stat.h> // For CHMOD edition
 #include <iomanip>
 
@@ -93,25 +92,18 @@ IPTableEntry *IPLookUpTable::lookUp(InetAddress needle)
 
 void IPLookUpTable::outputDictionnary(string filename)
 {
-    string output = "";
+    OutputBuffer output(filename);
     
     for(unsigned long i = 0; i < SIZE_TABLE; i++)
     {
-        list<IPTableEntry*> IPList = this->haystack[i];
-        for(list<IPTableEntry*>::iterator j = IPList.begin(); j != IPList.end(); ++j)
+        list<IPTableEntry*> *IPList = &(this->haystack[i]);
+        for(list<IPTableEntry*>::iterator j = IPList->begin(); j != IPList->end(); ++j)
         {
-            IPTableEntry *cur = (*j);
-            string curStr = cur->toString();
-            
-            if(!curStr.empty())
-                output += curStr + "\n";
+            (*j)->writeTo(&output);
+            output << "\n";
         }
     }
-    
-    ofstream newFile;
-    newFile.open(filename.c_str());
-    newFile << output;
-    newFile.close();
+    output.close();
     
     // File must be accessible to all
     string path = "./" + filename;
@@ -120,59 +112,92 @@ void IPLookUpTable::outputDictionnary(string filename)
 
 void IPLookUpTable::outputFingerprints(string filename)
 {
-    string output = "";
+    OutputBuffer output(filename);
     
     for(unsigned long i = 0; i < SIZE_TABLE; i++)
     {
-        list<IPTableEntry*> IPList = this->haystack[i];
-        for(list<IPTableEntry*>::iterator j = IPList.begin(); j != IPList.end(); ++j)
+        list<IPTableEntry*> *IPList = &(this->haystack[i]);
+        for(list<IPTableEntry*>::iterator j = IPList->begin(); j != IPList->end(); ++j)
         {
             IPTableEntry *cur = (*j);
             if(cur->isProcessedForAR())
             {
-                string curStr = cur->toStringFingerprint();
-                
-                if(!curStr.empty())
-                    output += curStr + "\n";
+                cur->writeFingerprintTo(&output);
+                output << "\n";
             }
         }
     }
+    output.close();
     
-    ofstream newFile;
-    newFile.open(filename.c_str());
-    newFile << output;
-    newFile.close();
+    // File must be accessible to all
+    string path = "./" + filename;
+    chmod(path.c_str(), 0766);
+}
+
+void IPLookUpTable::outputFreshness(string filename)
+{
+    OutputBuffer output(filename);
+    
+    for(unsigned long i = 0; i < SIZE_TABLE; i++)
+    {
+        list<IPTableEntry*> *IPList = &(this->haystack[i]);
+        for(list<IPTableEntry*>::iterator j = IPList->begin(); j != IPList->end(); ++j)
+        {
+            IPTableEntry *cur = (*j);
+            if(cur->hasHintCollectionTimes())
+            {
+                cur->writeFreshnessTo(&output);
+                output << "\n";
+            }
+        }
+    }
+    output.close();
     
     // File must be accessible to all
     string path = "./" + filename;
     chmod(path.c_str(), 0766);
 }
 
-void IPLookUpTable::clearAliasHints()
+unsigned int IPLookUpTable::clearAliasHints(unsigned long now, const unsigned long *maxAges, bool keepIPIDs)
 {
+    unsigned int keptHints = 0;
     for(unsigned long i = 0; i < SIZE_TABLE; i++)
     {
         list<IPTableEntry*> IPList = this->haystack[i];
         for(list<IPTableEntry*>::iterator j = IPList.begin(); j != IPList.end(); ++j)
         {
             IPTableEntry *cur = (*j);
-            
-            cur->resetFlagProcessed();
-            cur->setHostName("");
-            for(unsigned short j = 0; j < nbIPIDs; j++)
+            for(unsigned short k = 0; k < IPTableEntry::NB_HINT_TYPES; k++)
             {
-                cur->setProbeToken(j, 0);
-                cur->setIPIdentifier(j, 0);
-                cur->resetEcho(j);
-                if(j < nbIPIDs - 1)
-                    cur->setDelay(j, 0);
+                if(keepIPIDs && k == IPTableEntry::HINT_IP_IDS)
+                    continue;
+                
+                if(cur->isHintFresh(k, now, maxAges[k]))
+                    keptHints++;
+                else
+                    cur->clearAliasHints(k);
             }
-            cur->setCounterType(IPTableEntry::NO_IDEA);
-            cur->setVelocityUpperBound(0.0);
-            cur->setVelocityLowerBound(0.0);
-            cur->setEchoInitialTTL(0);
-            cur->resetReplyingToTSRequest();
-            cur->setPortUnreachableSrcIP(InetAddress(0));
         }
     }
+    return keptHints;
+}
+
+unsigned int IPLookUpTable::clearAliasHints(list<InetAddress> IPs, unsigned long now, const unsigned long *maxAges)
+{
+    unsigned int keptHints = 0;
+    for(list<InetAddress>::iterator i = IPs.begin(); i != IPs.end(); ++i)
+    {
+        IPTableEntry *cur = this->lookUp((*i));
+        if(cur == NULL)
+            continue;
+        
+        for(unsigned short k = 0; k < IPTableEntry::NB_HINT_TYPES; k++)
+        {
+            if(cur->isHintFresh(k, now, maxAges[k]))
+                keptHints++;
+            else
+                cur->clearAliasHints(k);
+        }
+    }
+    return keptHints;
 }
@@ -56,9 +56,20 @@ public:
     // Output methods
     void outputDictionnary(string filename);
     void outputFingerprints(string filename);
+    void outputFreshness(string filename);
     
-    // Method to clear alias hints upon re-computing alias resolution hints.
-    void clearAliasHints();
+    /*
+     * Method to clear alias hints upon re-computing alias resolution hints. Hints of a given type 
+     * which were collected at most maxAges[type] seconds before "now" are kept (see 
+     * IPTableEntry::AliasHintTypes), such that they do not need to be collected again. It returns 
+     * the amount of kept hints. IP IDs can be kept regardless of their age (keepIPIDs), e.g. if 
+     * they are cleared later neighborhood by neighborhood (see Cuckoo).
+     */
+    
+    unsigned int clearAliasHints(unsigned long now, const unsigned long *maxAges, bool keepIPIDs = false);
+    
+    // Same method, but restricted to a list of IPs (e.g., the interfaces of a neighborhood)
+    unsigned int clearAliasHints(list<InetAddress> IPs, unsigned long now, const unsigned long *maxAges);
 
 private:
     list<IPTableEntry*> *haystack;
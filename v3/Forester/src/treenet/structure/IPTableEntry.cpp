@@ -15,7 +15,6 @@ IPTableEntry::IPTableEntry(InetAddress ip, unsigned short nbIPIDs) : InetAddress
     // Default values
     this->TTL = NO_KNOWN_TTL;
     this->preferredTimeout = TimeVal(DEFAULT_TIMEOUT_SECONDS, TimeVal::HALF_A_SECOND);
-    this->hostName = "";
     
     if(nbIPIDs > MIN_ALIAS_RESOLUTION_PAIRS)
         this->nbIPIDs = nbIPIDs;
@@ -41,6 +40,9 @@ IPTableEntry::IPTableEntry(InetAddress ip, unsigned short nbIPIDs) : InetAddress
     this->echoInitialTTL = 0;
     this->replyingToTSRequest = false;
     this->portUnreachableSrcIP = InetAddress(0);
+    for(unsigned short i = 0; i < NB_HINT_TYPES; i++)
+        this->hintCollectionTimes[i] = 0;
+    this->aliasSlot = 0;
 }
 
 IPTableEntry::~IPTableEntry()
@@ -121,41 +123,99 @@ bool IPTableEntry::safeIPIDData()
 
 bool IPTableEntry::hasDNS()
 {
-    if(!hostName.empty())
+    if(hostName.size() > 0)
         return true;
     return false;
 }
 
+bool IPTableEntry::hasHintCollectionTimes()
+{
+    for(unsigned short i = 0; i < NB_HINT_TYPES; i++)
+    {
+        if(this->hintCollectionTimes[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+bool IPTableEntry::isHintFresh(unsigned short type, unsigned long now, unsigned long maxAge)
+{
+    unsigned long collectionTime = this->hintCollectionTimes[type];
+    if(maxAge == 0 || collectionTime == 0 || collectionTime > now)
+        return false;
+    return (now - collectionTime) <= maxAge;
+}
+
+void IPTableEntry::clearAliasHints(unsigned short type)
+{
+    switch(type)
+    {
+        // Data inferred from the IP IDs is cleared along them
+        case HINT_IP_IDS:
+            this->processedForAR = false;
+            for(unsigned short i = 0; i < nbIPIDs; i++)
+            {
+                this->probeTokens[i] = 0;
+                this->IPIdentifiers[i] = 0;
+                this->echoMask[i] = false;
+                if(i < nbIPIDs - 1)
+                    this->delays[i] = 0;
+            }
+            this->IPIDCounterType = NO_IDEA;
+            this->velocityUpperBound = 0.0;
+            this->velocityLowerBound = 0.0;
+            this->echoInitialTTL = 0;
+            break;
+        case HINT_PORT_UNREACHABLE:
+            this->portUnreachableSrcIP = InetAddress(0);
+            break;
+        case HINT_TIMESTAMP_REPLY:
+            this->replyingToTSRequest = false;
+            break;
+        case HINT_REVERSE_DNS:
+            this->hostName.clear();
+            break;
+        default:
+            return;
+    }
+    this->hintCollectionTimes[type] = 0;
+}
+
 string IPTableEntry::toString()
 {
-    stringstream ss;
-    
+    OutputBuffer buffer;
+    this->writeTo(&buffer);
+    return buffer.str();
+}
+
+void IPTableEntry::writeTo(OutputBuffer *out)
+{
     // IP - TTL
-    ss << (*this) << " - " << (unsigned short) TTL;
+    (*out) << (*this) << " - " << (unsigned short) TTL;
     
     // : [Initial echo TTL] - ECHO
     if(this->IPIDCounterType == ECHO_COUNTER)
     {
-        ss << ": ";
+        (*out) << ": ";
         
         unsigned short iTTL = (unsigned short) this->echoInitialTTL;
         if(iTTL > 0)
-            ss << iTTL << " - ";
+            (*out) << iTTL << " - ";
         
-        ss << "ECHO";
+        (*out) << "ECHO";
         
         // ,[Host name]
-        if(!hostName.empty())
-            ss << "," << hostName;
+        if(hostName.size() > 0)
+            (*out) << "," << HostNamePool::toString(hostName);
     }
     // : [Initial echo TTL] - [IP-ID data]
     else if(this->hasIPIDData())
     {
-        ss << ": ";
+        (*out) << ": ";
         
         unsigned short iTTL = (unsigned short) this->echoInitialTTL;
         if(iTTL > 0)
-            ss << iTTL << " - ";
+            (*out) << iTTL << " - ";
         
         bool first = true;
         for(unsigned short i = 0; i < nbIPIDs; i++)
@@ -163,83 +223,102 @@ string IPTableEntry::toString()
             if(first)
                 first = false;
             else
-                ss << "," << this->delays[i - 1] << ",";
-            ss << this->probeTokens[i] << ";" << this->IPIdentifiers[i];
+                (*out) << "," << this->delays[i - 1] << ",";
+            (*out) << this->probeTokens[i] << ";" << this->IPIdentifiers[i];
         }
         
         // ,[Host name]
-        if(!hostName.empty())
-            ss << "," << hostName;
+        if(hostName.size() > 0)
+            (*out) << "," << HostNamePool::toString(hostName);
     }
     // : [Host name]
-    else if(!hostName.empty())
+    else if(hostName.size() > 0)
     {
-        ss << ": " << hostName;
+        (*out) << ": " << HostNamePool::toString(hostName);
     }
     
     // ... | [Yes or nothing] (yes ~= replies to ICMP timestamp request)
     if(this->replyingToTSRequest)
     {
-        ss << " | Yes";
+        (*out) << " | Yes";
         
         // ,[Unreachable port reply IP]
         if(this->portUnreachableSrcIP != InetAddress("0"))
-            ss << "," << this->portUnreachableSrcIP;
+            (*out) << "," << this->portUnreachableSrcIP;
     }
     // ... | [Unreachable port reply IP] (if available)
     else if(this->portUnreachableSrcIP != InetAddress("0"))
-        ss << " | " << this->portUnreachableSrcIP;
-    
-    return ss.str();
+        (*out) << " | " << this->portUnreachableSrcIP;
 }
 
 string IPTableEntry::toStringFingerprint()
 {
-    stringstream ss;
-    
+    OutputBuffer buffer;
+    this->writeFingerprintTo(&buffer);
+    return buffer.str();
+}
+
+void IPTableEntry::writeFingerprintTo(OutputBuffer *out)
+{
     /*
      * N.B.: here, the Fingerprint class is pretty much useless, as all the data we need is 
      * normally already in this class; except if it has not been processed yet. But this method is 
      * usually not called before processing the data.
      */
     
-    ss << (*this) << " - <";
+    (*out) << (*this) << " - <";
     if(this->echoInitialTTL > 0)
-        ss << (unsigned short) this->echoInitialTTL;
+        (*out) << (unsigned short) this->echoInitialTTL;
     else
-        ss << "*";
-    ss << ",";
+        (*out) << "*";
+    (*out) << ",";
     if(this->portUnreachableSrcIP != InetAddress(0))
-        ss << this->portUnreachableSrcIP;
+        (*out) << this->portUnreachableSrcIP;
     else
-        ss << "*";
-    ss << ",";
+        (*out) << "*";
+    (*out) << ",";
     switch(this->IPIDCounterType)
     {
         case HEALTHY_COUNTER:
-            ss << "Healthy";
+            (*out) << "Healthy";
             break;
         case RANDOM_COUNTER:
-            ss << "Random";
+            (*out) << "Random";
             break;
         case ECHO_COUNTER:
-            ss << "Echo";
+            (*out) << "Echo";
             break;
         default:
-            ss << "*";
+            (*out) << "*";
             break;
     }
-    ss << ",";
-    if(!this->hostName.empty())
-        ss << "Yes";
+    (*out) << ",";
+    if(this->hostName.size() > 0)
+        (*out) << "Yes";
     else
-        ss << "No";
-    ss << ",";
+        (*out) << "No";
+    (*out) << ",";
     if(this->replyingToTSRequest)
-        ss << "Yes";
+        (*out) << "Yes";
     else
-        ss << "No";
-    ss << ">";
+        (*out) << "No";
+    (*out) << ">";
+}
 
-    return ss.str();
+string IPTableEntry::toStringFreshness()
+{
+    OutputBuffer buffer;
+    this->writeFreshnessTo(&buffer);
+    return buffer.str();
+}
+
+void IPTableEntry::writeFreshnessTo(OutputBuffer *out)
+{
+    (*out) << (*this) << " - ";
+    for(unsigned short i = 0; i < NB_HINT_TYPES; i++)
+    {
+        if(i > 0)
+            (*out) << ",";
+        (*out) << this->hintCollectionTimes[i];
+    }
 }
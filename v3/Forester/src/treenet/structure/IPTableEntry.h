@@ -19,9 +19,13 @@
 using std::string;
 #include <list>
 using std::list;
+#include <vector>
+using std::vector;
 
 #include "../../common/date/TimeVal.h"
 #include "../../common/inet/InetAddress.h"
+#include "HostNamePool.h"
+#include "../utils/OutputBuffer.h"
 
 class IPTableEntry : public InetAddress
 {
@@ -43,6 +47,22 @@ public:
         ECHO_COUNTER // Echoes the IP ID that was in the initial probe
     };
     
+    /*
+     * Types of alias resolution hints, as collected by the successive steps of 
+     * AliasHintCollector. The time at which each type was collected is recorded, such that hints 
+     * which cannot meaningfully change within a few hours can be kept when alias resolution 
+     * hints are collected again (see TreeNETEnvironment::isHintFresh()).
+     */
+    
+    enum AliasHintTypes
+    {
+        HINT_IP_IDS, // Tokens, IP IDs, echo flags, delays and initial TTL of ECHO replies
+        HINT_PORT_UNREACHABLE, // Source IP of the ICMP Port Unreachable reply
+        HINT_TIMESTAMP_REPLY, // Compliance to ICMP timestamp request
+        HINT_REVERSE_DNS, // Host name
+        NB_HINT_TYPES
+    };
+    
     // Constructor, destructor
     IPTableEntry(InetAddress ip, unsigned short nbIPIDs);
     ~IPTableEntry();
@@ -84,7 +104,8 @@ public:
 	inline unsigned short getIPIdentifier(unsigned short index) { return this->IPIdentifiers[index]; }
 	inline bool getEcho(unsigned short index) { return this->echoMask[index]; }
 	inline unsigned long getDelay(unsigned short index) { return this->delays[index]; }
-	inline string getHostName() { return this->hostName; }
+	inline string getHostName() { return HostNamePool::toString(this->hostName); }
+	inline const vector<unsigned int> &getHostNameLabels() { return this->hostName; }
 	inline double getVelocityLowerBound() { return this->velocityLowerBound; }
 	inline double getVelocityUpperBound() { return this->velocityUpperBound; }
 	inline unsigned short getIPIDCounterType() { return this->IPIDCounterType; }
@@ -98,7 +119,7 @@ public:
 	inline void setEcho(unsigned short index) { this->echoMask[index] = true; }
 	inline void resetEcho(unsigned short index) { this->echoMask[index] = false; }
 	inline void setDelay(unsigned short index, unsigned long d) { this->delays[index] = d; }
-	inline void setHostName(string hn) { this->hostName = hn; }
+	inline void setHostName(string hn) { this->hostName = HostNamePool::intern(hn); }
 	inline void setVelocityLowerBound(double vlb) { this->velocityLowerBound = vlb; }
 	inline void setVelocityUpperBound(double vub) { this->velocityUpperBound = vub; }
 	inline void setCounterType(unsigned short cType) { this->IPIDCounterType = cType; }
@@ -107,9 +128,28 @@ public:
 	inline void resetReplyingToTSRequest() { this->replyingToTSRequest = false; }
 	inline void setPortUnreachableSrcIP(InetAddress srcIP) { this->portUnreachableSrcIP = srcIP; }
 	
+	// Slot of this IP in the alias set of the environment (0 if not registered; see AliasSet.h)
+	inline unsigned int getAliasSlot() { return this->aliasSlot; }
+	inline void setAliasSlot(unsigned int slot) { this->aliasSlot = slot; }
+	
+	// Collection times (in seconds since epoch; 0 if never collected) of each type of hint
+	inline unsigned long getHintCollectionTime(unsigned short type) { return this->hintCollectionTimes[type]; }
+	inline void setHintCollectionTime(unsigned short type, unsigned long t) { this->hintCollectionTimes[type] = t; }
+	bool hasHintCollectionTimes();
+	bool isHintFresh(unsigned short type, unsigned long now, unsigned long maxAge);
+	
+	// Method to reset one type of hints (and its collection time); see AliasHintTypes
+	void clearAliasHints(unsigned short type);
+	
 	// toString() methods (for outputting an entry in a dump file, either plain or fingerprint)
     string toString();
     string toStringFingerprint();
+    string toStringFreshness();
+    
+    // Same as the toString() methods, but writing in a buffer
+    void writeTo(OutputBuffer *out);
+    void writeFingerprintTo(OutputBuffer *out);
+    void writeFreshnessTo(OutputBuffer *out);
 
 private:
     unsigned char TTL;
@@ -122,9 +162,11 @@ private:
 	unsigned short *IPIdentifiers;
 	bool *echoMask;
 	unsigned long *delays;
-	string hostName;
+	vector<unsigned int> hostName; // Interned (see HostNamePool.h)
 	bool replyingToTSRequest;
 	InetAddress portUnreachableSrcIP;
+	unsigned long hintCollectionTimes[NB_HINT_TYPES];
+	unsigned int aliasSlot;
 	
 	/*
 	 * About echo mask: it records "true" for the corresponding index when the IP ID is the same 
@@ -0,0 +1,110 @@
+/*
+ * RouteStore.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in RouteStore.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include "RouteStore.h"
+
+RouteStore::RouteStore():
+storeMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    root.previous = NULL;
+    root.firstNext = NULL;
+    root.nextSibling = NULL;
+    root.length = 0;
+    root.references = 0;
+    nbHops = 0;
+}
+
+RouteStore::~RouteStore()
+{
+    deleteHops(&root);
+}
+
+void RouteStore::deleteHops(Hop *hop)
+{
+    Hop *next = hop->firstNext;
+    while(next != NULL)
+    {
+        Hop *sibling = next->nextSibling;
+        deleteHops(next);
+        delete next;
+        next = sibling;
+    }
+    hop->firstNext = NULL;
+}
+
+RouteStore::Hop *RouteStore::intern(RouteInterface *route, unsigned short size)
+{
+    if(route == NULL || size == 0)
+        return NULL;
+
+    storeMutex.lock();
+    Hop *cur = &root;
+    for(unsigned short i = 0; i < size; i++)
+    {
+        Hop *next = cur->firstNext;
+        while(next != NULL)
+        {
+            if(next->interface.ip == route[i].ip && next->interface.state == route[i].state)
+                break;
+            next = next->nextSibling;
+        }
+
+        if(next == NULL)
+        {
+            next = new Hop();
+            next->interface = route[i];
+            next->previous = (cur != &root) ? cur : NULL;
+            next->firstNext = NULL;
+            next->nextSibling = cur->firstNext;
+            next->length = i + 1;
+            next->references = 0;
+            cur->firstNext = next;
+            cur->references++;
+            nbHops++;
+        }
+        cur = next;
+    }
+    cur->references++;
+    storeMutex.unlock();
+    return cur;
+}
+
+void RouteStore::release(Hop *last)
+{
+    if(last == NULL)
+        return;
+
+    storeMutex.lock();
+    Hop *cur = last;
+    cur->references--;
+    while(cur != NULL && cur->references == 0)
+    {
+        // Unlinks the hop from the hops following the previous one (or the root)
+        Hop *previous = cur->previous;
+        Hop *parent = (previous != NULL) ? previous : &root;
+        if(parent->firstNext == cur)
+        {
+            parent->firstNext = cur->nextSibling;
+        }
+        else
+        {
+            Hop *sibling = parent->firstNext;
+            while(sibling->nextSibling != cur)
+                sibling = sibling->nextSibling;
+            sibling->nextSibling = cur->nextSibling;
+        }
+        delete cur;
+        nbHops--;
+
+        parent->references--;
+        cur = previous;
+    }
+    storeMutex.unlock();
+}
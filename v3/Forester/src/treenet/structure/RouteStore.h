@@ -0,0 +1,74 @@
+/*
+ * RouteStore.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * RouteStore interns the routes of subnets in a single tree of hops, such that subnets whose
+ * routes share a prefix (typically the first 10 to 20 hops of a dataset) also share the hops of
+ * that prefix, rather than each subnet owning a full RouteInterface array. Routes are one of the
+ * largest memory consumers of big (e.g., merged) datasets.
+ *
+ * Each hop of the tree is a RouteInterface (IP and state) with a pointer to the previous hop,
+ * such that a route is entirely identified by its last hop: a subnet only keeps a pointer to it
+ * and reads its route through a RouteView. The hops following a given hop are kept as a list of
+ * siblings, which is only used to find an existing hop while interning (there are few of them,
+ * so a per-hop map would cost more than it saves). Interning a route is linear in its length.
+ *
+ * Each hop counts the routes ending on it and the hops following it. Releasing a route deletes
+ * the hops which are no longer referenced, such that a subnet getting back a private copy of its
+ * route (see SubnetSite::unshareRoutes()) does not leave a copy in the store.
+ *
+ * Interned hops are never edited, as other subnets are pointing to them. Several datasets can be
+ * parsed at the same time (see Grafter) and routes are released by concurrent threads during
+ * probing, hence interning and releasing are protected by a mutex. Reading a route does not
+ * require it, since a hop cannot be deleted while a route ending on it is still referenced.
+ */
+
+#ifndef ROUTESTORE_H_
+#define ROUTESTORE_H_
+
+#include "RouteInterface.h"
+#include "../../common/thread/Mutex.h"
+
+class RouteStore
+{
+public:
+
+    // Hop of an interned route
+    struct Hop
+    {
+        RouteInterface interface; // IP and state of this hop
+        Hop *previous; // NULL for the first hop of a route
+        Hop *firstNext, *nextSibling; // Hops following this one (as a list of siblings)
+        unsigned short length; // Length of the route ending on this hop
+        unsigned int references; // Routes ending on this hop and hops following it
+    };
+
+    // Constructor, destructor (the latter deletes all hops)
+    RouteStore();
+    ~RouteStore();
+
+    /*
+     * Interns a given route and returns its last hop, on which the calling code holds a
+     * reference until it calls release(). The given array remains owned by the calling code.
+     */
+
+    Hop *intern(RouteInterface *route, unsigned short size);
+    void release(Hop *last);
+
+    // Amount of hops currently in the store
+    inline unsigned int getNbHops() { return this->nbHops; }
+
+private:
+
+    Hop root; // Not a hop of any route (length 0)
+    unsigned int nbHops;
+    Mutex storeMutex;
+
+    // Deletes the hops following a given hop (recursive)
+    static void deleteHops(Hop *hop);
+
+};
+
+#endif /* ROUTESTORE_H_ */
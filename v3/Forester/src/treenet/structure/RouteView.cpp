@@ -0,0 +1,47 @@
+/*
+ * RouteView.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in RouteView.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include "RouteView.h"
+
+RouteView::RouteView()
+{
+    this->array = NULL;
+    this->last = NULL;
+    this->length = 0;
+}
+
+RouteView::RouteView(RouteInterface *route, unsigned short size)
+{
+    this->array = route;
+    this->last = NULL;
+    this->length = (route != NULL) ? size : 0;
+}
+
+RouteView::RouteView(RouteStore::Hop *last)
+{
+    this->array = NULL;
+    this->last = last;
+    this->length = (last != NULL) ? last->length : 0;
+    for(RouteStore::Hop *cur = last; cur != NULL; cur = cur->previous)
+        if(cur->length <= MAX_CACHED_HOPS)
+            this->cache[cur->length - 1] = &(cur->interface);
+}
+
+RouteView::~RouteView()
+{
+}
+
+const RouteInterface &RouteView::walk(unsigned short i) const
+{
+    RouteStore::Hop *cur = this->last;
+    while(cur->length > i + 1)
+        cur = cur->previous;
+    return cur->interface;
+}
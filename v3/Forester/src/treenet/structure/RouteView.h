@@ -0,0 +1,63 @@
+/*
+ * RouteView.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * RouteView gives a read-only, array-like access to the route of a subnet, whether this route is
+ * a private RouteInterface array or a route interned in a RouteStore (i.e., its last hop). For
+ * the latter, the first hops are listed once when the view is created (walking the pointers to
+ * the previous hops), such that reading a hop is as cheap as with an array; hops beyond
+ * MAX_CACHED_HOPS (very long routes) are found by walking back from the last hop.
+ *
+ * A view is a temporary object: it must not outlive the route it shows, i.e., it should not be
+ * kept after the route of the subnet is replaced, unshared or released.
+ */
+
+#ifndef ROUTEVIEW_H_
+#define ROUTEVIEW_H_
+
+#include <cstddef>
+
+#include "RouteInterface.h"
+#include "RouteStore.h"
+
+class RouteView
+{
+public:
+
+    // Amount of hops of an interned route which are listed when the view is created
+    static const unsigned short MAX_CACHED_HOPS = 32;
+
+    // Constructors for an empty route, a private array and an interned route, destructor
+    RouteView();
+    RouteView(RouteInterface *route, unsigned short size);
+    RouteView(RouteStore::Hop *last);
+    ~RouteView();
+
+    inline unsigned short size() const { return this->length; }
+    inline bool isEmpty() const { return this->length == 0; }
+
+    // Access to the i-th hop (i must be lower than size())
+    inline const RouteInterface &operator[](unsigned short i) const
+    {
+        if(this->array != NULL)
+            return this->array[i];
+        if(i < MAX_CACHED_HOPS)
+            return *(this->cache[i]);
+        return this->walk(i);
+    }
+
+private:
+
+    RouteInterface *array;
+    RouteStore::Hop *last;
+    unsigned short length;
+    const RouteInterface *cache[MAX_CACHED_HOPS];
+
+    // Finds the i-th hop of an interned route from its last hop
+    const RouteInterface &walk(unsigned short i) const;
+
+};
+
+#endif /* ROUTEVIEW_H_ */
@@ -68,17 +68,22 @@ IPTableEntry* Router::getMergingPivot(IPLookUpTable *table)
 
 string Router::toString()
 {
-    stringstream result;
+    OutputBuffer buffer;
+    this->writeTo(&buffer);
+    return buffer.str();
+}
+
+void Router::writeTo(OutputBuffer *out)
+{
     bool first = true;
     for(list<RouterInterface*>::iterator it = interfaces.begin(); it != interfaces.end(); ++it)
     {
         if(first)
             first = false;
         else
-            result << " ";
-        result << (*it)->ip;
+            (*out) << " ";
+        (*out) << (*it)->ip;
     }
-    return result.str();
 }
 
 string Router::toStringVerbose()
@@ -17,6 +17,7 @@ using std::list;
 #include "../../common/inet/InetAddress.h"
 #include "./IPLookUpTable.h"
 #include "./RouterInterface.h"
+#include "../utils/OutputBuffer.h"
 
 class Router
 {
@@ -50,8 +51,9 @@ public:
     
     IPTableEntry *getMergingPivot(IPLookUpTable *table);
     
-    // Converts the Router object to an alias in string format
+    // Converts the Router object to an alias in string format (or writes it in a buffer)
     string toString();
+    void writeTo(OutputBuffer *out);
     
     // Similar method, but with more aliasing details (i.e. with which method an IP was aliased)
     string toStringVerbose();
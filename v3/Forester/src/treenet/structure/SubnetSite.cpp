@@ -23,7 +23,10 @@ routeTarget(0),
 routeSize(0), 
 processedRouteSize(0), 
 route(NULL), 
-processedRoute(NULL)
+processedRoute(NULL), 
+routeHop(NULL), 
+processedRouteHop(NULL), 
+routeStore(NULL)
 {
 
 }
@@ -35,6 +38,11 @@ SubnetSite::~SubnetSite()
         delete[] route;
     if(processedRoute != NULL)
         delete[] processedRoute;
+    if(routeStore != NULL)
+    {
+        routeStore->release(routeHop);
+        routeStore->release(processedRouteHop);
+    }
 }
 
 void SubnetSite::clearIPlist()
@@ -211,9 +219,10 @@ bool SubnetSite::hasLiveInterface(InetAddress li)
 
 bool SubnetSite::hasRouteLabel(InetAddress rl, unsigned short TTL)
 {
-    if(TTL > this->routeSize)
+    if(TTL == 0 || TTL > this->routeSize)
         return false;
     
+    RouteView route = this->getRouteView();
     if(route[TTL - 1].ip == rl)
         return true;
     return false;
@@ -319,16 +328,18 @@ list<InetAddress> SubnetSite::getContrapivotAddresses()
 
 bool SubnetSite::hasCompleteRoute()
 {
-    for(unsigned short i = 0; i < this->routeSize; ++i)
-        if(this->route[i].ip == InetAddress(0))
+    RouteView route = this->getRouteView();
+    for(unsigned short i = 0; i < route.size(); ++i)
+        if(route[i].ip == InetAddress(0))
             return false;
     return true;
 }
 
 bool SubnetSite::hasIncompleteRoute()
 {
-    for(unsigned short i = 0; i < this->routeSize; ++i)
-        if(this->route[i].ip == InetAddress(0))
+    RouteView route = this->getRouteView();
+    for(unsigned short i = 0; i < route.size(); ++i)
+        if(route[i].ip == InetAddress(0))
             return true;
     return false;
 }
@@ -336,44 +347,86 @@ bool SubnetSite::hasIncompleteRoute()
 unsigned short SubnetSite::countMissingHops()
 {
     unsigned short res = 0;
-    for(unsigned short i = 0; i < this->routeSize; ++i)
-        if(this->route[i].ip == InetAddress(0))
+    RouteView route = this->getRouteView();
+    for(unsigned short i = 0; i < route.size(); ++i)
+        if(route[i].ip == InetAddress(0))
             res++;
     return res;
 }
 
-RouteInterface* SubnetSite::getFinalRoute(unsigned short *finalRouteSize)
+RouteView SubnetSite::getFinalRoute(unsigned short *finalRouteSize)
 {
-    if(processedRouteSize > 0 && processedRoute != NULL)
+    RouteView processed = this->getProcessedRouteView();
+    if(processedRouteSize > 0 && !processed.isEmpty())
     {
         (*finalRouteSize) = processedRouteSize;
-        return processedRoute;
+        return processed;
     }
-    if(routeSize > 0 && route != NULL)
+    RouteView observed = this->getRouteView();
+    if(routeSize > 0 && !observed.isEmpty())
     {
         (*finalRouteSize) = routeSize;
-        return route;
+        return observed;
     }
     (*finalRouteSize) = 0;
-    return NULL;
+    return RouteView();
+}
+
+void SubnetSite::setRoute(RouteInterface *route)
+{
+    if(this->routeHop != NULL)
+    {
+        this->routeStore->release(this->routeHop);
+        this->routeHop = NULL;
+    }
+    this->route = route;
+}
+
+RouteInterface *SubnetSite::getRoute()
+{
+    if(this->routeHop != NULL)
+        this->unshareRoutes();
+    return this->route;
+}
+
+void SubnetSite::setProcessedRoute(RouteInterface *pRoute)
+{
+    if(this->processedRouteHop != NULL)
+    {
+        this->routeStore->release(this->processedRouteHop);
+        this->processedRouteHop = NULL;
+    }
+    this->processedRoute = pRoute;
+}
+
+RouteInterface *SubnetSite::getProcessedRoute()
+{
+    if(this->processedRouteHop != NULL)
+        this->unshareRoutes();
+    return this->processedRoute;
 }
 
 string SubnetSite::toString()
 {
-    stringstream ss;
+    OutputBuffer buffer;
+    this->writeTo(&buffer);
+    return buffer.str();
+}
 
+bool SubnetSite::writeTo(OutputBuffer *out)
+{
     if((this->status == SubnetSite::ACCURATE_SUBNET ||
         this->status == SubnetSite::SHADOW_SUBNET ||
         this->status == SubnetSite::ODD_SUBNET) && 
-        this->route != 0)
+        this->hasValidRoute())
     {
-        ss << this->getInferredNetworkAddressString() << "\n";
+        (*out) << this->getInferredNetworkAddressString() << "\n";
         if(this->status == SubnetSite::ACCURATE_SUBNET)
-            ss << "ACCURATE\n";
+            (*out) << "ACCURATE\n";
         else if(this->status == SubnetSite::SHADOW_SUBNET)
-            ss << "SHADOW\n";
+            (*out) << "SHADOW\n";
         else
-            ss << "ODD\n";
+            (*out) << "ODD\n";
         
         // Writes live interfaces
         IPlist.sort(SubnetSiteNode::smaller); // Sorts the interfaces
@@ -390,83 +443,86 @@ string SubnetSite::toString()
                 continue;
 
             if(guardian)
-                ss << ", ";
+                (*out) << ", ";
             else
                 guardian = true;
         
-            ss << (*i)->ip << " - " << (unsigned short) (*i)->TTL;
+            (*out) << (*i)->ip << " - " << (unsigned short) (*i)->TTL;
 
             previous = (*i)->ip;
         }
-        ss << "\n";
+        (*out) << "\n";
         
         // Writes (observed) route
-        if(this->routeSize > 0 && this->route != NULL)
+        RouteView route = this->getRouteView();
+        if(this->routeSize > 0 && !route.isEmpty())
         {
             guardian = false;
             for(unsigned int i = 0; i < this->routeSize; i++)
             {
                 if(guardian)
-                    ss << ", ";
+                    (*out) << ", ";
                 else
                     guardian = true;
                 
-                unsigned short curState = this->route[i].state;
-                if(this->route[i].ip != InetAddress(0))
+                unsigned short curState = route[i].state;
+                if(route[i].ip != InetAddress(0))
                 {
-                    ss << this->route[i].ip;
+                    (*out) << route[i].ip;
                     if(curState == RouteInterface::REPAIRED_1)
-                        ss << " [Repaired-1]";
+                        (*out) << " [Repaired-1]";
                     else if(curState == RouteInterface::REPAIRED_2)
-                        ss << " [Repaired-2]";
+                        (*out) << " [Repaired-2]";
                     else if(curState == RouteInterface::LIMITED)
-                        ss << " [Limited]";
+                        (*out) << " [Limited]";
                     else if(curState == RouteInterface::STRETCHED)
-                        ss << " [Stretched]";
+                        (*out) << " [Stretched]";
                     else if(curState == RouteInterface::CYCLE)
-                        ss << " [Cycle]";
+                        (*out) << " [Cycle]";
                     else if(curState == RouteInterface::PREDICTED)
-                        ss << " [Predicted]";
+                        (*out) << " [Predicted]";
                 }
                 else
                 {
                     if(curState == RouteInterface::ANONYMOUS)
-                        ss << "Anonymous";
+                        (*out) << "Anonymous";
                     else if(curState == RouteInterface::MISSING)
-                        ss << "Missing";
+                        (*out) << "Missing";
                     else
-                        ss << "Skipped";
+                        (*out) << "Skipped";
                 }
             }
-            ss << "\n";
+            (*out) << "\n";
         }
         else
         {
-            ss << "No route\n";
+            (*out) << "No route\n";
         }
         
         // Writes post-processed route if existing (otherwise, regular display)
-        if(processedRouteSize > 0 && processedRoute != NULL)
+        RouteView processedRoute = this->getProcessedRouteView();
+        if(processedRouteSize > 0 && !processedRoute.isEmpty())
         {
             guardian = false;
-            ss << "Post-processed: ";
+            (*out) << "Post-processed: ";
             for(unsigned int i = 0; i < processedRouteSize; i++)
             {
                 if(guardian)
-                    ss << ", ";
+                    (*out) << ", ";
                 else
                     guardian = true;
                 
                 if(processedRoute[i].ip != InetAddress(0))
-                    ss << processedRoute[i].ip;
+                    (*out) << processedRoute[i].ip;
                 else
-                    ss << "Anonymous";
+                    (*out) << "Anonymous";
             }
-            ss << "\n";
+            (*out) << "\n";
         }
+        return true;
     }
     
-    return ss.str();
+    return false;
 }
 
 bool SubnetSite::isCredible()
@@ -541,10 +597,65 @@ unsigned int SubnetSite::getCapacity()
     return (unsigned int) pow(2, power);
 }
 
+void SubnetSite::shareRoutes(RouteStore *store)
+{
+    // Routes interned in another store (e.g., of another dataset) are moved to this one
+    if(this->routeStore != NULL && this->routeStore != store)
+        this->unshareRoutes();
+    this->routeStore = store;
+    
+    if(this->route != NULL)
+    {
+        RouteStore::Hop *last = store->intern(this->route, this->routeSize);
+        if(last != NULL)
+        {
+            delete[] this->route;
+            this->route = NULL;
+            this->routeHop = last;
+        }
+    }
+    
+    if(this->processedRoute != NULL)
+    {
+        RouteStore::Hop *last = store->intern(this->processedRoute, this->processedRouteSize);
+        if(last != NULL)
+        {
+            delete[] this->processedRoute;
+            this->processedRoute = NULL;
+            this->processedRouteHop = last;
+        }
+    }
+}
+
+void SubnetSite::unshareRoutes()
+{
+    if(this->routeHop != NULL)
+    {
+        RouteView interned(this->routeHop);
+        RouteInterface *copy = new RouteInterface[interned.size()];
+        for(unsigned short i = 0; i < interned.size(); i++)
+            copy[i] = interned[i];
+        this->routeStore->release(this->routeHop);
+        this->routeHop = NULL;
+        this->route = copy;
+    }
+    
+    if(this->processedRouteHop != NULL)
+    {
+        RouteView interned(this->processedRouteHop);
+        RouteInterface *copy = new RouteInterface[interned.size()];
+        for(unsigned short i = 0; i < interned.size(); i++)
+            copy[i] = interned[i];
+        this->routeStore->release(this->processedRouteHop);
+        this->processedRouteHop = NULL;
+        this->processedRoute = copy;
+    }
+}
+
 bool SubnetSite::matchRoutePrefix(unsigned short sPrefix, InetAddress *prefix)
 {
     unsigned short fRouteSize;
-    RouteInterface *fRoute = this->getFinalRoute(&fRouteSize);
+    RouteView fRoute = this->getFinalRoute(&fRouteSize);
 
     // Equality rejected as well (at least one interface must remain untouched)
     if(sPrefix >= fRouteSize)
@@ -564,7 +675,7 @@ void SubnetSite::adaptRoute(unsigned short offset,
                             InetAddress *newPrefix)
 {
     unsigned short fRouteSize;
-    RouteInterface *fRoute = this->getFinalRoute(&fRouteSize);
+    RouteView fRoute = this->getFinalRoute(&fRouteSize);
 
     // First lists interfaces beyond offset (included)
     list<InetAddress> lastInterfaces;
@@ -619,12 +730,14 @@ void SubnetSite::adaptRoute(unsigned short offset,
     }
     
     // Updates the main route details and delete the previous one
-    delete[] this->route;
-    this->route = newRoute;
+    if(this->route != NULL)
+        delete[] this->route;
+    this->setRoute(newRoute);
     this->routeSize = newRouteSize;
     
     // Post-processed route is also nullified
-    delete[] this->processedRoute;
-    this->processedRoute = NULL;
+    if(this->processedRoute != NULL)
+        delete[] this->processedRoute;
+    this->setProcessedRoute(NULL);
     this->processedRouteSize = 0;
 }
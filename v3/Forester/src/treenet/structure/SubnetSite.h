@@ -21,6 +21,9 @@ using std::string;
 
 #include "SubnetSiteNode.h"
 #include "RouteInterface.h"
+#include "RouteStore.h"
+#include "RouteView.h"
+#include "../utils/OutputBuffer.h"
 #include "../../common/inet/NetworkAddress.h"
 
 class SubnetSite
@@ -104,27 +107,43 @@ public:
     // Methods for route manipulation (merged with v3.0)
     inline void setRouteTarget(InetAddress rt) { this->routeTarget = rt; }
     inline void setRouteSize(unsigned short rs) { this->routeSize = rs; }
-    inline void setRoute(RouteInterface *route) { this->route = route; }
+    void setRoute(RouteInterface *route);
     inline InetAddress getRouteTarget() { return this->routeTarget; }
     inline unsigned short getRouteSize() { return this->routeSize; }
-    inline RouteInterface *getRoute() { return this->route; }
-    inline bool hasValidRoute() { return this->routeSize > 0 && this->route != NULL; }
+    RouteInterface *getRoute(); // Private copy (see unshareRoutes())
+    inline RouteView getRouteView() { return this->routeHop != NULL ? RouteView(this->routeHop) : RouteView(this->route, this->routeSize); }
+    inline bool hasValidRoute() { return this->routeSize > 0 && (this->route != NULL || this->routeHop != NULL); }
     bool hasCompleteRoute(); // Returns true if the route has no missing/anonymous hop
     bool hasIncompleteRoute(); // Dual operation (true if the route has missing/anonymous hop)
     unsigned short countMissingHops(); // Returns amount of missing/anonymous hops
     
     // Additionnal and optional post-processed route than can be set in TreeNET v3.2
     inline void setProcessedRouteSize(unsigned short prs) { this->processedRouteSize = prs; }
-    inline void setProcessedRoute(RouteInterface *pRoute) { this->processedRoute = pRoute; }
+    void setProcessedRoute(RouteInterface *pRoute);
     inline unsigned short getProcessedRouteSize() { return this->processedRouteSize; }
-    inline RouteInterface *getProcessedRoute() { return this->processedRoute; }
+    RouteInterface *getProcessedRoute(); // Private copy (see unshareRoutes())
+    inline RouteView getProcessedRouteView() { return this->processedRouteHop != NULL ? RouteView(this->processedRouteHop) : RouteView(this->processedRoute, this->processedRouteSize); }
     
-    // Method to get the final route (priority: processed then observed, NULL if nothing)
-    RouteInterface *getFinalRoute(unsigned short *finalRouteSize);
+    // Method to get the final route (priority: processed then observed, empty if nothing)
+    RouteView getFinalRoute(unsigned short *finalRouteSize);
+    
+    /*
+     * Methods to intern the routes (observed and processed) in a route store, and to get back 
+     * private copies of them (releasing them in the store), respectively. Interned routes can 
+     * only be read through a RouteView; getRoute() and getProcessedRoute() give arrays which can 
+     * be edited in place, hence they get back a private copy first if needed. Routes set with 
+     * setRoute() or setProcessedRoute() are always private (the previous ones being released).
+     */
+    
+    void shareRoutes(RouteStore *store);
+    void unshareRoutes();
     
     // toString() method, only available for refined (odd/accurate) subnets, null otherwise 
     string toString();
     
+    // Same as toString(), but writes in a buffer (returns false if nothing was written)
+    bool writeTo(OutputBuffer *out);
+    
     /*
      * Special method to evaluate the credibility of the subnet. Indeed, for several reasons,
      * like redirections or asymetric paths in load balancers, an ACCURATE or ODD subnet might 
@@ -158,7 +177,9 @@ private:
     unsigned short TTL1, TTL2; // Shortest and greatest TTL for this subnet
     InetAddress routeTarget; // To keep track of the target IP used during traceroute
     unsigned short routeSize, processedRouteSize;
-    RouteInterface *route, *processedRoute;
+    RouteInterface *route, *processedRoute; // Private arrays (NULL if interned)
+    RouteStore::Hop *routeHop, *processedRouteHop; // Last hops of interned routes (if any)
+    RouteStore *routeStore; // Store of the interned routes
     
 };
 
@@ -8,7 +8,6 @@
  * goals of such class).
  */
 
-#include <fstream>
 #include <sys/stat.h> // For CHMOD edition
 #include "SubnetSiteSet.h"
 #include "../../common/inet/NetworkAddress.h"
@@ -493,20 +492,13 @@ SubnetSite *SubnetSiteSet::getValidSubnet(bool completeRoute)
 
 void SubnetSiteSet::outputAsFile(string filename)
 {
-    string output = "";
+    OutputBuffer output(filename);
     for(list<SubnetSite*>::iterator i = siteList.begin(); i != siteList.end(); ++i)
     {
-        SubnetSite *ss = (*i);
-        string cur = ss->toString();
-        
-        if(!cur.empty())
-            output += cur + "\n";
+        if((*i)->writeTo(&output))
+            output << "\n";
     }
-    
-    ofstream newFile;
-    newFile.open(filename.c_str());
-    newFile << output;
-    newFile.close();
+    output.close();
     
     // File must be accessible to all
     string path = "./" + filename;
@@ -21,23 +21,17 @@ NetworkTree::~NetworkTree()
     delete root;
 }
 
-string NetworkTree::writeSubnets()
+void NetworkTree::writeSubnets(OutputBuffer *out)
 {
-    string output = "";
     list<SubnetSite*> siteList;
     listSubnetsRecursive(&siteList, root);
     siteList.sort(SubnetSite::compare);
     
     for(list<SubnetSite*>::iterator i = siteList.begin(); i != siteList.end(); ++i)
     {
-        SubnetSite *ss = (*i);
-        string cur = ss->toString();
-        
-        if(!cur.empty())
-            output += cur + "\n";
+        if((*i)->writeTo(out))
+            (*out) << "\n";
     }
-    
-    return output;
 }
 
 void NetworkTree::listSubnetsRecursive(list<SubnetSite*> *subnetsList, NetworkTreeNode *cur)
@@ -50,8 +44,8 @@ void NetworkTree::listSubnetsRecursive(list<SubnetSite*> *subnetsList, NetworkTr
     }
     
     // Goes deeper in the tree
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         listSubnetsRecursive(subnetsList, (*i));
     }
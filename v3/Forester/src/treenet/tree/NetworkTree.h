@@ -46,8 +46,8 @@ public:
     // Accesser to the root node
     inline NetworkTreeNode *getRoot() { return this->root; }
 
-    // Method to write the subnets/leaves in a string object (later written in a file in Soil).
-    string writeSubnets();
+    // Method to write the subnets/leaves in a buffer (i.e., a file being written by Soil).
+    void writeSubnets(OutputBuffer *out);
     
 private:
 
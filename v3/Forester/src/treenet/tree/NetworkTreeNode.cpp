@@ -8,6 +8,12 @@
  * goals of such class).
  */
 
+#include <algorithm>
+using std::lower_bound;
+using std::upper_bound;
+using std::binary_search;
+using std::stable_sort;
+
 #include "NetworkTreeNode.h"
 
 NetworkTreeNode::NetworkTreeNode()
@@ -16,6 +22,7 @@ NetworkTreeNode::NetworkTreeNode()
     this->type = NetworkTreeNode::T_ROOT;
     this->associatedSubnet = NULL;
     this->parent = NULL;
+    this->dirty = false;
 }
 
 NetworkTreeNode::NetworkTreeNode(InetAddress label)
@@ -24,6 +31,7 @@ NetworkTreeNode::NetworkTreeNode(InetAddress label)
     this->type = NetworkTreeNode::T_NEIGHBORHOOD;
     this->associatedSubnet = NULL;
     this->parent = NULL;
+    this->dirty = false;
 }
 
 NetworkTreeNode::NetworkTreeNode(SubnetSite *subnet) throw (InvalidSubnetException)
@@ -43,6 +51,7 @@ NetworkTreeNode::NetworkTreeNode(SubnetSite *subnet) throw (InvalidSubnetExcepti
     this->type = NetworkTreeNode::T_SUBNET;
     this->associatedSubnet = subnet;
     this->parent = NULL;
+    this->dirty = false;
 }
 
 NetworkTreeNode::~NetworkTreeNode()
@@ -54,7 +63,7 @@ NetworkTreeNode::~NetworkTreeNode()
     }
     else
     {
-        for(list<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
+        for(vector<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
         {
             delete (*i);
         }
@@ -98,32 +107,22 @@ bool NetworkTreeNode::isHedera()
 
 bool NetworkTreeNode::hasLabel(InetAddress label)
 {
-    for(list<InetAddress>::iterator i = labels.begin(); i != labels.end(); ++i)
-    {
-        if((*i) == label)
-            return true;
-    }
-    return false;
+    return binary_search(labels.begin(), labels.end(), label);
 }
 
 bool NetworkTreeNode::hasPreviousLabel(InetAddress label)
 {
-    for(list<InetAddress>::iterator i = previousLabels.begin(); i != previousLabels.end(); ++i)
-    {
-        if((*i) == label)
-            return true;
-    }
-    return false;
+    return binary_search(previousLabels.begin(), previousLabels.end(), label);
 }
 
 void NetworkTreeNode::addLabel(InetAddress label)
 {
     InetAddress previousHead = labels.front();
 
-    labels.push_back(label);
+    // Labels are kept sorted: the new label is inserted after the labels it is not smaller than
+    labels.insert(upper_bound(labels.begin(), labels.end(), label), label);
     if(labels.size() > 1 && this->type == NetworkTreeNode::T_NEIGHBORHOOD)
         this->type = NetworkTreeNode::T_HEDERA;
-    labels.sort(InetAddress::smaller);
     
     /*
      * If the head of the list changed, one must re-sort the list of children of the parent node 
@@ -139,19 +138,17 @@ void NetworkTreeNode::addLabel(InetAddress label)
 
 void NetworkTreeNode::addPreviousLabel(InetAddress label)
 {
-    for(list<InetAddress>::iterator i = previousLabels.begin(); i != previousLabels.end(); ++i)
-    {
-        if((*i) == label)
-            return;
-    }
-    previousLabels.push_back(label);
-    previousLabels.sort(InetAddress::smaller);
+    // Previous labels are sorted, so the look-up is a binary search
+    vector<InetAddress>::iterator i = lower_bound(previousLabels.begin(), previousLabels.end(), label);
+    if(i != previousLabels.end() && (*i) == label)
+        return;
+    previousLabels.insert(i, label);
 }
 
 bool NetworkTreeNode::compare(NetworkTreeNode *n1, NetworkTreeNode *n2)
 {
-    list<InetAddress> *labels1 = n1->getLabels();
-    list<InetAddress> *labels2 = n2->getLabels();
+    vector<InetAddress> *labels1 = n1->getLabels();
+    vector<InetAddress> *labels2 = n2->getLabels();
     
     bool result = false;
     if (labels1->front() < labels2->front())
@@ -159,40 +156,61 @@ bool NetworkTreeNode::compare(NetworkTreeNode *n1, NetworkTreeNode *n2)
     return result;
 }
 
+void NetworkTreeNode::sortChildren()
+{
+    stable_sort(children.begin(), children.end(), NetworkTreeNode::compare);
+}
+
 void NetworkTreeNode::addChild(NetworkTreeNode *child)
 {
     child->setParent(this);
-    children.push_back(child);
-    children.sort(NetworkTreeNode::compare);
+    
+    // Same position as with a (stable) sort after appending the child, but without the sort
+    children.insert(upper_bound(children.begin(), children.end(), child, NetworkTreeNode::compare), child);
 }
 
 void NetworkTreeNode::merge(NetworkTreeNode *mergee)
 {
     // Gets the children from mergee and updates their parent
-    list<NetworkTreeNode*> *mChildren = mergee->getChildren();
-    for(list<NetworkTreeNode*>::iterator i = mChildren->begin(); i != mChildren->end(); ++i)
+    vector<NetworkTreeNode*> *mChildren = mergee->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = mChildren->begin(); i != mChildren->end(); ++i)
         (*i)->setParent(this);
     
-    // Merges and sorts
-    children.merge(*(mChildren));
-    children.sort(NetworkTreeNode::compare);
+    /*
+     * Appends then sorts (stable), such that children with the same first label keep the order 
+     * of their insertion rather than the order of their addresses, which would depend on memory 
+     * allocation.
+     */
+    
+    children.insert(children.end(), mChildren->begin(), mChildren->end());
+    mChildren->clear();
+    this->sortChildren();
+}
+
+bool NetworkTreeNode::compareFirstLabel(NetworkTreeNode *n, const InetAddress &label)
+{
+    return n->getLabels()->front() < label;
 }
 
 NetworkTreeNode *NetworkTreeNode::getChild(InetAddress label)
 {
-    for(list<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
+    vector<NetworkTreeNode*>::iterator res;
+    res = lower_bound(children.begin(), children.end(), label, NetworkTreeNode::compareFirstLabel);
+    if(res != children.end() && (*res)->getLabels()->front() == label)
+        return (*res);
+    
+    // Label might be one of the other labels of a Hedera child
+    for(vector<NetworkTreeNode*>::iterator i = children.begin(); i != res; ++i)
     {
-        if((*i)->hasLabel(label))
-        {
+        if((*i)->isHedera() && (*i)->hasLabel(label))
             return (*i);
-        }
     }
     return NULL;
 }
 
 bool NetworkTreeNode::hasOnlyLeavesAsChildren()
 {
-    for(list<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
     {
         if(!(*i)->isLeaf())
         {
@@ -210,7 +228,7 @@ unsigned short NetworkTreeNode::getLinkage()
     unsigned short missingLinks = 0;
     list<NetworkTreeNode*> childrenL;
     list<NetworkTreeNode*> childrenI;
-    for(list<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
     {
         if((*i)->isLeaf())
         {
@@ -232,14 +250,14 @@ unsigned short NetworkTreeNode::getLinkage()
     
     for(list<NetworkTreeNode*>::iterator i = childrenI.begin(); i != childrenI.end(); ++i)
     {
-        list<InetAddress> *labels = (*i)->getLabels();
+        vector<InetAddress> *labels = (*i)->getLabels();
         
         bool onTheWay = false;
         for(list<NetworkTreeNode*>::iterator j = childrenL.begin(); j != childrenL.end(); ++j)
         {
             SubnetSite *ss = (*j)->getAssociatedSubnet();
             
-            for(list<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
+            for(vector<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
             {
                 // "On the way"
                 if(ss->contains((*k)))
@@ -263,14 +281,14 @@ list<InetAddress> NetworkTreeNode::listInterfaces()
     list<InetAddress> interfacesList;
     
     // Listing labels of this node
-    for(list<InetAddress>::iterator i = labels.begin(); i != labels.end(); ++i)
+    for(vector<InetAddress>::iterator i = labels.begin(); i != labels.end(); ++i)
     {
         if((*i) != InetAddress("0.0.0.0"))
             interfacesList.push_back((*i));
     }
     
     // Listing children (only subnets)
-    for(list<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children.begin(); i != children.end(); ++i)
     {
         if((*i)->isLeaf())
         {
@@ -312,19 +330,19 @@ list<list<InetAddress> > NetworkTreeNode::listInterfacesByLastHop(list<InetAddre
 {
     list<list<InetAddress> > sets;
 
-    for(list<InetAddress>::iterator i = labels.begin(); i != labels.end(); ++i)
+    for(vector<InetAddress>::iterator i = labels.begin(); i != labels.end(); ++i)
     {
         InetAddress curLastHop = (*i);
         list<InetAddress> candidates;
     
         // Lists targets for which the last hop is the current label
-        for(list<NetworkTreeNode*>::iterator j = children.begin(); j != children.end(); ++j)
+        for(vector<NetworkTreeNode*>::iterator j = children.begin(); j != children.end(); ++j)
         {
             if((*j)->isLeaf())
             {
                 SubnetSite *ss = (*j)->getAssociatedSubnet();
                 unsigned short routeSize = ss->getRouteSize();
-                RouteInterface *route = ss->getRoute();
+                RouteView route = ss->getRouteView();
                 
                 if(route[routeSize - 1].ip == curLastHop)
                 {
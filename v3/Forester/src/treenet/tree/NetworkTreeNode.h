@@ -20,6 +20,10 @@
  * another (all these routes reaching the same destination) are labelled with all IPs found in the 
  * routes we used, such that that we do not create multiple branches for all routes reaching a 
  * same location, which would result in misinterpretating the actual network.
+ *
+ * In October 2026, labels, previous labels and children moved from lists to sorted vectors, such 
+ * that looking up a label (or a child by its first label) is a binary search rather than a walk 
+ * through a list, and such that climbers go through contiguous arrays.
  */
 
 #ifndef NETWORKTREENODE_H_
@@ -27,6 +31,8 @@
 
 #include <list>
 using std::list;
+#include <vector>
+using std::vector;
 
 #include "../../common/inet/InetAddress.h"
 #include "../aliasresolution/Fingerprint.h"
@@ -80,14 +86,23 @@ public:
     inline unsigned short getType() const { return type; }
     inline NetworkTreeNode *getParent() { return parent; }
     inline SubnetSite *getAssociatedSubnet() { return associatedSubnet; }
-    inline list<InetAddress> *getLabels() { return &labels; }
-    inline list<InetAddress> *getPreviousLabels() { return &previousLabels; }
-    inline list<NetworkTreeNode*> *getChildren() { return &children; }
+    inline vector<InetAddress> *getLabels() { return &labels; }
+    inline vector<InetAddress> *getPreviousLabels() { return &previousLabels; }
+    inline vector<NetworkTreeNode*> *getChildren() { return &children; }
     inline list<Router*> *getInferredRouters() { return &inferredRouters; }
     
     // Setter
     inline void setParent(NetworkTreeNode *p) { this->parent = p; }
     
+    /*
+     * Dirty flag, raised on the internal nodes touched by an incremental growth (see 
+     * ClassicGrower::growIncrementally()), i.e., the neighborhoods which alias resolution should 
+     * be re-conducted.
+     */
+    
+    inline bool isDirty() { return this->dirty; }
+    inline void markDirty() { this->dirty = true; }
+    
     // Nullify subnet
     inline void nullifySubnet() { this->associatedSubnet = NULL; }
     
@@ -115,16 +130,25 @@ public:
     // Static comparison method for sorting purposes
     static bool compare(NetworkTreeNode *n1, NetworkTreeNode *n2);
     
-    // Inline method to (re-)sort the children
-    inline void sortChildren() { children.sort(NetworkTreeNode::compare); }
+    // Method to (re-)sort the children (stable, i.e., children with the same first label keep their order)
+    void sortChildren();
+    
+    /*
+     * Method to add a child to this node. Children being kept sorted, the new child is directly 
+     * inserted at its position (after the children it is not smaller than).
+     */
     
-    // Method to add a child to this node
     void addChild(NetworkTreeNode *child);
     
     // Method to merge children from a given node to this one
     void merge(NetworkTreeNode *mergee);
     
-    // Method to get a child of this node, given a label (returns NULL if no such child)
+    /*
+     * Method to get a child of this node, given a label (returns NULL if no such child). The 
+     * children being sorted by their first label, a binary search finds the child labelled first 
+     * with the given label; if there is none, Hedera children are checked for their other labels.
+     */
+    
     NetworkTreeNode *getChild(InetAddress label);
     
     // Boolean method to know if the current node has only subnets (leaves) as children
@@ -156,32 +180,38 @@ public:
     
     // Methods to handle fingerprint lists and last hops (for hedera's)
     inline void storeFingerprints(list<Fingerprint> ls) { this->fingerprints.push_back(ls); }
-    inline list<list<Fingerprint> > getFingerprints() { return this->fingerprints; }
+    inline list<list<Fingerprint> > *getFingerprints() { return &fingerprints; }
     inline void storeLastHop(InetAddress lh) { this->lastHops.push_back(lh); }
-    inline list<InetAddress> getLastHops() { return this->lastHops; }
+    inline list<InetAddress> *getLastHops() { return &lastHops; }
     
     // Method to get the inferred router having a given interface. Returns NULL if no router.
     Router* getRouterHaving(InetAddress interface);
     
 private:
 
-    // Label(s), type, associated subnet (if any) of the node
-    list<InetAddress> labels;
+    // Compares the first label of a node with a label (for binary searches among children)
+    static bool compareFirstLabel(NetworkTreeNode *n, const InetAddress &label);
+
+    // Label(s) (sorted), type, associated subnet (if any) of the node
+    vector<InetAddress> labels;
     unsigned short type;
     SubnetSite *associatedSubnet;
 
-    // Children are stored in a list
-    list<NetworkTreeNode*> children;
+    // Children are stored in a vector, sorted by first label
+    vector<NetworkTreeNode*> children;
     
     // Parent node is maintained too
     NetworkTreeNode *parent;
     
+    // True if touched by an incremental growth
+    bool dirty;
+    
     /*
-     * A list is also used to maintain the previous label(s) in the route to the subnets ending 
-     * this branch. This helps to analyze multi-labels nodes.
+     * A sorted vector is also used to maintain the previous label(s) in the route to the subnets 
+     * ending this branch. This helps to analyze multi-labels nodes.
      */
     
-    list<InetAddress> previousLabels;
+    vector<InetAddress> previousLabels;
     
     /*
      * General remark for next fields: while they are not essential for all variants of TreeNET 
@@ -11,16 +11,14 @@
 #include <string>
 using std::string;
 
-// 3 next lines are for outputting data in text files
-#include <fstream>
 #include <sys/stat.h> // For CHMOD edition
-using std::ofstream;
 
 #include "Soil.h"
 
 Soil::Soil()
 {
     this->subnetMap = new list<SubnetMapEntry*>[SIZE_SUBNET_MAP];
+    this->shortestPrefix = 32;
 }
 
 Soil::~Soil()
@@ -50,6 +48,10 @@ void Soil::insertMapEntries(list<SubnetMapEntry*> newEntries)
         InetAddress needle = (*i)->subnet->getPivot();
         unsigned long index = (needle.getULongAddress() >> 12);
         this->subnetMap[index].push_back((*i));
+        
+        unsigned char prefix = (*i)->subnet->getInferredSubnetPrefixLength();
+        if(prefix < this->shortestPrefix)
+            this->shortestPrefix = prefix;
     }
 }
 
@@ -62,6 +64,54 @@ void Soil::sortMapEntries()
     }
 }
 
+void Soil::insertMapEntry(SubnetMapEntry *entry)
+{
+    InetAddress needle = entry->subnet->getPivot();
+    unsigned long index = (needle.getULongAddress() >> 12);
+    list<SubnetMapEntry*> *subnetList = &(this->subnetMap[index]);
+    
+    list<SubnetMapEntry*>::iterator i = subnetList->begin();
+    while(i != subnetList->end() && !SubnetMapEntry::compare(entry, (*i)))
+        ++i;
+    subnetList->insert(i, entry);
+    
+    unsigned char prefix = entry->subnet->getInferredSubnetPrefixLength();
+    if(prefix < this->shortestPrefix)
+        this->shortestPrefix = prefix;
+}
+
+list<SubnetMapEntry*> Soil::removeOverlappingEntries(SubnetSite *subnet)
+{
+    list<SubnetMapEntry*> removed;
+    unsigned long lower = subnet->getInferredSubnetBaseIP().getULongAddress();
+    unsigned long upper = lower + (1UL << (32 - subnet->getInferredSubnetPrefixLength())) - 1;
+    
+    // Block of the shortest prefix length containing the subnet (or the subnet itself)
+    unsigned char blockPrefix = subnet->getInferredSubnetPrefixLength();
+    if(this->shortestPrefix < blockPrefix)
+        blockPrefix = this->shortestPrefix;
+    unsigned long blockSize = 1UL << (32 - blockPrefix);
+    unsigned long blockLower = lower - (lower % blockSize);
+    unsigned long blockUpper = blockLower + blockSize - 1;
+    
+    for(unsigned long index = (blockLower >> 12); index <= (blockUpper >> 12); index++)
+    {
+        list<SubnetMapEntry*> *subnetList = &(this->subnetMap[index]);
+        for(list<SubnetMapEntry*>::iterator i = subnetList->begin(); i != subnetList->end(); ++i)
+        {
+            SubnetSite *cur = (*i)->subnet;
+            unsigned long curLower = cur->getInferredSubnetBaseIP().getULongAddress();
+            unsigned long curUpper = curLower + (1UL << (32 - cur->getInferredSubnetPrefixLength())) - 1;
+            if(curLower <= upper && lower <= curUpper)
+            {
+                removed.push_back((*i));
+                subnetList->erase(i--);
+            }
+        }
+    }
+    return removed;
+}
+
 SubnetMapEntry *Soil::getSubnetContaining(InetAddress needle)
 {
     unsigned long index = (needle.getULongAddress() >> 12);
@@ -78,16 +128,12 @@ SubnetMapEntry *Soil::getSubnetContaining(InetAddress needle)
 
 void Soil::outputSubnets(string filename)
 {
-    string finalOutput = "";
+    OutputBuffer output(filename);
     for(list<NetworkTree*>::iterator i = roots.begin(); i != roots.end(); i++)
     {
-        finalOutput += (*i)->writeSubnets();
+        (*i)->writeSubnets(&output);
     }
-    
-    ofstream newFile;
-    newFile.open(filename.c_str());
-    newFile << finalOutput;
-    newFile.close();
+    output.close();
     
     // File must be accessible to all
     string path = "./" + filename;
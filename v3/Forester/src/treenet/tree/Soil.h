@@ -53,6 +53,20 @@ public:
     void insertMapEntries(list<SubnetMapEntry*> entries);
     void sortMapEntries();
     
+    // Inserts a single SubnetMapEntry object, at its position in its (sorted) list
+    void insertMapEntry(SubnetMapEntry *entry);
+    
+    /*
+     * Removes from the map the entries of the subnets which overlap a given subnet, and returns 
+     * them. Entries being listed by pivot, an overlapping subnet is either listed in the lists 
+     * covering the range of the given subnet (if it is inside this range), either anywhere in 
+     * the range of a larger subnet containing the given subnet. Since subnets are prefix-aligned, 
+     * the latter is within the block of the shortest prefix length in the map which contains the 
+     * given subnet, therefore the lists covering this block are scanned as well.
+     */
+    
+    list<SubnetMapEntry*> removeOverlappingEntries(SubnetSite *subnet);
+    
     // Gets a subnet inserted in a tree which contains the given input address (NULL if not found).
     SubnetMapEntry *getSubnetContaining(InetAddress needle);
     
@@ -62,11 +76,14 @@ public:
 private:
 
     /*
-     * Private fields: roots of each tree, subnet map.
+     * Private fields: roots of each tree, subnet map and shortest prefix length in the map.
      */
     
     list<NetworkTree*> roots;
     list<SubnetMapEntry*> *subnetMap;
+    
+    // Shortest prefix length among the subnets inserted in the map (see removeOverlappingEntries())
+    unsigned char shortestPrefix;
 };
 
 #endif /* SOIL_H_ */
@@ -35,25 +35,23 @@ void Cat::climb(Soil *fromSoil)
         for(list<NetworkTree*>::iterator i = roots->begin(); i != roots->end(); ++i)
         {
             (*out) << "[Tree n°" << treeIndex << "]\n" << endl;
-            this->climbRecursive((*i)->getRoot(), 0);
+            this->climbInParallel((*i)->getRoot(), false);
             
             treeIndex++;
         }
     }
     else if(roots->size() == 1)
     {
-        this->climbRecursive(roots->front()->getRoot(), 0);
+        this->climbInParallel(roots->front()->getRoot(), false);
     }
     
     this->soilRef = NULL;
 }
 
-void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
+void Cat::visit(NetworkTreeNode *cur, unsigned short, ostream *out)
 {
-    ostream *out = env->getOutputStream();
-    
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    list<InetAddress> *labels = cur->getLabels();
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    vector<InetAddress> *labels = cur->getLabels();
     size_t nbChildren = children->size();
     
     // Ingress/egress interfaces count (for amount of interfaces inference)
@@ -68,7 +66,7 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
     // Puts direct neighbor subnets in a list and puts the internal nodes in another one
     list<NetworkTreeNode*> childrenL;
     list<NetworkTreeNode*> childrenI;
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         // Just in case (PlanetLab...)
         if((*i) == NULL)
@@ -101,7 +99,7 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             {
                 (*out) << "Neighboring subnets of Hedera {";
                 bool guardian = false;
-                for(list<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
+                for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
                 {
                     if (guardian)
                         (*out) << ", ";
@@ -160,13 +158,13 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
                     if((*j) == NULL)
                         continue;
                 
-                    list<InetAddress> *labels = (*j)->getLabels();
+                    vector<InetAddress> *labels = (*j)->getLabels();
                     
                     // Idem
                     if(labels == NULL)
                         continue;
                     
-                    for(list<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
+                    for(vector<InetAddress>::iterator k = labels->begin(); k != labels->end(); ++k)
                     {
                         if(ss->contains((*k)))
                         {
@@ -220,7 +218,7 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             (*out) << "\nLabel analysis:" << endl;
             unsigned short nbLabels = labels->size();
             unsigned short appearingLabels = 0;
-            for(list<InetAddress>::iterator l = labels->begin(); l != labels->end(); ++l)
+            for(vector<InetAddress>::iterator l = labels->begin(); l != labels->end(); ++l)
             {
                 InetAddress curLabel = (*l);
                 SubnetMapEntry *container = this->soilRef->getSubnetContaining(curLabel);
@@ -245,30 +243,30 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
         (*out) << endl;
         
         // Fingerprints
-        list<list<Fingerprint> > fingerprints = cur->getFingerprints();
-        if(cur->isHedera() && fingerprints.size() > 1)
+        list<list<Fingerprint> > *fingerprints = cur->getFingerprints();
+        if(cur->isHedera() && fingerprints->size() > 1)
         {
-            list<InetAddress> lastHops = cur->getLastHops();
+            list<InetAddress> *lastHops = cur->getLastHops();
+            list<InetAddress>::iterator lastHop = lastHops->begin();
             (*out) << "Fingerprints (sorted, grouped by last hop towards interface):\n";
-            while(fingerprints.size() > 0)
+            for(list<list<Fingerprint> >::iterator i = fingerprints->begin(); i != fingerprints->end(); ++i)
             {
-                list<Fingerprint> simpleList = fingerprints.front();
-                (*out) << "\nLast hop = " << lastHops.front() << ":\n";
-                for(list<Fingerprint>::iterator it = simpleList.begin(); it != simpleList.end(); ++it)
+                list<Fingerprint> *simpleList = &(*i);
+                (*out) << "\nLast hop = " << (*lastHop) << ":\n";
+                for(list<Fingerprint>::iterator it = simpleList->begin(); it != simpleList->end(); ++it)
                 {
                     (*out) << (InetAddress) (*((*it).ipEntry)) << " - " << (*it) << "\n";
                 }
                 
-                fingerprints.pop_front();
-                lastHops.pop_front();
+                ++lastHop;
             }
             (*out) << endl;
         }
         else
         {
-            list<Fingerprint> simpleList = fingerprints.front();
+            list<Fingerprint> *simpleList = &(fingerprints->front());
             (*out) << "Fingerprints (sorted):\n";
-            for(list<Fingerprint>::iterator it = simpleList.begin(); it != simpleList.end(); ++it)
+            for(list<Fingerprint>::iterator it = simpleList->begin(); it != simpleList->end(); ++it)
             {
                 (*out) << (InetAddress) (*((*it).ipEntry)) << " - " << (*it) << "\n";
             }
@@ -285,9 +283,33 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             else
                 (*out) << "Inferred routers: " << endl;
             
+            AliasSet *aliasSet = env->getAliasSet();
+            IPLookUpTable *table = env->getIPTable();
             for(list<Router*>::iterator i = routers->begin(); i != routers->end(); ++i)
             {
                 (*out) << "[" << (*i)->toStringVerbose() << "]" << endl;
+                
+                // Mentions the interfaces aliased with this router in other neighborhoods
+                IPTableEntry *first = table->lookUp((*i)->getInterfacesList()->front()->ip);
+                if(first == NULL)
+                    continue;
+                
+                unsigned int mergedSize = aliasSet->getRouterSize(first);
+                if(mergedSize > (unsigned int) (*i)->getNbInterfaces())
+                {
+                    list<InetAddress> merged = aliasSet->listAliases(first);
+                    (*out) << "Merged with aliases found elsewhere: [";
+                    bool guardian = false;
+                    for(list<InetAddress>::iterator j = merged.begin(); j != merged.end(); ++j)
+                    {
+                        if(guardian)
+                            (*out) << ", ";
+                        else
+                            guardian = true;
+                        (*out) << (*j);
+                    }
+                    (*out) << "]" << endl;
+                }
             }
         }
         else
@@ -312,7 +334,7 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             {
                 (*out) << "Hedera of internal node {";
                 bool guardian = false;
-                for(list<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
+                for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
                 {
                     if (guardian)
                         (*out) << ", ";
@@ -356,7 +378,7 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             (*out) << endl << "Label analysis:" << endl;
             unsigned short nbLabels = labels->size();
             unsigned short appearingLabels = 0;
-            for(list<InetAddress>::iterator l = labels->begin(); l != labels->end(); ++l)
+            for(vector<InetAddress>::iterator l = labels->begin(); l != labels->end(); ++l)
             {
                 InetAddress curLabel = (*l);
                 SubnetMapEntry *container = this->soilRef->getSubnetContaining(curLabel);
@@ -381,11 +403,4 @@ void Cat::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
         
         (*out) << "------------------------------------------" << endl << endl;
     }
-    
-    // Goes deeper in the tree (avoids exploring leaves)
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
-    {
-        if((*i) != NULL && (*i)->isInternal())
-            this->climbRecursive((*i), depth + 1);
-    }
 }
@@ -36,11 +36,11 @@ protected:
     Soil *soilRef;
 
     /*
-     * Method to recursively "climb" the tree, node by node. The depth parameter works just like 
-     * in Robin class; its goal is to have a default TTL for un-probed IP during alias resolution.
+     * Method to analyze a single neighborhood (see Climber::climbInParallel()). The depth 
+     * parameter is not used, but kept for consistency with the other climbers.
      */
     
-    void climbRecursive(NetworkTreeNode *cur, unsigned short depth);
+    void visit(NetworkTreeNode *cur, unsigned short depth, ostream *out); // Implicitely virtual
 };
 
 #endif /* CAT_H_ */
@@ -9,13 +9,155 @@
  */
 
 #include "Climber.h"
+#include "ClimberUnit.h"
 
-Climber::Climber(TreeNETEnvironment *env)
+Climber::Climber(TreeNETEnvironment *env):
+sliceMutex(Mutex::ERROR_CHECKING_MUTEX)
 {
     this->env = env;
+    this->nextSlice = 0;
+    this->nextOutput = 0;
 }
 
 Climber::~Climber()
 {
     // Nothing is deleted, because any pointer points to data structures used elsewhere
 }
+
+void Climber::visit(NetworkTreeNode *, unsigned short, ostream *)
+{
+    // Nothing by default; to be overriden by children classes which use climbInParallel()
+}
+
+bool Climber::visitNextSlice()
+{
+    sliceMutex.lock();
+    if(nextSlice >= slices.size())
+    {
+        sliceMutex.unlock();
+        return false;
+    }
+    size_t slice = nextSlice;
+    nextSlice++;
+    sliceMutex.unlock();
+    
+    size_t end = toVisit.size();
+    if(slice + 1 < slices.size())
+        end = slices[slice + 1];
+    
+    ostream *out = env->getOutputStream();
+    ostringstream *buffer = new ostringstream();
+    buffer->flags(out->flags());
+    buffer->precision(out->precision());
+    for(size_t i = slices[slice]; i < end; i++)
+        this->visit(toVisit[i], depths[i], buffer);
+    
+    sliceMutex.lock();
+    buffers[slice] = buffer;
+    slicesDone[slice] = true;
+    this->flushDoneSlices();
+    sliceMutex.unlock();
+    return true;
+}
+
+void Climber::flushDoneSlices()
+{
+    ostream *out = env->getOutputStream();
+    while(nextOutput < slices.size() && slicesDone[nextOutput])
+    {
+        (*out) << buffers[nextOutput]->str();
+        delete buffers[nextOutput];
+        buffers[nextOutput] = NULL;
+        nextOutput++;
+    }
+}
+
+void Climber::climbInParallel(NetworkTreeNode *root, bool withLeaves)
+{
+    ostream *out = env->getOutputStream();
+    
+    // Lists the nodes in pre-order (same order as a recursive climb)
+    list<NetworkTreeNode*> stack;
+    list<unsigned short> stackDepths;
+    stack.push_back(root);
+    stackDepths.push_back(0);
+    while(stack.size() > 0)
+    {
+        NetworkTreeNode *cur = stack.back();
+        unsigned short depth = stackDepths.back();
+        stack.pop_back();
+        stackDepths.pop_back();
+        
+        toVisit.push_back(cur);
+        depths.push_back(depth);
+        
+        vector<NetworkTreeNode*> *children = cur->getChildren();
+        for(vector<NetworkTreeNode*>::reverse_iterator i = children->rbegin(); i != children->rend(); ++i)
+        {
+            if((*i) == NULL || (!withLeaves && (*i)->isLeaf()))
+                continue;
+            
+            stack.push_back((*i));
+            stackDepths.push_back(depth + 1);
+        }
+    }
+    
+    // Slices the list; small trees (or a single thread) are simply visited in order
+    unsigned short maxThreads = env->getMaxThreads();
+    for(size_t i = 0; i < toVisit.size(); i += NODES_PER_SLICE)
+        slices.push_back(i);
+    
+    if(maxThreads <= 1 || slices.size() <= 1)
+    {
+        for(size_t i = 0; i < toVisit.size(); i++)
+            this->visit(toVisit[i], depths[i], out);
+        
+        toVisit.clear();
+        depths.clear();
+        slices.clear();
+        return;
+    }
+    
+    buffers.assign(slices.size(), (ostringstream*) NULL);
+    slicesDone.assign(slices.size(), false);
+    nextSlice = 0;
+    nextOutput = 0;
+    
+    // Launches the threads; the current thread also visits slices until none is left
+    unsigned short nbThreads = maxThreads - 1;
+    if(slices.size() - 1 < (size_t) nbThreads)
+        nbThreads = (unsigned short) (slices.size() - 1);
+    
+    list<Thread*> threads;
+    for(unsigned short i = 0; i < nbThreads; i++)
+    {
+        Thread *th = new Thread(new ClimberUnit(this));
+        try
+        {
+            th->start();
+        }
+        catch(ThreadException &te)
+        {
+            delete th; // Also deletes the unit
+            break;
+        }
+        threads.push_back(th);
+    }
+    
+    bool slicesLeft = true;
+    while(slicesLeft)
+        slicesLeft = this->visitNextSlice();
+    
+    for(list<Thread*>::iterator i = threads.begin(); i != threads.end(); ++i)
+    {
+        (*i)->join();
+        delete (*i);
+    }
+    
+    // All buffers have been written by now (the last done slice writes all remaining ones)
+    toVisit.clear();
+    depths.clear();
+    slices.clear();
+    buffers.clear();
+    slicesDone.clear();
+}
@@ -7,11 +7,19 @@
  * This partially abstract class defines the interface for a bunch of classes which act as "tree 
  * travellers" to perform various operations, such as visiting neighborhoods for alias resolution 
  * hint collection or simply printing out the tree.
+ *
+ * Climbers which only read the tree to write some output can also rely on climbInParallel(), 
+ * which visits the nodes of a tree with several threads (see below) rather than recursively.
  */
 
 #ifndef CLIMBER_H_
 #define CLIMBER_H_
 
+#include <vector>
+using std::vector;
+#include <sstream>
+using std::ostringstream;
+
 #include "../../TreeNETEnvironment.h"
 #include "../Soil.h"
 
@@ -19,18 +27,60 @@ class Climber
 {
 public:
 
+    // Minimum amount of nodes visited by a thread at once during a parallel climb
+    static const size_t NODES_PER_SLICE = 64;
+
     // Constructor, destructor
     Climber(TreeNETEnvironment *env);
     virtual ~Climber();
     
     // To be implemented by children classes
     virtual void climb(Soil *fromSoil) = 0;
+    
+    /*
+     * Visits the next slice of nodes of the ongoing parallel climb. Returns false when there is 
+     * no slice left to visit. Only meant to be called by ClimberUnit.
+     */
+    
+    bool visitNextSlice();
 
 protected:
 
-    // Unique field: environment object
+    // Environment object
     TreeNETEnvironment *env;
     
+    /*
+     * Parallel climb. The nodes of the tree rooted at "root" are listed in the same order as in 
+     * a recursive climb (pre-order, leaves being listed only if withLeaves is true), then split 
+     * into contiguous slices which are visited by up to maxThreads threads (as given by the 
+     * environment, the current thread being one of them) with the visit() method. Each slice is written in its own buffer, which is 
+     * written in the output stream (then freed) as soon as the slice and all the previous ones 
+     * are done, such that the output is the same as the one of a sequential climb while only the 
+     * buffers of the slices being visited or waiting for a previous slice are kept in memory.
+     *
+     * visit() must therefore write in the given stream rather than in the output stream of the 
+     * environment, and must not modify data shared with other nodes.
+     */
+    
+    void climbInParallel(NetworkTreeNode *root, bool withLeaves);
+    virtual void visit(NetworkTreeNode *node, unsigned short depth, ostream *out);
+    
+private:
+
+    // Nodes (with their depth) of the ongoing parallel climb, slices (start indexes), buffers
+    vector<NetworkTreeNode*> toVisit;
+    vector<unsigned short> depths;
+    vector<size_t> slices;
+    vector<ostringstream*> buffers;
+    vector<bool> slicesDone;
+    
+    // Next slice to visit, next slice to write (both protected by the mutex)
+    size_t nextSlice, nextOutput;
+    Mutex sliceMutex;
+    
+    // Writes (then frees) the buffers of the done slices following the last written one
+    void flushDoneSlices();
+    
 };
 
 #endif /* CLIMBER_H_ */
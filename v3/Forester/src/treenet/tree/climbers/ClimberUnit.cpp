@@ -0,0 +1,27 @@
+/*
+ * ClimberUnit.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in ClimberUnit.h (see this file to learn further about the goals 
+ * of such class).
+ */
+
+#include "ClimberUnit.h"
+
+ClimberUnit::ClimberUnit(Climber *parent)
+{
+    this->parent = parent;
+}
+
+ClimberUnit::~ClimberUnit()
+{
+}
+
+void ClimberUnit::run()
+{
+    bool slicesLeft = true;
+    while(slicesLeft)
+        slicesLeft = parent->visitNextSlice();
+}
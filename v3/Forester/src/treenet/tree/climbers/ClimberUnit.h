@@ -0,0 +1,33 @@
+/*
+ * ClimberUnit.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * This class, inheriting Runnable, visits slices of nodes on behalf of a Climber object during a 
+ * parallel climb (see Climber::climbInParallel()), until there is no slice left to visit.
+ */
+
+#ifndef CLIMBERUNIT_H_
+#define CLIMBERUNIT_H_
+
+#include "Climber.h"
+#include "../../../common/thread/Runnable.h"
+
+class ClimberUnit : public Runnable
+{
+public:
+
+    // Constructor, destructor, run method
+    ClimberUnit(Climber *parent);
+    ~ClimberUnit();
+    void run();
+    
+private:
+
+    // Climber performing the parallel climb
+    Climber *parent;
+
+};
+
+#endif /* CLIMBERUNIT_H_ */
@@ -11,10 +11,7 @@
 #include <list>
 using std::list;
 
-// 3 next lines are for outputting data in text files
-#include <fstream>
 #include <sys/stat.h> // For CHMOD edition
-using std::ofstream;
 
 #include "Crow.h"
 
@@ -48,12 +45,12 @@ void Crow::climb(Soil *fromSoil)
 
 void Crow::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
 {
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    list<InetAddress> *labels = cur->getLabels();
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    vector<InetAddress> *labels = cur->getLabels();
     
     // Puts direct neighbor subnets in a list
     list<NetworkTreeNode*> childrenL;
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         // Just in case (PlanetLab...)
         if((*i) == NULL)
@@ -69,24 +66,11 @@ void Crow::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
     {   
         // Router inference
         ar->setCurrentTTL(depth);
-        this->ar->resolve(cur);
-        list<Router*> *routers = cur->getInferredRouters();
-        if((unsigned short) routers->size() > 0)
-        {
-            for(list<Router*>::iterator i = routers->begin(); i != routers->end(); ++i)
-            {
-                Router *cur = (*i);
-                this->aliases.push_back(cur);
-            }
-        }
-        else
-        {
-            // No alias resolution could be carried out (lack of data)
-        }
+        this->ar->resolve(cur); // Also records the inferred routers in the alias set
     }
     
     // Goes deeper in the tree (avoids exploring leaves)
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         if((*i) != NULL && (*i)->isInternal())
             this->climbRecursive((*i), depth + 1);
@@ -95,13 +79,16 @@ void Crow::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
 
 void Crow::outputAliases(string filename)
 {
-    ofstream newFile;
-    newFile.open(filename.c_str());
+    list<Router*> aliases = env->getAliasSet()->getRouters();
+
+    OutputBuffer output(filename);
     for(list<Router*>::iterator i = aliases.begin(); i != aliases.end(); ++i)
     {
-        newFile << (*i)->toString() << "\n";
+        (*i)->writeTo(&output);
+        output << "\n";
+        delete (*i);
     }
-    newFile.close();
+    output.close();
     
     // File must be accessible to all
     string path = "./" + filename;
@@ -24,14 +24,18 @@ public:
     
     void climb(Soil *fromSoil); // Implicitely virtual
     
-    // Method to flush the obtained aliases into an output text file
+    /*
+     * Method to flush the obtained aliases into an output text file. The aliases are the merged 
+     * routers of the alias set of the environment, such that an interface aliased in several 
+     * neighborhoods (or last hop groups of a hedera) appears in a single router.
+     */
+    
     void outputAliases(string filename);
 
 protected:
 
-    // Alias resolution tool and list of produced aliases
+    // Alias resolution tool
     AliasResolver *ar;
-    list<Router*> aliases;
     
     // Field to maintain Soil while travelling (useful for the getSubnetContaining() method)
     Soil *soilRef;
@@ -8,12 +8,15 @@
  * such class).
  */
 
+#include <ctime> // For time()
+
 #include "../../../common/thread/Thread.h" // For invokeSleep()
 #include "Cuckoo.h"
 
-Cuckoo::Cuckoo(TreeNETEnvironment *env) : Climber(env)
+Cuckoo::Cuckoo(TreeNETEnvironment *env, bool dirtyOnly) : Climber(env)
 {
     ahc = new AliasHintCollector(env);
+    this->dirtyOnly = dirtyOnly;
 }
 
 Cuckoo::~Cuckoo()
@@ -24,7 +27,7 @@ Cuckoo::~Cuckoo()
 void Cuckoo::climb(Soil *fromSoil)
 {
     // Small delay before starting with the first internal (typically half a second)
-    Thread::invokeSleep(env->getProbeThreadDelay() * 2);
+    env->pauseProbing(env->getProbeThreadDelay() * 2);
     
     ostream *out = env->getOutputStream();
     list<NetworkTree*> *roots = fromSoil->getRootsList();
@@ -56,8 +59,8 @@ void Cuckoo::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
     // Root: goes deeper
     if(cur->isRoot())
     {
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+        vector<NetworkTreeNode*> *children = cur->getChildren();
+        for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
         {
             this->climbRecursive((*i), depth + 1);
         }
@@ -72,15 +75,21 @@ void Cuckoo::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
     {
         list<InetAddress> interfacesToProbe = cur->listInterfaces();
         
-        if(interfacesToProbe.size() > 1)
+        if(interfacesToProbe.size() > 1 && (!dirtyOnly || cur->isDirty() || this->hasStaleHints(interfacesToProbe)))
         {
+            if(dirtyOnly)
+            {
+                IPLookUpTable *table = env->getIPTable();
+                table->clearAliasHints(interfacesToProbe, time(NULL), env->getHintsMaxAges());
+            }
+            
             (*out) << "Collecting alias resolution hints for ";
             if(cur->isHedera())
             {
                 (*out) << "Hedera {";
-                list<InetAddress> *labels = cur->getLabels();
+                vector<InetAddress> *labels = cur->getLabels();
                 bool guardian = false;
-                for(list<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
+                for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
                 {
                     if (guardian)
                         (*out) << ", ";
@@ -142,7 +151,7 @@ void Cuckoo::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
                         throw;
                     }
                     
-                    Thread::invokeSleep(env->getProbeThreadDelay());
+                    env->pauseProbing(env->getProbeThreadDelay());
                 }
             }
             // Simple internal: only one collection
@@ -160,14 +169,29 @@ void Cuckoo::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
             }
             
             // Small delay before analyzing next internal (typically quarter of a second)
-            Thread::invokeSleep(env->getProbeThreadDelay());
+            env->pauseProbing(env->getProbeThreadDelay());
         }
         
         // Goes deeper
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+        vector<NetworkTreeNode*> *children = cur->getChildren();
+        for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
         {
             this->climbRecursive((*i), depth + 1);
         }
     }
 }
+
+bool Cuckoo::hasStaleHints(list<InetAddress> interfaces)
+{
+    IPLookUpTable *table = env->getIPTable();
+    for(list<InetAddress>::iterator i = interfaces.begin(); i != interfaces.end(); ++i)
+    {
+        IPTableEntry *entry = table->lookUp((*i));
+        for(unsigned short j = 0; j < IPTableEntry::NB_HINT_TYPES; j++)
+        {
+            if(j != IPTableEntry::HINT_IP_IDS && !env->isHintFresh(entry, j))
+                return true;
+        }
+    }
+    return false;
+}
@@ -20,8 +20,15 @@ class Cuckoo : public Climber
 {
 public:
 
-    // Constructor, destructor
-    Cuckoo(TreeNETEnvironment *env);
+    /*
+     * Constructor, destructor. If dirtyOnly is true, only the neighborhoods touched by an 
+     * incremental growth (see NetworkTreeNode::isDirty()) and the neighborhoods having an 
+     * interface with hints which are no longer fresh (see TreeNETEnvironment::isHintFresh()) 
+     * are visited; their stale hints are cleared before collecting new ones, while the other 
+     * neighborhoods keep their hints (IP IDs included, since they were collected together).
+     */
+    
+    Cuckoo(TreeNETEnvironment *env, bool dirtyOnly = false);
     ~Cuckoo(); // Implicitely virtual
     
     void climb(Soil *fromSoil); // Implicitely virtual
@@ -29,6 +36,7 @@ public:
 protected:
 
     AliasHintCollector *ahc;
+    bool dirtyOnly;
 
     /*
      * Method to recursively "climb" the tree, node by node. The depth parameter works just like 
@@ -37,6 +45,9 @@ protected:
      */
     
     void climbRecursive(NetworkTreeNode *cur, unsigned short depth);
+    
+    // Checks if an interface of a neighborhood lacks a fresh hint (IP IDs are not considered)
+    bool hasStaleHints(list<InetAddress> interfaces);
 };
 
 #endif /* CUCKOO_H_ */
@@ -34,7 +34,7 @@ void Robin::climb(Soil *fromSoil)
         for(list<NetworkTree*>::iterator i = roots->begin(); i != roots->end(); ++i)
         {
             (*out) << "Tree n°" << treeIndex << endl;
-            this->climbRecursive((*i)->getRoot(), 0);
+            this->climbInParallel((*i)->getRoot(), true);
             (*out) << endl;
             
             treeIndex++;
@@ -42,15 +42,13 @@ void Robin::climb(Soil *fromSoil)
     }
     else if(roots->size() == 1)
     {
-        this->climbRecursive(roots->front()->getRoot(), 0);
+        this->climbInParallel(roots->front()->getRoot(), true);
         (*out) << endl;
     }
 }
 
-void Robin::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
+void Robin::visit(NetworkTreeNode *cur, unsigned short depth, ostream *out)
 {
-    ostream *out = env->getOutputStream();
-    
     // Prints current depth
     (*out) << depth << " - ";
     
@@ -58,12 +56,6 @@ void Robin::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
     if(cur->isRoot())
     {
         (*out) << "Root node" << endl;
-        
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
-        {
-            this->climbRecursive((*i), depth + 1);
-        }
     }
     // Displays a leaf (subnet)
     else if(cur->isLeaf())
@@ -76,9 +68,9 @@ void Robin::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
         if(cur->isHedera())
         {
             (*out) << "Internal - Hedera: ";
-            list<InetAddress> *labels = cur->getLabels();
+            vector<InetAddress> *labels = cur->getLabels();
             bool guardian = false;
-            for(list<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
+            for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
             {
                 if (guardian)
                     (*out) << ", ";
@@ -94,12 +86,12 @@ void Robin::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
         }
         
         // Shows previous label(s) appearing in the routes of subnets of this branch
-        list<InetAddress> *prevLabels = cur->getPreviousLabels();
+        vector<InetAddress> *prevLabels = cur->getPreviousLabels();
         if(prevLabels->size() > 0)
         {
             (*out) << " (Previous: ";
             bool guardian = false;
-            for(list<InetAddress>::iterator i = prevLabels->begin(); i != prevLabels->end(); ++i)
+            for(vector<InetAddress>::iterator i = prevLabels->begin(); i != prevLabels->end(); ++i)
             {
                 if (guardian)
                     (*out) << ", ";
@@ -112,11 +104,5 @@ void Robin::climbRecursive(NetworkTreeNode *cur, unsigned short depth)
         }
         
         (*out) << endl;
-        
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
-        {
-            this->climbRecursive((*i), depth + 1);
-        }
     }
 }
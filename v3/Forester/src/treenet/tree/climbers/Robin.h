@@ -26,12 +26,11 @@ public:
 protected:
 
     /*
-     * Method to recursively "climb" the tree, node by node. The depth parameter is incremented 
-     * each time we go deeper to be able to annotate each outputted line with the corresponding 
-     * depth.
+     * Method to print out a single node (see Climber::climbInParallel()). The depth parameter is 
+     * used to annotate each outputted line with the corresponding depth.
      */
     
-    void climbRecursive(NetworkTreeNode *cur, unsigned short depth);
+    void visit(NetworkTreeNode *cur, unsigned short depth, ostream *out); // Implicitely virtual
 };
 
 #endif /* ROBIN_H_ */
@@ -10,6 +10,11 @@
 
 #include <iomanip>
 using std::setprecision;
+#include <map>
+using std::map;
+using std::pair;
+#include <set>
+using std::set;
 
 #include "Termite.h"
 
@@ -25,6 +30,9 @@ void Termite::climb(Soil *fromSoil)
 {
     ostream *out = env->getOutputStream();
     list<NetworkTree*> *roots = fromSoil->getRootsList();
+    
+    // Probabilities are written with 3 significant digits (slice buffers inherit the precision)
+    (*out) << setprecision(3);
 
     if(roots->size() > 1)
     {
@@ -33,7 +41,7 @@ void Termite::climb(Soil *fromSoil)
         for(list<NetworkTree*>::iterator i = roots->begin(); i != roots->end(); ++i)
         {
             (*out) << "[Tree n°" << treeIndex << "]\n" << endl;
-            this->climbRecursive((*i)->getRoot());
+            this->climbInParallel((*i)->getRoot(), false);
             (*out) << endl;
             
             treeIndex++;
@@ -41,15 +49,13 @@ void Termite::climb(Soil *fromSoil)
     }
     else if(roots->size() == 1)
     {
-        this->climbRecursive(roots->front()->getRoot());
+        this->climbInParallel(roots->front()->getRoot(), false);
         (*out) << endl;
     }
 }
 
-void Termite::evaluate(list<Router*> routers)
+void Termite::evaluate(list<Router*> routers, ostream *out)
 {
-    ostream *out = env->getOutputStream();
-
     unsigned short reqNbInterfaces = (unsigned short) routers.size() - 1;
     unsigned short k = 0;
     float sumProba = 0.0;
@@ -61,130 +67,119 @@ void Termite::evaluate(list<Router*> routers)
         sumProba += proba;
         k++;
     
-        (*out) << (*i)->toStringMinimalist() << " - " << setprecision(3) << proba * 100;
+        (*out) << (*i)->toStringMinimalist() << " - " << proba * 100;
         (*out) << "%" << endl;
     }
     
     float avg = sumProba / (float) routers.size();
-    (*out) << "\nAverage probability: " << setprecision(3) << avg * 100 << "%\n" << endl;
+    (*out) << "\nAverage probability: " << avg * 100 << "%\n" << endl;
 }
 
-void Termite::climbRecursive(NetworkTreeNode *cur)
+void Termite::visit(NetworkTreeNode *cur, unsigned short, ostream *out)
 {
-    ostream *out = env->getOutputStream();
+    // Root or leaf: nothing to evaluate
+    if(cur->isRoot() || cur->isLeaf())
+        return;
+    
+    list<Router*> *routers = cur->getInferredRouters();
+    if(routers->size() == 0)
+        return;
     
-    // Root: goes deeper
+    vector<InetAddress> *labels = cur->getLabels();
     if(cur->isRoot())
     {
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
-        {
-            this->climbRecursive((*i));
-        }
-    }
-    // Leaf: stops
-    else if(cur->isLeaf())
-    {
-        return;
+        (*out) << "Root neighborhood\n";
     }
-    // Any other case: internal node
     else
     {
-        list<Router*> *routers = cur->getInferredRouters();
-        if(routers->size() == 0)
+        if(cur->isHedera())
         {
-            // Goes deeper and quits
-            list<NetworkTreeNode*> *children = cur->getChildren();
-            for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+            (*out) << "Neighborhood/Hedera {";
+            bool guardian = false;
+            for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
             {
-                this->climbRecursive((*i));
+                if (guardian)
+                    (*out) << ", ";
+                else
+                    guardian = true;
+            
+                (*out) << (*i);
             }
-            return;
+            (*out) << "}\n";
         }
-        
-        list<InetAddress> *labels = cur->getLabels();
-        if(cur->isRoot())
+        else
         {
-            (*out) << "Root neighborhood\n";
+            (*out) << "Neighborhood {" << labels->front() << "}\n";
         }
-        else
+    }
+
+    if(cur->isHedera())
+    {
+        /*
+         * Maps each router of the alias set (see AliasSet::getRouterID()) to the (first) router of 
+         * this neighborhood it contains, instead of scanning routers for each interface.
+         */
+        
+        AliasSet *aliasSet = env->getAliasSet();
+        IPLookUpTable *table = env->getIPTable();
+        map<unsigned int, Router*> routerOf;
+        for(list<Router*>::iterator i = routers->begin(); i != routers->end(); ++i)
         {
-            if(cur->isHedera())
-            {
-                (*out) << "Neighborhood/Hedera {";
-                bool guardian = false;
-                for(list<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
-                {
-                    if (guardian)
-                        (*out) << ", ";
-                    else
-                        guardian = true;
-                
-                    (*out) << (*i);
-                }
-                (*out) << "}\n";
-            }
-            else
-            {
-                (*out) << "Neighborhood {" << labels->front() << "}\n";
-            }
+            IPTableEntry *first = table->lookUp((*i)->getInterfacesList()->front()->ip);
+            if(first == NULL)
+                continue;
+            
+            unsigned int routerID = aliasSet->getRouterID(first);
+            if(routerID > 0)
+                routerOf.insert(pair<unsigned int, Router*>(routerID, (*i)));
         }
-    
-        if(cur->isHedera())
+        
+        list<InetAddress> lastHops;
+        list<list<InetAddress> > sets = cur->listInterfacesByLastHop(&lastHops);
+        
+        while(sets.size() > 0)
         {
-            list<InetAddress> lastHops;
-            list<list<InetAddress> > sets = cur->listInterfacesByLastHop(&lastHops);
+            list<InetAddress> curGroup = sets.front();
+            InetAddress curLastHop = lastHops.front();
+            
+            /*
+             * Lists routers which contain the IPs from "curGroup" (in order of first IP). Once a 
+             * router is listed, all its aliases are considered as covered, such that an IP 
+             * shared by several routers does not bring another router in the list.
+             */
             
-            while(sets.size() > 0)
+            list<Router*> curRouters;
+            set<unsigned int> covered;
+            for(list<InetAddress>::iterator i = curGroup.begin(); i != curGroup.end(); ++i)
             {
-                list<InetAddress> curGroup = sets.front();
-                InetAddress curLastHop = lastHops.front();
+                IPTableEntry *entry = table->lookUp((*i));
+                if(entry == NULL)
+                    continue;
                 
-                // Lists routers which contain the IPs from "curGroup"
-                list<Router*> curRouters;
-                for(list<InetAddress>::iterator i = curGroup.begin(); i != curGroup.end(); ++i)
-                {
-                    InetAddress curIP = (*i);
-                    for(list<Router*>::iterator j = routers->begin(); j != routers->end(); ++j)
-                    {
-                        Router *curRouter = (*j);
-                        if(curRouter->hasInterface(curIP))
-                        {
-                            curRouters.push_back(curRouter);
-                            
-                            // Removes interfaces of curRouter from "curGroup" list
-                            list<InetAddress>::iterator start = i;
-                            for(list<InetAddress>::iterator k = ++start; k != curGroup.end(); ++k)
-                            {
-                                if(curRouter->hasInterface((*k)))
-                                    curGroup.erase(k--);
-                            }
-                            curGroup.erase(i--);
-                            break;
-                        }
-                    }
-                }
+                unsigned int routerID = aliasSet->getRouterID(entry);
+                if(routerID == 0 || covered.find(routerID) != covered.end())
+                    continue;
                 
-                if(curRouters.size() > 0)
-                {
-                    (*out) << "Last hop = " << curLastHop << ":" << endl;
-                    this->evaluate(curRouters);
-                }
+                map<unsigned int, Router*>::iterator res = routerOf.find(routerID);
+                if(res == routerOf.end())
+                    continue;
                 
-                lastHops.pop_front();
-                sets.pop_front();
+                curRouters.push_back(res->second);
+                covered.insert(routerID);
             }
+            
+            if(curRouters.size() > 0)
+            {
+                (*out) << "Last hop = " << curLastHop << ":" << endl;
+                this->evaluate(curRouters, out);
+            }
+            
+            lastHops.pop_front();
+            sets.pop_front();
         }
-        else
-        {
-            this->evaluate(*routers);
-        }
-        
-        // Goes deeper
-        list<NetworkTreeNode*> *children = cur->getChildren();
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
-        {
-            this->climbRecursive((*i));
-        }
+    }
+    else
+    {
+        this->evaluate(*routers, out);
     }
 }
@@ -27,10 +27,10 @@ public:
 protected:
 
     // Method to evaluate probability of having L2 in a (sub-)neighborhood (as a list of routers)
-    void evaluate(list<Router*> routers);
+    void evaluate(list<Router*> routers, ostream *out);
 
-    // Method to recursively "climb" the tree, node by node.
-    void climbRecursive(NetworkTreeNode *cur);
+    // Method to evaluate a single neighborhood (see Climber::climbInParallel()).
+    void visit(NetworkTreeNode *cur, unsigned short depth, ostream *out); // Implicitely virtual
 };
 
 #endif /* TERMITE_H_ */
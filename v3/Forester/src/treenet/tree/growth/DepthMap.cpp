@@ -0,0 +1,116 @@
+/*
+ * DepthMap.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in DepthMap.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include "DepthMap.h"
+
+DepthMap::DepthMap(unsigned short maxDepth)
+{
+    this->maxDepth = maxDepth;
+    this->labelIndex = new map<InetAddress, NodesByRank>[maxDepth];
+    this->registrations = new map<NetworkTreeNode*, Registration>[maxDepth];
+    this->nextRank = 0;
+}
+
+DepthMap::~DepthMap()
+{
+    delete[] labelIndex;
+    delete[] registrations;
+}
+
+void DepthMap::add(NetworkTreeNode *node, unsigned short depth)
+{
+    Registration newReg;
+    newReg.rank = nextRank++;
+    pair<map<NetworkTreeNode*, Registration>::iterator, bool> res;
+    res = registrations[depth].insert(pair<NetworkTreeNode*, Registration>(node, newReg));
+    if(!res.second)
+        return;
+
+    vector<InetAddress> *labels = node->getLabels();
+    for(vector<InetAddress>::iterator i = labels->begin(); i != labels->end(); ++i)
+        this->addLabel(node, depth, (*i));
+}
+
+void DepthMap::remove(NetworkTreeNode *node, unsigned short depth)
+{
+    map<NetworkTreeNode*, Registration>::iterator res = registrations[depth].find(node);
+    if(res == registrations[depth].end())
+        return;
+
+    Registration *reg = &(res->second);
+    for(list<InetAddress>::iterator i = reg->labels.begin(); i != reg->labels.end(); ++i)
+    {
+        map<InetAddress, NodesByRank>::iterator nodes = labelIndex[depth].find((*i));
+        if(nodes == labelIndex[depth].end())
+            continue;
+
+        nodes->second.erase(reg->rank);
+        if(nodes->second.size() == 0)
+            labelIndex[depth].erase(nodes);
+        
+        map<unsigned short, unsigned int> *depths = &(labelDepths[(*i)]);
+        map<unsigned short, unsigned int>::iterator count = depths->find(depth);
+        if(count != depths->end() && --(count->second) == 0)
+            depths->erase(count);
+        if(depths->size() == 0)
+            labelDepths.erase((*i));
+    }
+    registrations[depth].erase(res);
+}
+
+void DepthMap::addLabel(NetworkTreeNode *node, unsigned short depth, InetAddress label)
+{
+    map<NetworkTreeNode*, Registration>::iterator res = registrations[depth].find(node);
+    if(res == registrations[depth].end())
+        return;
+
+    Registration *reg = &(res->second);
+    NodesByRank *nodes = &(labelIndex[depth][label]);
+    if(nodes->insert(pair<unsigned long, NetworkTreeNode*>(reg->rank, node)).second)
+    {
+        reg->labels.push_back(label);
+        labelDepths[label][depth]++;
+    }
+}
+
+NetworkTreeNode *DepthMap::find(unsigned short depth, InetAddress label, NetworkTreeNode *excluded)
+{
+    map<InetAddress, NodesByRank>::iterator nodes = labelIndex[depth].find(label);
+    if(nodes == labelIndex[depth].end())
+        return NULL;
+
+    for(NodesByRank::iterator i = nodes->second.begin(); i != nodes->second.end(); ++i)
+        if(i->second != excluded)
+            return i->second;
+    return NULL;
+}
+
+NetworkTreeNode *DepthMap::findShallowest(InetAddress label, unsigned short *depth)
+{
+    map<InetAddress, map<unsigned short, unsigned int> >::iterator depths = labelDepths.find(label);
+    if(depths == labelDepths.end() || depths->second.size() == 0)
+        return NULL;
+
+    (*depth) = depths->second.begin()->first;
+    return this->find((*depth), label);
+}
+
+list<NetworkTreeNode*> DepthMap::listNodes(unsigned short depth)
+{
+    NodesByRank sorted;
+    map<NetworkTreeNode*, Registration>::iterator i;
+    for(i = registrations[depth].begin(); i != registrations[depth].end(); ++i)
+        sorted.insert(pair<unsigned long, NetworkTreeNode*>(i->second.rank, i->first));
+
+    list<NetworkTreeNode*> result;
+    for(NodesByRank::iterator j = sorted.begin(); j != sorted.end(); ++j)
+        result.push_back(j->second);
+    return result;
+}
@@ -0,0 +1,93 @@
+/*
+ * DepthMap.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * DepthMap keeps track of the internal nodes of a tree being grown, depth by depth, along with an
+ * index of their labels. It replaces the array of node lists which growers used to scan entirely
+ * (calling NetworkTreeNode::hasLabel() on each node) to find the node of a given depth having a
+ * given label, which made tree growth quadratic in the amount of subnets.
+ *
+ * For each depth, a map gives the nodes having a given label. When several nodes share a label
+ * (which can only occur with the label of missing hops, 0.0.0.0), they are sorted by order of
+ * registration, such that look-ups return the same node as the former scan of the node list.
+ * The index must be kept up to date by the grower: new labels of a node are registered with
+ * addLabel() and deleted nodes are removed with remove(). The labels indexed for a node are
+ * saved by DepthMap itself, since NetworkTreeNode::merge() and the handling of labels while
+ * merging nodes can empty the label list of a node before it is removed.
+ *
+ * A second index gives, for each label, the depths where it appears, such that the shallowest 
+ * node having a given label (as looked up by GrafterGrower when it transplants a route) is found 
+ * without visiting every depth.
+ */
+
+#ifndef DEPTHMAP_H_
+#define DEPTHMAP_H_
+
+#include <list>
+using std::list;
+#include <map>
+using std::map;
+using std::pair;
+
+#include "../NetworkTreeNode.h"
+
+class DepthMap
+{
+public:
+
+    // Constructor (maxDepth = amount of depth levels), destructor
+    DepthMap(unsigned short maxDepth);
+    ~DepthMap();
+
+    // Registers a node at a given depth, along with its current labels
+    void add(NetworkTreeNode *node, unsigned short depth);
+
+    // Removes a node (and its labels) from the given depth; nothing happens if it is not there
+    void remove(NetworkTreeNode *node, unsigned short depth);
+
+    // Registers a new label of a node already registered at the given depth
+    void addLabel(NetworkTreeNode *node, unsigned short depth, InetAddress label);
+
+    /*
+     * Finds the first registered node of the given depth having the given label, the "excluded"
+     * node being ignored. Returns NULL if there is no such node.
+     */
+
+    NetworkTreeNode *find(unsigned short depth, InetAddress label, NetworkTreeNode *excluded = NULL);
+
+    /*
+     * Finds the first registered node having the given label at the smallest depth where this 
+     * label appears, and writes this depth in the second parameter. Returns NULL if no node has 
+     * this label.
+     */
+
+    NetworkTreeNode *findShallowest(InetAddress label, unsigned short *depth);
+
+    // Lists the nodes of a given depth, in order of registration
+    list<NetworkTreeNode*> listNodes(unsigned short depth);
+
+    inline unsigned short getMaxDepth() { return this->maxDepth; }
+
+private:
+
+    // Registration data of a node
+    struct Registration
+    {
+        unsigned long rank; // Order of registration
+        list<InetAddress> labels; // Indexed labels
+    };
+
+    // Nodes having a given label, sorted by rank
+    typedef map<unsigned long, NetworkTreeNode*> NodesByRank;
+
+    unsigned short maxDepth;
+    map<InetAddress, NodesByRank> *labelIndex; // One map per depth
+    map<NetworkTreeNode*, Registration> *registrations; // Idem
+    map<InetAddress, map<unsigned short, unsigned int> > labelDepths; // Label -> depth -> #nodes
+    unsigned long nextRank;
+
+};
+
+#endif /* DEPTHMAP_H_ */
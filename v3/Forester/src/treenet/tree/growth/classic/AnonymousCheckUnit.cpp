@@ -28,7 +28,11 @@ toReprobe(tR)
     {
         unsigned short protocol = env->getProbingProtocol();
     
-        if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
+        if(env->getSimulatedNetwork() != NULL)
+        {
+            prober = env->newSimulatedProber(env->getTimeoutPeriod(), lbii, ubii, lbis, ubis);
+        }
+        else if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
         {
             int roundRobinSocketCount = DirectProber::DEFAULT_TCP_UDP_ROUND_ROBIN_SOCKET_COUNT;
             if(env->usingFixedFlowID())
@@ -71,6 +75,8 @@ toReprobe(tR)
                                           ubis, 
                                           env->debugMode());
         }
+        
+        env->registerProber(prober, ProbeTrace::PHASE_ANONYMOUS_CHECK);
     }
     catch(SocketException &se)
     {
@@ -161,7 +167,7 @@ void AnonymousCheckUnit::run()
             
             if(probeRecord == NULL)
             {
-                Thread::invokeSleep(TimeVal(1, 0)); // Default timeout being 1s, we keep a rate of max. 0,5 probe/s
+                env->pauseProbing(TimeVal(1, 0)); // Default timeout being 1s, we keep a rate of max. 0,5 probe/s
                 continue;
             }
             
@@ -172,7 +178,7 @@ void AnonymousCheckUnit::run()
                 parent->callback(curSubnet, i, probeRecord->getRplyAddress());
                 parentMutex.unlock();
                 
-                Thread::invokeSleep(TimeVal(2, 0));
+                env->pauseProbing(TimeVal(2, 0));
             }
             
             delete probeRecord;
@@ -8,6 +8,8 @@
  * goals of such class).
  */
 
+#include <algorithm>
+
 #include "AnonymousChecker.h"
 #include "AnonymousCheckUnit.h"
 #include "../../../../common/thread/Thread.h"
@@ -194,7 +196,7 @@ void AnonymousChecker::probe()
     for(unsigned int i = 0; i < trueNbThreads; i++)
     {
         th[i]->start();
-        Thread::invokeSleep(env->getProbeThreadDelay());
+        env->pauseProbing(env->getProbeThreadDelay());
     }
     
     for(unsigned int i = 0; i < trueNbThreads; i++)
@@ -214,33 +216,19 @@ void AnonymousChecker::probe()
 
 // Implementation of private methods.
 
-bool AnonymousChecker::similarAnonymousHops(SubnetSite *ss1, SubnetSite *ss2)
+bool AnonymousChecker::HopContext::operator<(const HopContext &other) const
 {
-    unsigned short sizeRouteSs1 = ss1->getRouteSize();
-    unsigned short sizeRouteSs2 = ss2->getRouteSize();
-    RouteInterface *routeSs1 = ss1->getRoute();
-    RouteInterface *routeSs2 = ss2->getRoute();
-    for(unsigned short i = 1; i < sizeRouteSs1 - 1; i++) // We don't fix offline first/last hop (risky)
-    {
-        if(i >= sizeRouteSs2 - 1)
-            break;
-        
-        if(routeSs1[i].ip == InetAddress(0))
-        {
-            InetAddress hopBefore = routeSs1[i - 1].ip;
-            InetAddress hopAfter = routeSs1[i + 1].ip;
-            
-            if(routeSs2[i - 1].ip == hopBefore && routeSs2[i + 1].ip == hopAfter)
-                return true;
-        }
-    }
-    return false;
+    if(this->hop != other.hop)
+        return this->hop < other.hop;
+    if(this->before != other.before)
+        return this->before < other.before;
+    return this->after < other.after;
 }
 
 void AnonymousChecker::loadTargets()
 {
     // Lists subnets with incomplete routes
-    list<SubnetSite*> sparseRoutes;
+    vector<SubnetSite*> sparseRoutes;
     list<SubnetSite*> *fullList = this->env->getSubnetSet()->getSubnetSiteList();
     for(list<SubnetSite*>::iterator it = fullList->begin(); it != fullList->end(); it++)
     {
@@ -253,24 +241,82 @@ void AnonymousChecker::loadTargets()
         }
     }
     
-    for(list<SubnetSite*>::iterator it = sparseRoutes.begin(); it != sparseRoutes.end(); ++it)
+    /*
+     * Two routes are similar if, for a missing hop of the first one (neither the first nor the 
+     * last hop, as they are not fixed offline), the second one has the same hops just before and 
+     * after at the same positions. Each route is therefore grouped with the routes sharing one of 
+     * its contexts (hop before, hop after, position), all contexts of each route being listed in 
+     * a single pass rather than comparing each pair of routes.
+     */
+    
+    map<HopContext, list<unsigned int> > groups;
+    for(unsigned int i = 0; i < sparseRoutes.size(); i++)
     {
-        SubnetSite *cur = (*it);
+        unsigned short routeSize = sparseRoutes[i]->getRouteSize();
+        RouteInterface *route = sparseRoutes[i]->getRoute();
+        for(unsigned short j = 1; j < routeSize - 1; j++)
+        {
+            HopContext context;
+            context.hop = j;
+            context.before = route[j - 1].ip;
+            context.after = route[j + 1].ip;
+            groups[context].push_back(i);
+        }
+    }
+    
+    /*
+     * Each route which is not similar to a previous target becomes a target itself, and the 
+     * following routes sharing the context of one of its missing hops are fixed offline with it. 
+     * Once visited, a group cannot provide similar routes anymore (its routes coming after the 
+     * current target are now all taken care of), hence its removal.
+     */
+    
+    vector<bool> handled(sparseRoutes.size(), false);
+    for(unsigned int i = 0; i < sparseRoutes.size(); i++)
+    {
+        if(handled[i])
+            continue;
+        
+        SubnetSite *cur = sparseRoutes[i];
         this->targetSubnets.push_back(cur);
+        handled[i] = true;
         
         // Lists subnets which have similar missing steps
-        list<SubnetSite*> similar;
-        list<SubnetSite*>::iterator start = it;
-        for(list<SubnetSite*>::iterator it2 = ++start; it2 != sparseRoutes.end(); ++it2)
+        unsigned short routeSize = cur->getRouteSize();
+        RouteInterface *route = cur->getRoute();
+        vector<unsigned int> similarIndexes;
+        for(unsigned short j = 1; j < routeSize - 1; j++)
         {
-            SubnetSite *cur2 = (*it2);
-            if(similarAnonymousHops(cur, cur2))
+            if(route[j].ip != InetAddress(0))
+                continue;
+            
+            HopContext context;
+            context.hop = j;
+            context.before = route[j - 1].ip;
+            context.after = route[j + 1].ip;
+            
+            map<HopContext, list<unsigned int> >::iterator group = groups.find(context);
+            if(group == groups.end())
+                continue;
+            
+            list<unsigned int> *members = &(group->second);
+            for(list<unsigned int>::iterator it = members->begin(); it != members->end(); ++it)
             {
-                similar.push_back(cur2);
-                sparseRoutes.erase(it2--);
+                if((*it) > i && !handled[(*it)])
+                {
+                    similarIndexes.push_back((*it));
+                    handled[(*it)] = true;
+                }
             }
+            groups.erase(group);
         }
         
+        // Similar subnets are listed in the order of the subnet set
+        std::sort(similarIndexes.begin(), similarIndexes.end());
+        list<SubnetSite*> similar;
+        for(vector<unsigned int>::iterator it = similarIndexes.begin(); it != similarIndexes.end(); ++it)
+            similar.push_back(sparseRoutes[(*it)]);
+        
         this->toFixOffline.insert(pair<SubnetSite*, list<SubnetSite*> >(cur, similar));
     }
 }
@@ -27,6 +27,8 @@
 #include <map>
 using std::map;
 using std::pair;
+#include <vector>
+using std::vector;
 
 #include "../../../TreeNETEnvironment.h"
 
@@ -82,7 +84,15 @@ private:
     
     map<SubnetSite*, list<SubnetSite*> > toFixOffline;
     
-    static bool similarAnonymousHops(SubnetSite *ss1, SubnetSite *ss2); // True if fit for fix
+    // Context of a hop (position in the route and surrounding hops), to group similar routes
+    struct HopContext
+    {
+        unsigned short hop;
+        InetAddress before, after;
+        
+        bool operator<(const HopContext &other) const;
+    };
+    
     void loadTargets(); // Lists targets
     
 }; 
@@ -10,6 +10,9 @@
 
 #include <list>
 using std::list;
+#include <algorithm>
+using std::sort;
+using std::unique;
 
 #include "../../../../common/thread/Thread.h"
 #include "ClassicGrower.h"
@@ -17,23 +20,25 @@ using std::list;
 #include "AnonymousChecker.h"
 #include "RoutePostProcessor.h"
 
-ClassicGrower::ClassicGrower(TreeNETEnvironment *env) : Grower(env)
+ClassicGrower::ClassicGrower(TreeNETEnvironment *env, bool verifyRoutes) : Grower(env)
 {
     /*
      * About maxDepth parameter: it is the size of the longest route to a subnet which should be 
-     * inserted in the tree. It is used as the size of the depthMap array (i.e. one list of nodes 
-     * per depth level), which should be maintained throughout the life of the tree to ease the 
-     * insertion step (re-building the whole map at each insertion is costly).
+     * inserted in the tree. It is used as the amount of levels of the depth map (i.e. the nodes 
+     * and their labels per depth level), which should be maintained throughout the life of the 
+     * tree to ease the insertion step (re-building the whole map at each insertion is costly).
      */
 
     unsigned short maxDepth = env->getSubnetSet()->getMaximumDistance();
-    this->depthMap = new list<NetworkTreeNode*>[maxDepth];
+    this->depthMap = new DepthMap(maxDepth);
     this->tree = NULL;
+    this->incremental = false;
+    this->verifyRoutes = verifyRoutes;
 }
 
 ClassicGrower::~ClassicGrower()
 {
-    delete[] depthMap;
+    delete depthMap;
 }
 
 unsigned int ClassicGrower::countIncompleteRoutes()
@@ -43,7 +48,7 @@ unsigned int ClassicGrower::countIncompleteRoutes()
     for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
     {
         SubnetSite *curSubnet = (*it);
-        if(curSubnet->getRoute() != NULL)
+        if(curSubnet->hasValidRoute())
         {
             if(curSubnet->hasIncompleteRoute())
                 nbIncompleteRoutes++;
@@ -52,11 +57,10 @@ unsigned int ClassicGrower::countIncompleteRoutes()
     return nbIncompleteRoutes;
 }
 
-unsigned short ClassicGrower::repairRouteOffline(SubnetSite *ss)
+unsigned short ClassicGrower::repairRouteOffline(SubnetSite *ss, RepairOptionIndex *index)
 {
     unsigned short routeSize = ss->getRouteSize();
     RouteInterface *route = ss->getRoute();
-    list<SubnetSite*> *ssList = env->getSubnetSet()->getSubnetSiteList();
     
     /*
      * Exceptional case: there is only one hop. In that case, we fix it only if there is a single 
@@ -65,32 +69,11 @@ unsigned short ClassicGrower::repairRouteOffline(SubnetSite *ss)
     
     if(routeSize == 1)
     {
-        list<InetAddress> options;
-        for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
-        {
-            SubnetSite *ss2 = (*it);
-            unsigned short routeSize2 = ss2->getRouteSize();
-            if(routeSize2 > 0)
-            {
-                RouteInterface *route2 = ss2->getRoute();
-                options.push_back(route2[0].ip);
-            }
-        }
-        
-        // Filtering out duplicates
-        options.sort(InetAddress::smaller);
-        InetAddress prev(0);
-        for(list<InetAddress>::iterator it = options.begin(); it != options.end(); ++it)
-        {
-            if((*it) == prev)
-                options.erase(it--);
-            else
-                prev = (*it);
-        }
-        
-        if(options.size() == 1)
+        set<InetAddress> *options = index->getFirstHops();
+        if(options->size() == 1)
         {
-            route[0].repair(options.front());
+            route[0].repair(*(options->begin()));
+            index->indexRepairedHop(ss, 0);
             return 1;
         }
     
@@ -111,37 +94,12 @@ unsigned short ClassicGrower::repairRouteOffline(SubnetSite *ss)
         if(hopBefore == InetAddress(0) || hopAfter == InetAddress(0))
             continue;
         
-        // Lists the options
-        list<InetAddress> options;
-        for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
-        {
-            SubnetSite *ss2 = (*it);
-            unsigned short routeSize2 = ss2->getRouteSize();
-            if(routeSize2 > i + 1)
-            {
-                RouteInterface *route2 = ss2->getRoute();
-                if(route2[i].ip == InetAddress(0))
-                    continue;
-                if((i == 0 || hopBefore == route2[i - 1].ip) && hopAfter == route2[i + 1].ip)
-                    options.push_back(route2[i].ip);
-            }
-        }
-        
-        // Filtering out duplicates
-        options.sort(InetAddress::smaller);
-        InetAddress prev(0);
-        for(list<InetAddress>::iterator it = options.begin(); it != options.end(); ++it)
-        {
-            if((*it) == prev)
-                options.erase(it--);
-            else
-                prev = (*it);
-        }
-        
         // Replaces if and only if there is a single option.
-        if(options.size() == 1)
+        set<InetAddress> *options = index->getOptions(i, hopBefore, hopAfter);
+        if(options != NULL && options->size() == 1)
         {
-            route[i].repair(options.front());
+            route[i].repair(*(options->begin()));
+            index->indexRepairedHop(ss, i);
             nbReplacements++;
         }
     }
@@ -160,19 +118,30 @@ void ClassicGrower::prepare()
      * The route computation itself is base on the same ideas as Paris Traceroute, and is 
      * parallelized to quickly obtain all routes.
      *
+     * When routes are verified, each task first probes the known route to its subnet at a few 
+     * TTLs and only re-computes it if the replies differ from the known hops (see 
+     * ParisTracerouteTask).
      */
     
     ostream *out = env->getOutputStream();
     SubnetSiteSet *subnets = env->getSubnetSet();
     unsigned short nbThreads = env->getMaxThreads();
     unsigned short displayMode = env->getDisplayMode();
+    env->getTelemetry()->enterStep(Telemetry::STEP_TRACEROUTE);
     
     list<SubnetSite*> *ssList = subnets->getSubnetSiteList();
     list<SubnetSite*> toSchedule(*ssList);
     
+    // Routes are edited in place from now on, so they cannot be shared anymore
+    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
+        (*it)->unshareRoutes();
+    
     if(toSchedule.size() > 0)
     {
-        (*out) << "Getting the route to each subnet...\n" << endl;
+        if(verifyRoutes)
+            (*out) << "Verifying the route to each subnet...\n" << endl;
+        else
+            (*out) << "Getting the route to each subnet...\n" << endl;
 
         // Size of the thread array
         unsigned short sizeParisArray = 0;
@@ -210,7 +179,8 @@ void ClassicGrower::prepare()
                                                    DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + lowBound, 
                                                    DirectProber::DEFAULT_LOWER_SRC_PORT_ICMP_ID + upBound, 
                                                    DirectProber::DEFAULT_LOWER_DST_PORT_ICMP_SEQ, 
-                                                   DirectProber::DEFAULT_UPPER_DST_PORT_ICMP_SEQ);
+                                                   DirectProber::DEFAULT_UPPER_DST_PORT_ICMP_SEQ, 
+                                                   verifyRoutes);
                     parisTh[i] = new Thread(task);
                 }
                 catch(SocketException e)
@@ -257,7 +227,7 @@ void ClassicGrower::prepare()
                 if(parisTh[i] != NULL)
                 {
                     parisTh[i]->start();
-                    Thread::invokeSleep(env->getProbeThreadDelay());
+                    env->pauseProbing(env->getProbeThreadDelay());
                 }
             }
             
@@ -361,6 +331,7 @@ void ClassicGrower::prepare()
      */
     
     // Step 1
+    env->getTelemetry()->enterStep(Telemetry::STEP_REPAIR);
     unsigned int nbIncomplete = countIncompleteRoutes();
     if(nbIncomplete == 0)
     {
@@ -436,21 +407,27 @@ void ClassicGrower::prepare()
     else
         (*out) << "Found one incomplete route. Starting offline repairment..." << endl;
     
+    // Options for each missing hop are indexed once, then updated as hops get repaired
+    RepairOptionIndex *repairIndex = new RepairOptionIndex();
+    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
+        repairIndex->indexRoute((*it));
+    
     unsigned int nbRepairments = 0; // Amount of 0.0.0.0's being replaced
     unsigned int fullyRepaired = 0; // Amount of routes fully repaired
     for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
     {
         SubnetSite *curSubnet = (*it);
-        if(curSubnet->getRoute() != NULL)
+        if(curSubnet->hasValidRoute())
         {
             if(curSubnet->hasIncompleteRoute())
             {
-                nbRepairments += this->repairRouteOffline(curSubnet);
+                nbRepairments += this->repairRouteOffline(curSubnet, repairIndex);
                 if(curSubnet->hasCompleteRoute())
                     fullyRepaired++;
             }
         }
     }
+    delete repairIndex;
      
     if(nbRepairments == 0)
     {
@@ -487,7 +464,7 @@ void ClassicGrower::prepare()
     fullyRepaired = 0;
     AnonymousChecker *checker = NULL;
     
-    Thread::invokeSleep(TimeVal(60, 0)); // Pause of 1 minute before probing again
+    env->pauseProbing(TimeVal(60, 0)); // Pause of 1 minute before probing again
     
     try
     {
@@ -507,7 +484,7 @@ void ClassicGrower::prepare()
             {
                 (*out) << "Starting a second opinion..." << endl;
                 
-                Thread::invokeSleep(TimeVal(60, 0));
+                env->pauseProbing(TimeVal(60, 0));
                 
                 checker->reload();
                 checker->probe();
@@ -561,6 +538,8 @@ void ClassicGrower::prepare()
 
 void ClassicGrower::postProcessRoutes()
 {
+    env->getTelemetry()->enterStep(Telemetry::STEP_POST_PROCESSING);
+    
     // Before actual post-processing, changes placeholder IPs back to 0.0.0.0
     SubnetSiteSet *subnets = env->getSubnetSet();
     list<SubnetSite*> *ssList = subnets->getSubnetSiteList();
@@ -620,15 +599,98 @@ void ClassicGrower::grow()
     newSubnetMapEntries.clear();
 }
 
+void ClassicGrower::growIncrementally(Soil *soil)
+{
+    ostream *out = env->getOutputStream();
+    SubnetSiteSet *subnets = env->getSubnetSet();
+
+    subnets->sortByRoute();
+    
+    // Gets the tree to grow (a new one if the Soil object is empty)
+    list<NetworkTree*> *roots = soil->getRootsList();
+    if(roots->size() == 0)
+        soil->insertTree(new NetworkTree());
+    NetworkTree *soilTree = roots->front();
+    
+    /*
+     * The depth map is re-built if it does not index this tree yet (e.g., the tree was grown by 
+     * another grower) or if the new subnets are located further than its deepest level.
+     */
+    
+    unsigned short maxDepth = subnets->getMaximumDistance();
+    if(soilTree != this->tree || maxDepth > depthMap->getMaxDepth())
+    {
+        if(maxDepth < depthMap->getMaxDepth())
+            maxDepth = depthMap->getMaxDepth();
+        
+        delete depthMap;
+        this->depthMap = new DepthMap(maxDepth);
+        this->tree = soilTree;
+        
+        vector<NetworkTreeNode*> *children = tree->getRoot()->getChildren();
+        for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+            this->indexRecursive((*i), 0);
+    }
+    
+    this->result = soil;
+    this->incremental = true;
+    
+    // Removes the subnets which were measured again
+    unsigned int nbRemoved = 0;
+    list<SubnetSite*> *newSubnets = subnets->getSubnetSiteList();
+    for(list<SubnetSite*>::iterator i = newSubnets->begin(); i != newSubnets->end(); ++i)
+    {
+        unsigned short status = (*i)->getStatus();
+        if(status != SubnetSite::ACCURATE_SUBNET && 
+           status != SubnetSite::ODD_SUBNET && 
+           status != SubnetSite::SHADOW_SUBNET)
+            continue;
+        
+        list<SubnetMapEntry*> overlapping = soil->removeOverlappingEntries((*i));
+        for(list<SubnetMapEntry*>::iterator j = overlapping.begin(); j != overlapping.end(); ++j)
+        {
+            this->remove((*j));
+            nbRemoved++;
+        }
+    }
+    
+    // Inserts the new subnets, in the same order as in grow()
+    unsigned int nbInserted = 0;
+    SubnetSite *toInsert = subnets->getValidSubnet();
+    while(toInsert != NULL)
+    {
+        this->insert(toInsert);
+        nbInserted++;
+        toInsert = subnets->getValidSubnet();
+    }
+    
+    toInsert = subnets->getValidSubnet(false);
+    while(toInsert != NULL)
+    {
+        this->insert(toInsert);
+        nbInserted++;
+        toInsert = subnets->getValidSubnet(false);
+    }
+    
+    for(list<SubnetMapEntry*>::iterator i = newSubnetMapEntries.begin(); i != newSubnetMapEntries.end(); ++i)
+        soil->insertMapEntry((*i));
+    newSubnetMapEntries.clear();
+    
+    this->incremental = false;
+    
+    (*out) << "Removed " << nbRemoved << " re-measured subnet(s) from the tree and inserted ";
+    (*out) << nbInserted << " subnet(s)." << endl;
+}
+
 void ClassicGrower::insert(SubnetSite *subnet)
 {
     // Gets root of the tree
     NetworkTreeNode *rootNode = this->tree->getRoot();
-    list<NetworkTreeNode*> *map = this->depthMap;
+    DepthMap *map = this->depthMap;
 
     // Gets (final) route information of the new subnet
     unsigned short routeSize;
-    RouteInterface *route = subnet->getFinalRoute(&routeSize);
+    RouteView route = subnet->getFinalRoute(&routeSize);
     
     // Finds the deepest node which occurs in the route of current subnet
     NetworkTreeNode *insertionPoint = NULL;
@@ -638,18 +700,12 @@ void ClassicGrower::insert(SubnetSite *subnet)
         if(route[d - 1].ip == RouteInterface::MISSING)
             continue;
     
-        for(list<NetworkTreeNode*>::iterator i = map[d - 1].begin(); i != map[d - 1].end(); ++i)
-        {
-            if((*i)->hasLabel(route[d - 1].ip))
-            {
-                insertionPoint = (*i);
-                insertionPointDepth = d;
-                break;
-            }
-        }
-        
+        insertionPoint = map->find(d - 1, route[d - 1].ip);
         if(insertionPoint != NULL)
+        {
+            insertionPointDepth = d;
             break;
+        }
     }
     
     if(insertionPoint == NULL)
@@ -660,19 +716,27 @@ void ClassicGrower::insert(SubnetSite *subnet)
     if(insertionPoint != rootNode)
         subTree->addPreviousLabel(route[insertionPointDepth - 1].ip);
     insertionPoint->addChild(subTree);
+    if(incremental)
+        insertionPoint->markDirty();
 
     // Puts the new internal nodes inside the depth map
     NetworkTreeNode *next = subTree;
     NetworkTreeNode *subnetNode = NULL; // For subnet map entry
-    if(next->isInternal())
+    if(next->isLeaf())
+    {
+        subnetNode = next;
+    }
+    else if(next->isInternal())
     {
         unsigned short curDepth = insertionPointDepth;
         do
         {
-            map[curDepth].push_back(next);
+            map->add(next, curDepth);
+            if(incremental)
+                next->markDirty();
             curDepth++;
             
-            list<NetworkTreeNode*> *children = next->getChildren();
+            vector<NetworkTreeNode*> *children = next->getChildren();
             if(children != NULL && children->size() == 1)
             {
                 if(children->front()->isInternal())
@@ -706,6 +770,9 @@ void ClassicGrower::insert(SubnetSite *subnet)
         if(!cur->hasLabel(route[d - 2].ip))
         {
             cur->addLabel(route[d - 2].ip);
+            map->addLabel(cur, d - 2, route[d - 2].ip);
+            if(incremental)
+                cur->markDirty();
             
             /*
              * Look in depth map for a node at same depth sharing the new label. Indeed, if such
@@ -714,39 +781,20 @@ void ClassicGrower::insert(SubnetSite *subnet)
              * to be fidel to the topology.
              */
             
-            NetworkTreeNode *toMerge = NULL;
-            for(list<NetworkTreeNode*>::iterator i = map[d - 2].begin(); i != map[d - 2].end(); ++i)
-            {
-                if((*i) != cur && (*i)->hasLabel(route[d - 2].ip))
-                {
-                    toMerge = (*i);
-                    break;
-                }
-            }
-            
+            NetworkTreeNode *toMerge = map->find(d - 2, route[d - 2].ip, cur);
             if(toMerge != NULL)
             {
                 cur->merge(toMerge);
                 
                 // Add labels in toMerge absent from cur
-                list<InetAddress> *labels1 = cur->getLabels();
-                list<InetAddress> *labels2 = toMerge->getLabels();
-                labels1->merge((*labels2));
-                labels1->sort(InetAddress::smaller);
-                InetAddress prev(0);
-                bool first = true; // Avoids incoherent behavior with labels 0.0.0.0
-                for(list<InetAddress>::iterator i = labels1->begin(); i != labels1->end(); ++i)
-                {
-                    if(!first)
-                    {
-                        if((*i) == prev)
-                        {
-                            labels1->erase(i--);
-                        }
-                    }
-                    prev = (*i);
-                    first = false;
-                }
+                vector<InetAddress> *labels1 = cur->getLabels();
+                vector<InetAddress> *labels2 = toMerge->getLabels();
+                for(vector<InetAddress>::iterator i = labels2->begin(); i != labels2->end(); ++i)
+                    map->addLabel(cur, d - 2, (*i));
+                labels1->insert(labels1->end(), labels2->begin(), labels2->end());
+                labels2->clear();
+                sort(labels1->begin(), labels1->end());
+                labels1->erase(unique(labels1->begin(), labels1->end()), labels1->end());
                 
                 this->prune(toMerge, NULL, d - 2);
                 
@@ -765,7 +813,7 @@ void ClassicGrower::insert(SubnetSite *subnet)
 
 void ClassicGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned short depth)
 {
-    list<NetworkTreeNode*> *map = this->depthMap;
+    DepthMap *map = this->depthMap;
 
     if(cur->isLeaf())
     {
@@ -777,18 +825,11 @@ void ClassicGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
     {
         if(prev != NULL)
         {
-            list<NetworkTreeNode*> *children = cur->getChildren();
-            for(list<NetworkTreeNode*>::iterator i = map[0].begin(); i != map[0].end(); ++i)
-            {
-                if((*i) == prev)
-                {
-                    map[0].erase(i);
-                    break;
-                }
-            }
+            vector<NetworkTreeNode*> *children = cur->getChildren();
+            map->remove(prev, 0);
         
             // Erases prev from the children list (of this node) and stops
-            for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+            for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
             {
                 if((*i) == prev)
                 {
@@ -803,24 +844,16 @@ void ClassicGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
         return;
     }
     
-    list<NetworkTreeNode*> *children = cur->getChildren();
+    vector<NetworkTreeNode*> *children = cur->getChildren();
 
     // Current node has multiple children; keep it but remove prev
     if(children->size() > 1)
     {
         // Erases prev from the depth map
-        unsigned dPrev = depth + 1;
-        for(list<NetworkTreeNode*>::iterator i = map[dPrev].begin(); i != map[dPrev].end(); ++i)
-        {
-            if((*i) == prev)
-            {
-                map[dPrev].erase(i);
-                break;
-            }
-        }
+        map->remove(prev, depth + 1);
     
         // Erases prev from the children list (of this node) and stops
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+        for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
         {
             if((*i) == prev)
             {
@@ -834,15 +867,7 @@ void ClassicGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
     else if(children->size() == 1)
     {
         // Erases prev from the depth map
-        unsigned dPrev = depth + 1;
-        for(list<NetworkTreeNode*>::iterator i = map[dPrev].begin(); i != map[dPrev].end(); ++i)
-        {
-            if((*i) == prev)
-            {
-                map[dPrev].erase(i);
-                break;
-            }
-        }
+        map->remove(prev, depth + 1);
     
         delete prev;
         cur->getChildren()->clear();
@@ -855,10 +880,45 @@ void ClassicGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
     }
 }
 
+void ClassicGrower::remove(SubnetMapEntry *entry)
+{
+    NetworkTreeNode *leaf = entry->node;
+    delete entry;
+    if(leaf == NULL)
+        return;
+    
+    NetworkTreeNode *parent = leaf->getParent();
+    
+    // Marks the node where pruning will stop (i.e., its amount of children decreases)
+    NetworkTreeNode *stop = parent;
+    while(!stop->isRoot() && stop->getChildren()->size() == 1)
+        stop = stop->getParent();
+    stop->markDirty();
+    
+    // Depth of the parent in the depth map (children of the root are at depth 0)
+    unsigned short depth = 0;
+    for(NetworkTreeNode *cur = parent->getParent(); cur != NULL && !cur->isRoot(); cur = cur->getParent())
+        depth++;
+    
+    this->prune(parent, leaf, depth); // Also deletes the leaf (and therefore the subnet)
+}
+
+void ClassicGrower::indexRecursive(NetworkTreeNode *cur, unsigned short depth)
+{
+    if(!cur->isInternal())
+        return;
+    
+    depthMap->add(cur, depth);
+    
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+        this->indexRecursive((*i), depth + 1);
+}
+
 NetworkTreeNode *ClassicGrower::createBranch(SubnetSite *subnet, unsigned short depth)
 {
     unsigned short routeSize = 0;
-    RouteInterface *route = subnet->getFinalRoute(&routeSize);
+    RouteView route = subnet->getFinalRoute(&routeSize);
     
     // If current depth minus 1 equals the route size, then we just have to create a leaf
     if((depth - 1) == routeSize)
@@ -892,8 +952,8 @@ void ClassicGrower::listSubnetsRecursive(list<SubnetSite*> *subnetsList, Network
     }
     
     // Goes deeper in the tree
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         listSubnetsRecursive(subnetsList, (*i));
     }
@@ -14,36 +14,64 @@
 #define CLASSICGROWER_H_
 
 #include "../Grower.h"
+#include "../DepthMap.h"
+#include "RepairOptionIndex.h"
 
 class ClassicGrower : public Grower
 {
 public:
 
-    // Constructor, destructor
-    ClassicGrower(TreeNETEnvironment *env);
+    /*
+     * Constructor, destructor. When verifyRoutes is true, prepare() first checks the routes 
+     * known for each subnet with a few probes and only re-computes the routes which changed 
+     * (see ParisTracerouteTask).
+     */
+    
+    ClassicGrower(TreeNETEnvironment *env, bool verifyRoutes = false);
     ~ClassicGrower(); // Implicitely virtual
     
     void prepare(); // Implicitely virtual
     void grow(); // Implicitely virtual
+    
+    /*
+     * Incremental growth: rather than growing a new tree, inserts the (valid) subnets currently 
+     * in the subnet set of the environment in the tree of an existing Soil object (e.g., the 
+     * result of a previous call to grow()). Subnets of the tree overlapping the new ones are 
+     * considered as re-measured and are removed first, pruning the branches which no longer lead 
+     * to any subnet. Internal nodes touched by removals and insertions are marked as dirty (see 
+     * NetworkTreeNode), and the subnet map of the Soil object is updated entry by entry.
+     */
+    
+    void growIncrementally(Soil *soil);
 
 protected:
 
     /**** Fields ****/
 
-    // Depth map for tree construction, and the tree being grown
-    list<NetworkTreeNode*> *depthMap;
+    // Depth map (with label index) for tree construction, and the tree being grown
+    DepthMap *depthMap;
     NetworkTree *tree;
     
     // List of new subnet map entries (will be moved to the map in a Soil object)
     list<SubnetMapEntry*> newSubnetMapEntries;
     
+    // True during an incremental growth (touched internal nodes are then marked as dirty)
+    bool incremental;
+    
+    // True if prepare() should verify known routes before re-computing them
+    bool verifyRoutes;
+    
     /**** Private methods for route repairment and analysis ****/
     
     // Method to count the amount of incomplete routes seen in the set of subnets.
     unsigned int countIncompleteRoutes();
     
-    // Repairment of a route (see prepare()); returns the amount of replaced missing hops.
-    unsigned short repairRouteOffline(SubnetSite *ss);
+    /*
+     * Repairment of a route (see prepare()) with the options gathered in an index, which is 
+     * updated with each repaired hop; returns the amount of replaced missing hops.
+     */
+    
+    unsigned short repairRouteOffline(SubnetSite *ss, RepairOptionIndex *index);
     
     // Evaluates route stretching and route cycling and mitigates them
     void postProcessRoutes();
@@ -62,6 +90,12 @@ protected:
     
     void prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned short depth);
     
+    // Method to remove a subnet (given its map entry) from the tree, pruning its branch if needed
+    void remove(SubnetMapEntry *entry);
+    
+    // Recursive method to register the internal nodes of an existing tree in the depth map
+    void indexRecursive(NetworkTreeNode *cur, unsigned short depth);
+    
     // Static methods to create a branch and to visit one to list subnets (respectively)
     static NetworkTreeNode *createBranch(SubnetSite *subnet, unsigned short depth);
     static void listSubnetsRecursive(list<SubnetSite*> *subnetsList, NetworkTreeNode *cur);
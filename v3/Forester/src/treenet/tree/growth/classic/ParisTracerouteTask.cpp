@@ -16,16 +16,22 @@ ParisTracerouteTask::ParisTracerouteTask(TreeNETEnvironment *e,
                                          unsigned short lbii, 
                                          unsigned short ubii, 
                                          unsigned short lbis, 
-                                         unsigned short ubis):
+                                         unsigned short ubis, 
+                                         bool vf):
 env(e), 
 toDelete(td), 
-subnet(ss)
+subnet(ss), 
+verifyFirst(vf)
 {
     try
     {
         unsigned short protocol = env->getProbingProtocol();
     
-        if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
+        if(env->getSimulatedNetwork() != NULL)
+        {
+            prober = env->newSimulatedProber(env->getTimeoutPeriod(), lbii, ubii, lbis, ubis);
+        }
+        else if(protocol == TreeNETEnvironment::PROBING_PROTOCOL_UDP)
         {
             int roundRobinSocketCount = DirectProber::DEFAULT_TCP_UDP_ROUND_ROBIN_SOCKET_COUNT;
             if(env->usingFixedFlowID())
@@ -68,6 +74,8 @@ subnet(ss)
                                           ubis, 
                                           env->debugMode());
         }
+        
+        env->registerProber(prober, ProbeTrace::PHASE_TRACEROUTE);
     }
     catch(SocketException e)
     {
@@ -136,6 +144,91 @@ ProbeRecord *ParisTracerouteTask::probe(const InetAddress &dst, unsigned char TT
     return record;
 }
 
+bool ParisTracerouteTask::verifyRoute()
+{
+    unsigned short routeSize = subnet->getRouteSize();
+    RouteInterface *route = subnet->getRoute();
+    if(routeSize == 0 || route == NULL)
+        return false;
+    
+    list<InetAddress> pivots = subnet->getPivotAddresses(1);
+    if(pivots.size() == 0)
+        return false;
+    InetAddress probeDst = pivots.front();
+    
+    // Hops being checked: last hop, then middle hop (or the closest traced hop before it)
+    unsigned short hops[2];
+    unsigned short nbHops = 1;
+    hops[0] = routeSize - 1;
+    if(routeSize > 1)
+    {
+        unsigned short midHop = (routeSize - 1) / 2;
+        while(midHop > 0 && route[midHop].state != RouteInterface::VIA_TRACEROUTE && 
+              route[midHop].state != RouteInterface::LIMITED)
+            midHop--;
+        hops[1] = midHop;
+        nbHops = 2;
+    }
+    
+    TimeVal usedTimeout = prober->getTimeout();
+    bool confirmed = false; // True once a traced hop was seen again
+    for(unsigned short i = 0; i < nbHops; i++)
+    {
+        RouteInterface *knownHop = &route[hops[i]];
+        bool traced = (knownHop->state == RouteInterface::VIA_TRACEROUTE || 
+                       knownHop->state == RouteInterface::LIMITED);
+        if(i > 0 && !traced)
+            continue;
+        
+        unsigned char probeTTL = (unsigned char) hops[i] + 1;
+        ProbeRecord *check = this->probe(probeDst, probeTTL);
+        
+        // Traced hop does not reply: second chance with twice the timeout period
+        if(traced && check->getRplyAddress() == InetAddress(0))
+        {
+            delete check;
+            prober->setTimeout(usedTimeout * 2);
+            try
+            {
+                check = this->probe(probeDst, probeTTL);
+            }
+            catch(SocketException e)
+            {
+                prober->setTimeout(usedTimeout);
+                throw;
+            }
+            prober->setTimeout(usedTimeout);
+        }
+        
+        unsigned char rplyType = check->getRplyICMPtype();
+        InetAddress rplyAddress = check->getRplyAddress();
+        delete check;
+        
+        // Destination reached before the end of the route: the route got shorter
+        if(rplyType == DirectProber::ICMP_TYPE_ECHO_REPLY)
+            return false;
+        
+        /*
+         * A traced hop must reply with the same IP. Other hops (missing, repaired...) are only 
+         * consistent if they still do not reply or reply with the IP they were given, as a new 
+         * IP means a new traceroute can improve the route.
+         */
+        
+        if(traced)
+        {
+            if(rplyAddress != knownHop->ip)
+                return false;
+            confirmed = true;
+        }
+        else if(rplyAddress != InetAddress(0) && rplyAddress != knownHop->ip)
+        {
+            return false;
+        }
+    }
+    
+    return confirmed;
+}
+
 void ParisTracerouteTask::abort()
 {
     this->toDelete->push_back(subnet);
@@ -160,6 +253,37 @@ void ParisTracerouteTask::stop()
 
 void ParisTracerouteTask::run()
 {
+    // Verification of the known route (if requested)
+    if(verifyFirst)
+    {
+        bool unchanged = false;
+        try
+        {
+            unchanged = this->verifyRoute();
+        }
+        catch(SocketException e)
+        {
+            this->stop();
+            return;
+        }
+        
+        if(unchanged)
+        {
+            if(debugMode)
+                this->log += "\n"; // For airy display
+            this->log += "Route to " + subnet->getInferredNetworkAddressString() + " is unchanged.\n";
+            
+            TreeNETEnvironment::consoleMessagesMutex.lock();
+            ostream *out = env->getOutputStream();
+            (*out) << this->log << endl;
+            TreeNETEnvironment::consoleMessagesMutex.unlock();
+            return;
+        }
+        
+        if(debugMode)
+            this->log += "\nKnown route does not match replies; re-computing it...\n";
+    }
+    
     // Picks up to five pivot addresses for destination
     list<InetAddress> candidatesDst = subnet->getPivotAddresses(ParisTracerouteTask::MAX_PIVOT_CANDIDATES);
     if(candidatesDst.size() == 0)
@@ -22,6 +22,13 @@
  * labelling as provided still holds. If it finds out the former Contra-Pivot node is now a simple 
  * Pivot (because changing the VP also changed the way the subnet was positioned with respect to 
  * VP), the TTL of each responsive IP is double checked and unresponsive IPs are dropped.
+ *
+ * Note (16/10/2026): the task can also verify the route already known for the subnet before 
+ * re-computing it. A pivot IP of the subnet is then probed (with the same fixed flow as for the 
+ * traceroute) at the TTL of the last hop and of the middle hop of the known route. If the replies 
+ * match the known hops, the route is kept as is (including the state of each hop) and the task 
+ * stops there. Otherwise, the route is re-computed from scratch as usual. This turns the 
+ * re-measurement of a stable network into a few probes per subnet.
  */
 
 #ifndef PARISTRACEROUTETASK_H_
@@ -59,7 +66,8 @@ public:
                         unsigned short lowerBoundICMPid = DirectICMPProber::DEFAULT_LOWER_ICMP_IDENTIFIER,
                         unsigned short upperBoundICMPid = DirectICMPProber::DEFAULT_UPPER_ICMP_IDENTIFIER,
                         unsigned short lowerBoundICMPseq = DirectICMPProber::DEFAULT_LOWER_ICMP_SEQUENCE,
-                        unsigned short upperBoundICMPseq = DirectICMPProber::DEFAULT_UPPER_ICMP_SEQUENCE);
+                        unsigned short upperBoundICMPseq = DirectICMPProber::DEFAULT_UPPER_ICMP_SEQUENCE,
+                        bool verifyFirst = false);
     
     // Destructor, run method and print out method
     ~ParisTracerouteTask();
@@ -79,6 +87,17 @@ private:
     // Probing stuff
     DirectProber *prober;
     ProbeRecord *probe(const InetAddress &dst, unsigned char TTL);
+    
+    // True if the known route should be verified before being re-computed
+    bool verifyFirst;
+    
+    /*
+     * Verifies the known route with a few probes (see above) and returns true if it is unchanged. 
+     * Only hops obtained via traceroute can confirm a route; if none can be checked, the route is 
+     * considered as changed.
+     */
+    
+    bool verifyRoute();
 
     // "Abort" method (when we cannot recompute the route)
     void abort();
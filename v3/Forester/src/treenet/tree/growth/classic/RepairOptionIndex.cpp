@@ -0,0 +1,89 @@
+/*
+ * RepairOptionIndex.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in RepairOptionIndex.h (see this file to learn further about the
+ * goals of such class).
+ */
+
+#include "RepairOptionIndex.h"
+
+bool RepairOptionIndex::HopContext::operator<(const HopContext &other) const
+{
+    if(this->hop != other.hop)
+        return this->hop < other.hop;
+    if(this->before != other.before)
+        return this->before < other.before;
+    return this->after < other.after;
+}
+
+RepairOptionIndex::RepairOptionIndex()
+{
+}
+
+RepairOptionIndex::~RepairOptionIndex()
+{
+}
+
+void RepairOptionIndex::indexHop(RouteInterface *route, unsigned short routeSize, unsigned short hop)
+{
+    if(hop + 1 >= routeSize || route[hop].ip == InetAddress(0) || route[hop + 1].ip == InetAddress(0))
+        return;
+
+    HopContext context;
+    context.hop = hop;
+    context.before = InetAddress(0);
+    context.after = route[hop + 1].ip;
+    if(hop > 0)
+    {
+        context.before = route[hop - 1].ip;
+        if(context.before == InetAddress(0))
+            return;
+    }
+
+    options[context].insert(route[hop].ip);
+}
+
+void RepairOptionIndex::indexRoute(SubnetSite *ss)
+{
+    unsigned short routeSize = ss->getRouteSize();
+    RouteInterface *route = ss->getRoute();
+    if(routeSize == 0 || route == NULL)
+        return;
+
+    if(route[0].ip != InetAddress(0))
+        firstHops.insert(route[0].ip);
+
+    for(unsigned short i = 0; i < routeSize; i++)
+        this->indexHop(route, routeSize, i);
+}
+
+void RepairOptionIndex::indexRepairedHop(SubnetSite *ss, unsigned short hop)
+{
+    unsigned short routeSize = ss->getRouteSize();
+    RouteInterface *route = ss->getRoute();
+    if(hop >= routeSize || route == NULL)
+        return;
+
+    if(hop == 0)
+        firstHops.insert(route[0].ip);
+    else
+        this->indexHop(route, routeSize, hop - 1);
+    this->indexHop(route, routeSize, hop);
+    this->indexHop(route, routeSize, hop + 1);
+}
+
+set<InetAddress> *RepairOptionIndex::getOptions(unsigned short hop, InetAddress before, InetAddress after)
+{
+    HopContext context;
+    context.hop = hop;
+    context.before = before;
+    context.after = after;
+
+    map<HopContext, set<InetAddress> >::iterator res = options.find(context);
+    if(res == options.end())
+        return NULL;
+    return &(res->second);
+}
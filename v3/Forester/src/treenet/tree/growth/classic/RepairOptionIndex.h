@@ -0,0 +1,74 @@
+/*
+ * RepairOptionIndex.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * RepairOptionIndex gathers, for the offline route repairment of ClassicGrower, the hops which
+ * can replace a missing hop. An option for the missing hop at position i of a route is the hop
+ * found at the same position in another route, provided that both routes have the same (non-
+ * missing) hops at positions i - 1 and i + 1. Rather than scanning all routes for each missing
+ * hop, this class indexes each hop of each route with the context (position, previous hop, next
+ * hop) it appears in, such that listing the options of a missing hop is a single look-up. The
+ * distinct first hops of all routes are also indexed, as they are the options of routes
+ * consisting of a single (missing) hop.
+ *
+ * Hops are only indexed once they are known: a repaired hop must be notified with
+ * indexRepairedHop(), which also indexes the neighbouring hops of the same route which were
+ * so far in the context of a missing hop.
+ */
+
+#ifndef REPAIROPTIONINDEX_H_
+#define REPAIROPTIONINDEX_H_
+
+#include <map>
+using std::map;
+#include <set>
+using std::set;
+
+#include "../../../structure/SubnetSite.h"
+
+class RepairOptionIndex
+{
+public:
+
+    // Constructor, destructor
+    RepairOptionIndex();
+    ~RepairOptionIndex();
+
+    // Indexes all (known) hops of the route of a subnet
+    void indexRoute(SubnetSite *ss);
+
+    // Indexes a freshly repaired hop of the route of a subnet, along with its neighbouring hops
+    void indexRepairedHop(SubnetSite *ss, unsigned short hop);
+
+    /*
+     * Gets the distinct options for a hop at a given position, between two given hops. Returns
+     * NULL if there is no option.
+     */
+
+    set<InetAddress> *getOptions(unsigned short hop, InetAddress before, InetAddress after);
+
+    // Gets the distinct first hops of all routes
+    inline set<InetAddress> *getFirstHops() { return &firstHops; }
+
+private:
+
+    // Context of a hop: position in the route and surrounding hops
+    struct HopContext
+    {
+        unsigned short hop;
+        InetAddress before, after;
+
+        bool operator<(const HopContext &other) const;
+    };
+
+    map<HopContext, set<InetAddress> > options;
+    set<InetAddress> firstHops;
+
+    // Indexes a single hop of a route (nothing happens if the hop or its context is unknown)
+    void indexHop(RouteInterface *route, unsigned short routeSize, unsigned short hop);
+
+};
+
+#endif /* REPAIROPTIONINDEX_H_ */
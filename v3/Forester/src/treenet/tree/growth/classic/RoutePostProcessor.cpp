@@ -371,6 +371,9 @@ void RoutePostProcessor::mitigate()
      * -----------------------------------
      */
     
+    if(subnets.size() > 0)
+        this->indexRouteHops();
+    
     unsigned short stretchFixed = 0;
     for(list<SubnetSite*>::iterator it = subnets.begin(); it != subnets.end(); ++it)
     {
@@ -725,11 +728,31 @@ bool RoutePostProcessor::hasStretch(RouteInterface *route, unsigned short size)
     return false;
 }
 
+void RoutePostProcessor::indexRouteHops()
+{
+    list<SubnetSite*> *ssList = env->getSubnetSet()->getSubnetSiteList();
+    
+    routeHops.clear();
+    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
+    {
+        SubnetSite *curSubnet = (*it);
+        if(!curSubnet->hasValidRoute())
+            continue;
+        
+        unsigned short routeSize = curSubnet->getRouteSize();
+        RouteInterface *route = curSubnet->getRoute();
+        for(unsigned short i = 0; i < routeSize; i++)
+        {
+            // Only the first subnet with a given IP at a given position is kept
+            map<unsigned short, SubnetSite*> *positions = &(routeHops[route[i].ip]);
+            positions->insert(pair<unsigned short, SubnetSite*>(i, curSubnet));
+        }
+    }
+}
+
 RouteInterface* RoutePostProcessor::findPrefix(InetAddress stretched, unsigned short *size)
 {
-    SubnetSiteSet *set = env->getSubnetSet();
     IPLookUpTable *dict = env->getIPTable();
-    list<SubnetSite*> *ssList = set->getSubnetSiteList();
     
     // 1) Finds shortest TTL seen for this hop
     IPTableEntry *hop = dict->lookUp(stretched);
@@ -737,21 +760,20 @@ RouteInterface* RoutePostProcessor::findPrefix(InetAddress stretched, unsigned s
         return NULL;
     
     unsigned char TTL = hop->getTTL();
+    if(TTL == 0)
+        return NULL;
     
-    // 2) Inspects the routes of all subnets at that given hop
-    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
-    {
-        SubnetSite *curSubnet = (*it);
-        if(curSubnet->hasValidRoute() && curSubnet->getRouteSize() >= (unsigned short) TTL)
-        {
-            RouteInterface *route = curSubnet->getRoute();
-            if(route[(unsigned short) TTL - 1].ip == stretched)
-            {
-                (*size) = (unsigned short) TTL - 1;
-                return route;
-            }
-        }
-    }
+    // 2) Looks up the first route having this hop at the given TTL
+    map<InetAddress, map<unsigned short, SubnetSite*> >::iterator positions;
+    positions = routeHops.find(stretched);
+    if(positions == routeHops.end())
+        return NULL;
+    
+    map<unsigned short, SubnetSite*>::iterator res;
+    res = positions->second.find((unsigned short) TTL - 1);
+    if(res == positions->second.end())
+        return NULL;
     
-    return NULL;
+    (*size) = (unsigned short) TTL - 1;
+    return res->second->getRoute();
 }
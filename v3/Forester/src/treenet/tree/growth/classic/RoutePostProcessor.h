@@ -35,6 +35,9 @@
 #ifndef ROUTEPOSTPROCESSOR_H_
 #define ROUTEPOSTPROCESSOR_H_
 
+#include <map>
+using std::map;
+
 #include "../../../TreeNETEnvironment.h"
 
 class RoutePostProcessor
@@ -51,6 +54,15 @@ private:
     TreeNETEnvironment *env;
     bool printSteps; // To display steps of each route post-processing (slightly verbose mode)
     
+    /*
+     * Index of the measured routes: for each IP and each position (hop count - 1) where it 
+     * appears, the first subnet (in the subnet set) which measured route has this IP at this 
+     * position. Measured routes are never edited by the post-processing (fixed routes are always 
+     * stored as processed routes), so this index is built once, before stretch mitigation.
+     */
+    
+    map<InetAddress, map<unsigned short, SubnetSite*> > routeHops;
+    
     /*
      * Detection of routing anomalies and their mitigation are separated in two private methods 
      * for the sake of clarity.
@@ -75,6 +87,9 @@ private:
     bool hasCycle(RouteInterface *route, unsigned short size);
     bool hasStretch(RouteInterface *route, unsigned short size);
     
+    // Builds the index of measured routes (see routeHops)
+    void indexRouteHops();
+    
     /*
      * Method to find the route prefix of the soonest occurrence (in TTL) of a stretched route 
      * hop among all routes. The size of that prefix is passed by pointer.
@@ -14,47 +14,51 @@ using std::list;
 using std::string;
 #include <fstream>
 using std::ifstream;
-using std::ofstream;
+#include <sstream>
+using std::ostringstream;
+#include <algorithm>
 #include <sys/stat.h> // For CHMOD edition in saveScrappedSubnets()
 
 #include "Grafter.h"
+#include "GrafterUnit.h"
 #include "../../../utils/SubnetParser.h"
+#include "../../../../common/thread/Thread.h"
+
+Mutex Grafter::setsMutex(Mutex::ERROR_CHECKING_MUTEX);
 
 Grafter::Grafter(TreeNETEnvironment *env, list<string> setList)
 {
     this->env = env;
     nbSets = setList.size();
     
-    SubnetParser *sp = new SubnetParser(env);
-    unsigned short successfullyParsed = 0;
-    
     buildingSets = new SubnetSiteSet*[nbSets];
     filePaths = new string[nbSets];
+    logs = new string[nbSets];
     int j = 0;
     for(list<string>::iterator i = setList.begin(); i != setList.end(); i++)
     {
-        string curPath = (*i);
-        filePaths[j] = curPath;
+        filePaths[j] = (*i);
         buildingSets[j] = new SubnetSiteSet();
-        
-        // Parses the file content        
-        bool res = sp->parse(curPath + ".subnet", buildingSets[j]);
-        
-        ostream *out = env->getOutputStream();
-        if(res && buildingSets[j]->getNbSubnets() > 0)
-        {
-            successfullyParsed++;
-            (*out) << "Successfully parsed " << curPath << ".\n" << endl;
-        }
-        else
-        {
-            (*out) << "Could not parse anything right in " << curPath << ".\n" << endl;
-        }
-        
         j++;
     }
     
-    delete sp;
+    trunkHeight = NULL;
+    lateInterfaces = NULL;
+    isIncomplete = NULL;
+    
+    // Parses the files (in parallel) then displays the messages in order
+    this->processInParallel(PHASE_PARSING);
+    
+    ostream *out = env->getOutputStream();
+    unsigned short successfullyParsed = 0;
+    for(unsigned short i = 0; i < nbSets; i++)
+    {
+        (*out) << logs[i] << std::flush;
+        if(buildingSets[i]->getNbSubnets() > 0)
+            successfullyParsed++;
+    }
+    delete[] logs;
+    logs = NULL;
     
     // When less than 2 datasets successfully parsed: deletes everything and throws and exception
     if(successfullyParsed <= 2)
@@ -126,9 +130,9 @@ bool Grafter::isTrunkIncomplete(NetworkTree *tree)
     return false;
 }
 
-list<InetAddress> Grafter::listLateInterfaces(NetworkTree *tree)
+vector<InetAddress> Grafter::listLateInterfaces(NetworkTree *tree)
 {
-    list<InetAddress> result;
+    vector<InetAddress> result;
 
     // Gets to end of trunk
     NetworkTreeNode *trunkEnd = tree->getRoot();
@@ -142,37 +146,29 @@ list<InetAddress> Grafter::listLateInterfaces(NetworkTree *tree)
         return result;
     
     listLateInterfacesRecursive(trunkEnd, &result);
-    result.sort(InetAddress::smaller);
+    std::sort(result.begin(), result.end(), InetAddress::smaller);
     
     // Removes potential duplicates (rare but possible)
-    InetAddress previous(0);
-    for(list<InetAddress>::iterator i = result.begin(); i != result.end(); ++i)
-    {
-        InetAddress cur = (*i);
-        if(cur == previous)
-            result.erase(i--);
-        else
-            previous = cur;
-    }
+    result.erase(std::unique(result.begin(), result.end()), result.end());
     
     return result;
 }
 
-void Grafter::listLateInterfacesRecursive(NetworkTreeNode *cur, list<InetAddress> *res)
+void Grafter::listLateInterfacesRecursive(NetworkTreeNode *cur, vector<InetAddress> *res)
 {
     // Stops if it is a leaf
     if(cur->isLeaf())
         return;
 
     // Goes through children and finds internals among them
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         NetworkTreeNode *curChild = (*i);
         if(curChild->isInternal())
         {
-            list<InetAddress> *labels = curChild->getLabels();
-            for(list<InetAddress>::iterator j = labels->begin(); j != labels->end(); ++j)
+            vector<InetAddress> *labels = curChild->getLabels();
+            for(vector<InetAddress>::iterator j = labels->begin(); j != labels->end(); ++j)
             {
                 InetAddress interface = (*j);
                 if(interface != InetAddress(0))
@@ -187,6 +183,26 @@ void Grafter::listLateInterfacesRecursive(NetworkTreeNode *cur, list<InetAddress
     }
 }
 
+unsigned int Grafter::countCommonInterfaces(vector<InetAddress> *v1, vector<InetAddress> *v2)
+{
+    unsigned int count = 0;
+    vector<InetAddress>::iterator i = v1->begin(), j = v2->begin();
+    while(i != v1->end() && j != v2->end())
+    {
+        if((*i) < (*j))
+            ++i;
+        else if((*j) < (*i))
+            ++j;
+        else
+        {
+            count++;
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
 void Grafter::nullifyLeaves(NetworkTree *tree)
 {
     nullifyLeavesRecursive(tree->getRoot());
@@ -194,8 +210,8 @@ void Grafter::nullifyLeaves(NetworkTree *tree)
 
 void Grafter::nullifyLeavesRecursive(NetworkTreeNode *cur)
 {
-    list<NetworkTreeNode*> *children = cur->getChildren();
-    for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
     {
         NetworkTreeNode *cur = (*i);
         if(cur->isLeaf())
@@ -205,12 +221,116 @@ void Grafter::nullifyLeavesRecursive(NetworkTreeNode *cur)
     }
 }
 
+void Grafter::processInParallel(unsigned short phase)
+{
+    this->phase = phase;
+    this->nextSet = 0;
+    
+    unsigned short nbThreads = env->getMaxThreads();
+    if(nbThreads > MAX_THREADS)
+        nbThreads = MAX_THREADS;
+    if(nbThreads > nbSets)
+        nbThreads = nbSets;
+    
+    // The current thread also processes datasets, hence nbThreads - 1 additionnal threads
+    list<Thread*> threads;
+    for(unsigned short i = 1; i < nbThreads; i++)
+    {
+        Thread *th = new Thread(new GrafterUnit(this));
+        try
+        {
+            th->start();
+        }
+        catch(ThreadException &te)
+        {
+            delete th; // Also deletes the unit
+            break;
+        }
+        threads.push_back(th);
+    }
+    
+    bool setsLeft = true;
+    while(setsLeft)
+        setsLeft = this->processNextSet();
+    
+    for(list<Thread*>::iterator i = threads.begin(); i != threads.end(); ++i)
+    {
+        (*i)->join();
+        delete (*i);
+    }
+}
+
+bool Grafter::processNextSet()
+{
+    setsMutex.lock();
+    if(nextSet >= nbSets)
+    {
+        setsMutex.unlock();
+        return false;
+    }
+    unsigned short index = nextSet;
+    nextSet++;
+    setsMutex.unlock();
+    
+    if(phase == PHASE_PARSING)
+        this->parseSet(index);
+    else
+        this->measureSet(index);
+    return true;
+}
+
+void Grafter::parseSet(unsigned short index)
+{
+    ostringstream log;
+    
+    SubnetParser *sp = new SubnetParser(env, &log);
+    bool res = sp->parse(filePaths[index] + ".subnet", buildingSets[index]);
+    delete sp;
+    
+    if(res && buildingSets[index]->getNbSubnets() > 0)
+        log << "Successfully parsed " << filePaths[index] << ".\n" << endl;
+    else
+        log << "Could not parse anything right in " << filePaths[index] << ".\n" << endl;
+    
+    logs[index] = log.str();
+}
+
+void Grafter::measureSet(unsigned short index)
+{
+    if(buildingSets[index]->getNbSubnets() == 0)
+        return;
+    
+    // The tree is grown from a copy of the list, as growth empties the set
+    SubnetSiteSet *subnets = new SubnetSiteSet();
+    list<SubnetSite*> *ssList = subnets->getSubnetSiteList();
+    (*ssList) = (*(buildingSets[index]->getSubnetSiteList()));
+    
+    Grower *grower = new GrafterGrower(env, subnets);
+    grower->grow();
+    
+    Soil *result = grower->getResult();
+    NetworkTree *tree = result->getRootsList()->front();
+    
+    delete grower;
+    
+    trunkHeight[index] = getTrunkSize(tree);
+    isIncomplete[index] = isTrunkIncomplete(tree);
+    lateInterfaces[index] = listLateInterfaces(tree);
+    
+    nullifyLeaves(tree);
+    delete result;
+    
+    // Remaining subnets still belong to the dataset
+    ssList->clear();
+    delete subnets;
+}
+
 void Grafter::selectRootstock()
 {
     // Some useful arrays to later elect the best "rootstock"
-    unsigned short *trunkHeight = new unsigned short[nbSets];
-    list<InetAddress> *lateInterfaces = new list<InetAddress>[nbSets];
-    bool *isIncomplete = new bool[nbSets];
+    trunkHeight = new unsigned short[nbSets];
+    lateInterfaces = new vector<InetAddress>[nbSets];
+    isIncomplete = new bool[nbSets];
     unsigned int *score = new unsigned int[nbSets];
     
     for(unsigned short i = 0; i < nbSets; i++)
@@ -220,59 +340,38 @@ void Grafter::selectRootstock()
         score[i] = 0;
     }
     
-    // Building a tree for each dataset
+    // Building a tree for each dataset (in parallel)
+    this->processInParallel(PHASE_MEASURING);
+    
+    /*
+     * Now seeing how many collisions occur with the late interfaces of other sets (for each set). 
+     * As the late interfaces of a same set are unique, an interface of a set collides with 
+     * another set if and only if it appears at least twice among the late interfaces of all sets. 
+     * Such interfaces are therefore listed first (in a sorted vector), then intersected with the 
+     * late interfaces of each set.
+     */
+    
+    vector<InetAddress> allInterfaces;
     for(unsigned short i = 0; i < nbSets; i++)
+        allInterfaces.insert(allInterfaces.end(), lateInterfaces[i].begin(), lateInterfaces[i].end());
+    std::sort(allInterfaces.begin(), allInterfaces.end(), InetAddress::smaller);
+    
+    vector<InetAddress> sharedInterfaces;
+    for(size_t i = 1; i < allInterfaces.size(); i++)
     {
-        if(buildingSets[i]->getNbSubnets() == 0)
+        if(allInterfaces[i] != allInterfaces[i - 1])
             continue;
-    
-        env->copySubnetSet(buildingSets[i]);
-        
-        Grower *grower = new GrafterGrower(env);
-        grower->grow();
-        
-        Soil *result = grower->getResult();
-        NetworkTree *tree = result->getRootsList()->front();
-        
-        delete grower;
-        
-        trunkHeight[i] = getTrunkSize(tree);
-        isIncomplete[i] = isTrunkIncomplete(tree);
-        lateInterfaces[i] = listLateInterfaces(tree);
-        
-        nullifyLeaves(tree);
-        delete result;
+        if(sharedInterfaces.size() == 0 || sharedInterfaces.back() != allInterfaces[i])
+            sharedInterfaces.push_back(allInterfaces[i]);
     }
+    allInterfaces.clear();
     
-    // Now seeing how many collisions occur with the late interfaces of other sets (for each set)
     for(unsigned short i = 0; i < nbSets; i++)
     {
         if(buildingSets[i]->getNbSubnets() == 0)
             continue;
-    
-        IPLookUpTable *tempIPDict = new IPLookUpTable(env->getNbIPIDs());
-        
-        for(unsigned short j = 0; j < nbSets; j++)
-        {
-            if(i == j)
-                continue;
-            
-            list<InetAddress> list = lateInterfaces[j];
-            for(std::list<InetAddress>::iterator it = list.begin(); it != list.end(); ++it)
-                tempIPDict->create((*it)); // No need to check result here
-        }
         
-        list<InetAddress> list = lateInterfaces[i];
-        unsigned short nbCollisions = 0;
-        for(std::list<InetAddress>::iterator it = list.begin(); it != list.end(); ++it)
-        {
-            IPTableEntry *res = tempIPDict->create((*it)); // Checking is needed here
-            if(res == NULL)
-                nbCollisions++;
-        }
-        
-        score[i] = nbCollisions;
-        delete tempIPDict;
+        score[i] = countCommonInterfaces(&lateInterfaces[i], &sharedInterfaces);
     }
     
     // Summarizing the computed data in the console
@@ -309,6 +408,9 @@ void Grafter::selectRootstock()
     delete[] isIncomplete;
     delete[] lateInterfaces;
     delete[] score;
+    trunkHeight = NULL;
+    isIncomplete = NULL;
+    lateInterfaces = NULL;
 }
 
 Soil* Grafter::growAndGraft()
@@ -366,20 +468,13 @@ void Grafter::outputScrappedSubnets(string filename)
 {
     if(scrappedSubnets.size() > 0)
     {
-        string output = "";
+        OutputBuffer output(filename);
         for(list<SubnetSite*>::iterator i = scrappedSubnets.begin(); i != scrappedSubnets.end(); ++i)
         {
-            SubnetSite *ss = (*i);
-            string cur = ss->toString();
-            
-            if(!cur.empty())
-                output += cur + "\n";
+            if((*i)->writeTo(&output))
+                output << "\n";
         }
-        
-        ofstream newFile;
-        newFile.open(filename.c_str());
-        newFile << output;
-        newFile.close();
+        output.close();
         
         // File must be accessible to all
         string path = "./" + filename;
@@ -9,18 +9,35 @@
  * required methods to handle scrapped subnets. The goal of having such a class rather than just 
  * re-using the code of TreeNET Reader is to be able, if needed, to let the user decide if (s)he 
  * wants to save scrapped subnets or even to let the user select the rootstock.
+ *
+ * Since the datasets are independent until the selection of the rootstock, both their parsing 
+ * and the growth of a candidate tree for each of them are performed by several threads (see 
+ * GrafterUnit), each thread processing one dataset at a time with its own subnet set. The amount 
+ * of threads is bounded to keep the amount of datasets being processed at the same time (and 
+ * therefore the memory) under control. Messages are buffered per dataset and written in the 
+ * order of the input files, and the final grafting remains sequential, such that the outcome 
+ * does not depend on the scheduling of the threads.
  */
 
 #ifndef GRAFTER_H_
 #define GRAFTER_H_
 
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+
 #include "GrafterGrower.h"
 #include "BadInputException.h"
+#include "../../../../common/thread/Mutex.h"
 
 class Grafter
 {
 public:
 
+    // Maximum amount of datasets being parsed or measured at the same time
+    static const unsigned short MAX_THREADS = 8;
+
     // Constructor, destructor
     Grafter(TreeNETEnvironment *env, list<string> setList);
     ~Grafter(); // Implicitely virtual
@@ -34,8 +51,18 @@ public:
     // Checks and saves scrapped subnets
     inline bool hasScrappedSubnets() { return this->scrappedSubnets.size() > 0; }
     void outputScrappedSubnets(string filename);
+    
+    // Parses or measures the next dataset of the current phase (false if no dataset is left)
+    bool processNextSet();
 
 private:
+    
+    // Phases during which datasets are processed in parallel
+    static const unsigned short PHASE_PARSING = 1;
+    static const unsigned short PHASE_MEASURING = 2;
+    
+    // Mutex used to hand out datasets to threads
+    static Mutex setsMutex;
 
     // Main fields
     TreeNETEnvironment *env;
@@ -50,6 +77,20 @@ private:
     // List of "scrapped" subnets (i.e., could not be grafted at all)
     list<SubnetSite*> scrappedSubnets;
     
+    // Current phase, next dataset to process, and per-dataset results (messages, measurements)
+    unsigned short phase, nextSet;
+    string *logs;
+    unsigned short *trunkHeight;
+    vector<InetAddress> *lateInterfaces;
+    bool *isIncomplete;
+    
+    // Processes all datasets for a given phase with several threads
+    void processInParallel(unsigned short phase);
+    
+    // Parses/measures (i.e., grows a tree and evaluates its trunk) the dataset at a given index
+    void parseSet(unsigned short index);
+    void measureSet(unsigned short index);
+    
     /*
      * N.B.: it would be tempting to create a new Climber class to implement operations such as 
      * the measurement of the main trunk. However, since these operations are both very specific 
@@ -57,11 +98,19 @@ private:
      * this class.
      */
     
-    // Private methods to evaluate trunk and late interfaces of a given tree.
+    /*
+     * Private methods to evaluate trunk and late interfaces of a given tree. Late interfaces are 
+     * returned sorted and without duplicates, such that the late interfaces of two datasets can 
+     * be compared by merge-intersection.
+     */
+    
     unsigned short getTrunkSize(NetworkTree *tree);
     bool isTrunkIncomplete(NetworkTree *tree);
-    list<InetAddress> listLateInterfaces(NetworkTree *tree);
-    void listLateInterfacesRecursive(NetworkTreeNode *cur, list<InetAddress> *res);
+    vector<InetAddress> listLateInterfaces(NetworkTree *tree);
+    void listLateInterfacesRecursive(NetworkTreeNode *cur, vector<InetAddress> *res);
+    
+    // Counts the interfaces two sorted vectors (without duplicates) have in common
+    static unsigned int countCommonInterfaces(vector<InetAddress> *v1, vector<InetAddress> *v2);
     
     // Private methods nuffily leaves at the end of a network tree.
     void nullifyLeaves(NetworkTree *tree);
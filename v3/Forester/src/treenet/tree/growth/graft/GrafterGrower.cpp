@@ -10,6 +10,9 @@
 
 #include <list>
 using std::list;
+#include <algorithm>
+using std::sort;
+using std::unique;
 
 #include "GrafterGrower.h"
 
@@ -17,26 +20,36 @@ GrafterGrower::GrafterGrower(TreeNETEnvironment *env) : Grower(env)
 {
     /*
      * About maxDepth parameter: it is the size of the longest route to a subnet which should be 
-     * inserted in the tree. It is used as the size of the depthMap array (i.e. one list of nodes 
+     * inserted in the tree. It is used as the amount of levels of the depth map (i.e. the nodes 
      * per depth level), which should be maintained throughout the life of the tree to ease the 
      * insertion step (re-building the whole map at each insertion is costly).
      */
 
-    maxDepth = env->getSubnetSet()->getMaximumDistance();
-    this->depthMap = new list<NetworkTreeNode*>[maxDepth];
+    this->subnets = env->getSubnetSet();
+    maxDepth = subnets->getMaximumDistance();
+    this->depthMap = new DepthMap(maxDepth);
     this->tree = NULL;
 }
 
 GrafterGrower::GrafterGrower(TreeNETEnvironment *env, unsigned short maxDepth) : Grower(env)
 {
+    this->subnets = env->getSubnetSet();
     this->maxDepth = maxDepth;
-    this->depthMap = new list<NetworkTreeNode*>[maxDepth];
+    this->depthMap = new DepthMap(maxDepth);
+    this->tree = NULL;
+}
+
+GrafterGrower::GrafterGrower(TreeNETEnvironment *env, SubnetSiteSet *subnets) : Grower(env)
+{
+    this->subnets = subnets;
+    maxDepth = subnets->getMaximumDistance();
+    this->depthMap = new DepthMap(maxDepth);
     this->tree = NULL;
 }
 
 GrafterGrower::~GrafterGrower()
 {
-    delete[] depthMap;
+    delete depthMap;
 }
 
 
@@ -47,8 +60,6 @@ void GrafterGrower::prepare()
 
 void GrafterGrower::grow()
 {
-    SubnetSiteSet *subnets = env->getSubnetSet();
-
     subnets->sortByRoute();
     
     this->tree = new NetworkTree();
@@ -85,11 +96,11 @@ void GrafterGrower::insert(SubnetSite *subnet)
 {
     // Gets root of the tree
     NetworkTreeNode *rootNode = this->tree->getRoot();
-    list<NetworkTreeNode*> *map = this->depthMap;
+    DepthMap *map = this->depthMap;
 
     // Gets route information of the new subnet
     unsigned short routeSize;
-    RouteInterface *route = subnet->getFinalRoute(&routeSize);
+    RouteView route = subnet->getFinalRoute(&routeSize);
     
     // Finds the deepest node which occurs in the route of current subnet
     NetworkTreeNode *insertionPoint = NULL;
@@ -99,18 +110,12 @@ void GrafterGrower::insert(SubnetSite *subnet)
         if(route[d - 1].ip == RouteInterface::MISSING)
             continue;
     
-        for(list<NetworkTreeNode*>::iterator i = map[d - 1].begin(); i != map[d - 1].end(); ++i)
-        {
-            if((*i)->hasLabel(route[d - 1].ip))
-            {
-                insertionPoint = (*i);
-                insertionPointDepth = d;
-                break;
-            }
-        }
-        
+        insertionPoint = map->find(d - 1, route[d - 1].ip);
         if(insertionPoint != NULL)
+        {
+            insertionPointDepth = d;
             break;
+        }
     }
     
     if(insertionPoint == NULL)
@@ -130,10 +135,10 @@ void GrafterGrower::insert(SubnetSite *subnet)
         unsigned short curDepth = insertionPointDepth;
         do
         {
-            map[curDepth].push_back(next);
+            map->add(next, curDepth);
             curDepth++;
             
-            list<NetworkTreeNode*> *children = next->getChildren();
+            vector<NetworkTreeNode*> *children = next->getChildren();
             if(children != NULL && children->size() == 1)
             {
                 if(children->front()->isInternal())
@@ -167,6 +172,7 @@ void GrafterGrower::insert(SubnetSite *subnet)
         if(!cur->hasLabel(route[d - 2].ip))
         {
             cur->addLabel(route[d - 2].ip);
+            map->addLabel(cur, d - 2, route[d - 2].ip);
             
             /*
              * Look in depth map for a node at same depth sharing the new label. Indeed, if such
@@ -175,39 +181,20 @@ void GrafterGrower::insert(SubnetSite *subnet)
              * to be fidel to the topology.
              */
             
-            NetworkTreeNode *toMerge = NULL;
-            for(list<NetworkTreeNode*>::iterator i = map[d - 2].begin(); i != map[d - 2].end(); ++i)
-            {
-                if((*i) != cur && (*i)->hasLabel(route[d - 2].ip))
-                {
-                    toMerge = (*i);
-                    break;
-                }
-            }
-            
+            NetworkTreeNode *toMerge = map->find(d - 2, route[d - 2].ip, cur);
             if(toMerge != NULL)
             {
                 cur->merge(toMerge);
                 
                 // Add labels in toMerge absent from cur
-                list<InetAddress> *labels1 = cur->getLabels();
-                list<InetAddress> *labels2 = toMerge->getLabels();
-                labels1->merge((*labels2));
-                labels1->sort(InetAddress::smaller);
-                InetAddress prev(0);
-                bool first = true; // Avoids incoherent behavior with labels 0.0.0.0
-                for(list<InetAddress>::iterator i = labels1->begin(); i != labels1->end(); ++i)
-                {
-                    if(!first)
-                    {
-                        if((*i) == prev)
-                        {
-                            labels1->erase(i--);
-                        }
-                    }
-                    prev = (*i);
-                    first = false;
-                }
+                vector<InetAddress> *labels1 = cur->getLabels();
+                vector<InetAddress> *labels2 = toMerge->getLabels();
+                for(vector<InetAddress>::iterator i = labels2->begin(); i != labels2->end(); ++i)
+                    map->addLabel(cur, d - 2, (*i));
+                labels1->insert(labels1->end(), labels2->begin(), labels2->end());
+                labels2->clear();
+                sort(labels1->begin(), labels1->end());
+                labels1->erase(unique(labels1->begin(), labels1->end()), labels1->end());
                 
                 this->prune(toMerge, NULL, d - 2);
                 
@@ -226,7 +213,7 @@ void GrafterGrower::insert(SubnetSite *subnet)
 
 void GrafterGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned short depth)
 {
-    list<NetworkTreeNode*> *map = this->depthMap;
+    DepthMap *map = this->depthMap;
 
     if(cur->isLeaf())
     {
@@ -238,18 +225,11 @@ void GrafterGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
     {
         if(prev != NULL)
         {
-            list<NetworkTreeNode*> *children = cur->getChildren();
-            for(list<NetworkTreeNode*>::iterator i = map[0].begin(); i != map[0].end(); ++i)
-            {
-                if((*i) == prev)
-                {
-                    map[0].erase(i);
-                    break;
-                }
-            }
+            vector<NetworkTreeNode*> *children = cur->getChildren();
+            map->remove(prev, 0);
         
             // Erases prev from the children list (of this node) and stops
-            for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+            for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
             {
                 if((*i) == prev)
                 {
@@ -264,24 +244,16 @@ void GrafterGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
         return;
     }
     
-    list<NetworkTreeNode*> *children = cur->getChildren();
+    vector<NetworkTreeNode*> *children = cur->getChildren();
 
     // Current node has multiple children; keep it but remove prev
     if(children->size() > 1)
     {
         // Erases prev from the depth map
-        unsigned dPrev = depth + 1;
-        for(list<NetworkTreeNode*>::iterator i = map[dPrev].begin(); i != map[dPrev].end(); ++i)
-        {
-            if((*i) == prev)
-            {
-                map[dPrev].erase(i);
-                break;
-            }
-        }
+        map->remove(prev, depth + 1);
     
         // Erases prev from the children list (of this node) and stops
-        for(list<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+        for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
         {
             if((*i) == prev)
             {
@@ -295,15 +267,7 @@ void GrafterGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
     else if(children->size() == 1)
     {
         // Erases prev from the depth map
-        unsigned dPrev = depth + 1;
-        for(list<NetworkTreeNode*>::iterator i = map[dPrev].begin(); i != map[dPrev].end(); ++i)
-        {
-            if((*i) == prev)
-            {
-                map[dPrev].erase(i);
-                break;
-            }
-        }
+        map->remove(prev, depth + 1);
     
         delete prev;
         cur->getChildren()->clear();
@@ -319,7 +283,7 @@ void GrafterGrower::prune(NetworkTreeNode *cur, NetworkTreeNode *prev, unsigned
 NetworkTreeNode *GrafterGrower::createBranch(SubnetSite *subnet, unsigned short depth)
 {
     unsigned short routeSize;
-    RouteInterface *route = subnet->getFinalRoute(&routeSize);
+    RouteView route = subnet->getFinalRoute(&routeSize);
     
     // If current depth minus 1 equals the route size, then we just have to create a leaf
     if((depth - 1) == routeSize)
@@ -347,7 +311,7 @@ bool GrafterGrower::matchesTrunk(SubnetSite *subnet)
 {
     // Gets route details
     unsigned short routeSize;
-    RouteInterface *route = subnet->getFinalRoute(&routeSize);
+    RouteView route = subnet->getFinalRoute(&routeSize);
 
     // Goes through the main trunk
     NetworkTreeNode *trunkEnd = tree->getRoot();
@@ -375,7 +339,7 @@ bool GrafterGrower::isGraftable(SubnetSite *ss,
 {
     // Gets route information of the new subnet
     unsigned short routeSize;
-    RouteInterface *route = ss->getFinalRoute(&routeSize);
+    RouteView route = ss->getFinalRoute(&routeSize);
     
     // Finds the earliest node which has a label occurring in route (first interfaces first)
     NetworkTreeNode *matchingPoint = NULL;
@@ -386,26 +350,14 @@ bool GrafterGrower::isGraftable(SubnetSite *ss,
         if(route[i].ip == InetAddress(0))
             continue;
         
-        for(unsigned short j = 0; j < maxDepth; j++)
-        {
-            list<NetworkTreeNode*> curLs = this->depthMap[j];
-            for(list<NetworkTreeNode*>::iterator it = curLs.begin(); it != curLs.end(); ++it)
-            {
-                if((*it)->hasLabel(route[i].ip))
-                {
-                    matchingPoint = (*it);
-                    matchingPointDepth = j;
-                    matchingIndex = i;
-                    break;
-                }
-            }
-            
-            if(matchingPoint != NULL)
-                break;
-        }
-        
+        unsigned short depth = 0;
+        matchingPoint = this->depthMap->findShallowest(route[i].ip, &depth);
         if(matchingPoint != NULL)
+        {
+            matchingPointDepth = depth;
+            matchingIndex = i;
             break;
+        }
     }
 
     if (matchingPoint == NULL)
@@ -427,7 +379,7 @@ bool GrafterGrower::isGraftable(SubnetSite *ss,
     for(unsigned short i = 0; i < (*sNew); i++)
     {
         unsigned short index = (*sNew) - 1 - i;
-        list<InetAddress> *labels = cur->getLabels();
+        vector<InetAddress> *labels = cur->getLabels();
         if(labels->size() == 1)
         {
             newRoute[index] = labels->front();
@@ -436,7 +388,7 @@ bool GrafterGrower::isGraftable(SubnetSite *ss,
         else
         {
             bool assigned = false;
-            for(list<InetAddress>::iterator it = labels->begin(); it != labels->end(); ++it)
+            for(vector<InetAddress>::iterator it = labels->begin(); it != labels->end(); ++it)
             {
                 if((*it) != InetAddress(0))
                 {
@@ -14,6 +14,7 @@
 #define GRAFTERGROWER_H_
 
 #include "../Grower.h"
+#include "../DepthMap.h"
 
 class GrafterGrower : public Grower
 {
@@ -22,9 +23,14 @@ public:
     // Constructors, destructor
     GrafterGrower(TreeNETEnvironment *env);
     GrafterGrower(TreeNETEnvironment *env, unsigned short maxDepth);
+    GrafterGrower(TreeNETEnvironment *env, SubnetSiteSet *subnets);
     ~GrafterGrower(); // Implicitely virtual
     
-    // N.B.: the second constructor is meant for the final tree of a grafting process.
+    /*
+     * N.B.: the second constructor is meant for the final tree of a grafting process. The third 
+     * one grows a tree with the subnets of a given set rather than the set of the environment, 
+     * such that several trees can be grown at the same time (see Grafter).
+     */
     
     void prepare(); // Implicitely virtual
     void grow(); // Implicitely virtual
@@ -37,9 +43,10 @@ public:
 
 protected:
 
-    // Depth map for tree construction, and the tree being grown
+    // Subnets to insert, depth map for tree construction, and the tree being grown
+    SubnetSiteSet *subnets;
     unsigned short maxDepth;
-    list<NetworkTreeNode*> *depthMap;
+    DepthMap *depthMap;
     NetworkTree *tree;
     
     // List of new subnet map entries (will be moved to the map in a Soil object)
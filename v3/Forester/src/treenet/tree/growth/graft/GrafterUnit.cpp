@@ -0,0 +1,27 @@
+/*
+ * GrafterUnit.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in GrafterUnit.h (see this file to learn further about the goals 
+ * of such class).
+ */
+
+#include "GrafterUnit.h"
+
+GrafterUnit::GrafterUnit(Grafter *parent)
+{
+    this->parent = parent;
+}
+
+GrafterUnit::~GrafterUnit()
+{
+}
+
+void GrafterUnit::run()
+{
+    bool setsLeft = true;
+    while(setsLeft)
+        setsLeft = parent->processNextSet();
+}
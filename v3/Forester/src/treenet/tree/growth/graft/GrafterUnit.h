@@ -0,0 +1,34 @@
+/*
+ * GrafterUnit.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * This class, inheriting Runnable, processes datasets on behalf of a Grafter object (i.e., it 
+ * parses them or grows and measures their candidate trees, depending on the current phase of the 
+ * Grafter object) until there is no dataset left to process.
+ */
+
+#ifndef GRAFTERUNIT_H_
+#define GRAFTERUNIT_H_
+
+#include "Grafter.h"
+#include "../../../../common/thread/Runnable.h"
+
+class GrafterUnit : public Runnable
+{
+public:
+
+    // Constructor, destructor, run method
+    GrafterUnit(Grafter *parent);
+    ~GrafterUnit();
+    void run();
+    
+private:
+
+    // Grafter processing the datasets
+    Grafter *parent;
+
+};
+
+#endif /* GRAFTERUNIT_H_ */
@@ -0,0 +1,507 @@
+/*
+ * Benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in Benchmark.h (see this file to learn further about the goals of
+ * such class).
+ */
+
+#include <algorithm> // For nth_element()
+#include <fstream>
+using std::ifstream;
+#include <sstream>
+using std::stringstream;
+#include <ctime> // For clock_gettime()
+#include <arpa/inet.h> // For inet_ntoa() and inet_aton()
+#include <sys/resource.h> // For getrusage()
+#include <sys/stat.h> // For chmod()
+
+#include "Benchmark.h"
+#include "OutputBuffer.h"
+#include "SubnetParser.h"
+#include "IPDictionnaryParser.h"
+#include "../tree/growth/classic/ClassicGrower.h"
+#include "../tree/growth/classic/RoutePostProcessor.h"
+#include "../tree/climbers/Robin.h"
+#include "../tree/climbers/Crow.h"
+#include "../tree/climbers/Cat.h"
+#include "../tree/climbers/Termite.h"
+#include "../../common/utils/TextCodec.h"
+
+Benchmark::Benchmark(TreeNETEnvironment *env, string dataset, string label)
+{
+    this->env = env;
+    this->dataset = dataset;
+    this->label = label;
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+uint64_t Benchmark::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+unsigned long Benchmark::getPeakRSS()
+{
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return (unsigned long) usage.ru_maxrss; // Already in KiB on Linux
+}
+
+void Benchmark::record(string name,
+                       unsigned long ops,
+                       uint64_t total,
+                       vector<uint64_t> *latencies)
+{
+    Result r;
+    r.name = name;
+    r.ops = ops;
+    r.total = total;
+    r.p50 = r.p90 = r.p99 = r.max = total;
+    if(latencies != NULL && latencies->size() > 0)
+    {
+        size_t n = latencies->size();
+        vector<uint64_t>::iterator first = latencies->begin();
+        std::nth_element(first, first + (n * 50) / 100, latencies->end());
+        r.p50 = (*latencies)[(n * 50) / 100];
+        std::nth_element(first, first + (n * 90) / 100, latencies->end());
+        r.p90 = (*latencies)[(n * 90) / 100];
+        std::nth_element(first, first + (n * 99) / 100, latencies->end());
+        r.p99 = (*latencies)[(n * 99) / 100];
+        r.max = *(std::max_element(first, latencies->end()));
+    }
+    r.peakRSS = getPeakRSS();
+    results.push_back(r);
+
+    ostream *out = env->getOutputStream();
+    (*out) << "Benchmark " << name << ": " << ops << " operation(s) in " << (total / 1000000);
+    (*out) << " ms (";
+    if(latencies != NULL)
+        (*out) << "median latency: " << r.p50 << " ns, 99th percentile: " << r.p99 << " ns, ";
+    (*out) << "peak memory: " << r.peakRSS << " KiB)" << endl;
+}
+
+bool Benchmark::run()
+{
+    if(!this->benchParsing())
+        return false;
+
+    this->listIPs();
+    this->benchIPTable();
+    this->benchSubnetSet(true);
+    this->benchSubnetSet(false);
+
+    Soil *soil = this->benchGrowth();
+    this->benchSoil(soil);
+    this->benchAliasResolution(soil);
+    this->benchClimbers(soil);
+    delete soil;
+
+    this->benchTextCodec();
+    return true;
+}
+
+bool Benchmark::benchParsing()
+{
+    SubnetSiteSet *set = env->getSubnetSet();
+
+    uint64_t start = now();
+    SubnetParser *sp = new SubnetParser(env);
+    bool subnetParsingResult = sp->parse(dataset + ".subnet");
+    delete sp;
+    uint64_t total = now() - start;
+    if(!subnetParsingResult || set->getNbSubnets() == 0)
+        return false;
+    this->record("parse-subnets", set->getNbSubnets(), total, NULL);
+
+    // Lines of the dictionnary (one per entry)
+    unsigned long nbLines = 0;
+    ifstream dictionnary((dataset + ".ip").c_str());
+    string line;
+    while(std::getline(dictionnary, line))
+        nbLines++;
+    dictionnary.close();
+
+    start = now();
+    IPDictionnaryParser *idp = new IPDictionnaryParser(env);
+    bool ipParsingResult = idp->parse(dataset + ".ip");
+    delete idp;
+    total = now() - start;
+    if(ipParsingResult)
+        this->record("parse-ip-dictionnary", nbLines, total, NULL);
+    else
+        env->fillIPDictionnary();
+    return true;
+}
+
+void Benchmark::listIPs()
+{
+    IPs.clear();
+    subnetIPs.clear();
+
+    list<SubnetSite*> *subnets = env->getSubnetSet()->getSubnetSiteList();
+    for(list<SubnetSite*>::iterator it = subnets->begin(); it != subnets->end(); ++it)
+    {
+        SubnetSite *ss = (*it);
+        subnetIPs.push_back(ss->getInferredSubnetBaseIP());
+
+        list<SubnetSiteNode*> *interfaces = ss->getSubnetIPList();
+        for(list<SubnetSiteNode*>::iterator i = interfaces->begin(); i != interfaces->end(); ++i)
+            IPs.push_back((*i)->ip);
+
+        unsigned short routeSize = ss->getRouteSize();
+        RouteView route = ss->getRouteView();
+        for(unsigned short i = 0; i < routeSize && !route.isEmpty(); i++)
+            if(route[i].ip != InetAddress(0))
+                IPs.push_back(route[i].ip);
+    }
+}
+
+void Benchmark::benchIPTable()
+{
+    IPLookUpTable *table = new IPLookUpTable(env->getNbIPIDs());
+    vector<uint64_t> latencies;
+    latencies.reserve(IPs.size());
+
+    // Creation (IPs appearing several times are only created once, like in fillIPDictionnary())
+    uint64_t total = 0;
+    for(size_t i = 0; i < IPs.size(); i++)
+    {
+        uint64_t start = now();
+        table->create(IPs[i]);
+        uint64_t elapsed = now() - start;
+        latencies.push_back(elapsed);
+        total += elapsed;
+    }
+    this->record("iptable-create", IPs.size(), total, &latencies);
+
+    // Look-up of existing entries
+    latencies.clear();
+    total = 0;
+    for(size_t i = 0; i < IPs.size(); i++)
+    {
+        uint64_t start = now();
+        table->lookUp(IPs[i]);
+        uint64_t elapsed = now() - start;
+        latencies.push_back(elapsed);
+        total += elapsed;
+    }
+    this->record("iptable-lookup-hit", IPs.size(), total, &latencies);
+
+    // Look-up of absent entries (in 240.0.0.0/4, never found in a dataset)
+    latencies.clear();
+    total = 0;
+    for(size_t i = 0; i < IPs.size(); i++)
+    {
+        InetAddress absent(0xF0000000UL | (IPs[i].getULongAddress() & 0x0FFFFFFFUL));
+        uint64_t start = now();
+        table->lookUp(absent);
+        uint64_t elapsed = now() - start;
+        latencies.push_back(elapsed);
+        total += elapsed;
+    }
+    this->record("iptable-lookup-miss", IPs.size(), total, &latencies);
+
+    delete table;
+}
+
+void Benchmark::benchSubnetSet(bool merging)
+{
+    // Subnets are parsed again in a separate set, then moved one by one in a new set
+    SubnetSiteSet *source = new SubnetSiteSet();
+    SubnetParser *sp = new SubnetParser(env);
+    sp->parse(dataset + ".subnet", source);
+    delete sp;
+
+    SubnetSiteSet *dest = new SubnetSiteSet();
+    list<SubnetSite*> *toMove = source->getSubnetSiteList();
+    vector<uint64_t> latencies;
+    latencies.reserve(toMove->size());
+    uint64_t total = 0;
+    while(toMove->size() > 0 && (!merging || latencies.size() < MAX_MERGED_SUBNETS))
+    {
+        SubnetSite *ss = toMove->front();
+        toMove->pop_front();
+
+        uint64_t start = now();
+        if(merging)
+        {
+            unsigned short result = dest->addSite(ss);
+            uint64_t elapsed = now() - start;
+            latencies.push_back(elapsed);
+            total += elapsed;
+
+            // Subnets merged with a subnet of the set are not inserted
+            if(result == SubnetSiteSet::KNOWN_SUBNET || result == SubnetSiteSet::SMALLER_SUBNET)
+                delete ss;
+        }
+        else
+        {
+            dest->addSiteNoMerging(ss);
+            uint64_t elapsed = now() - start;
+            latencies.push_back(elapsed);
+            total += elapsed;
+        }
+    }
+
+    if(merging)
+        this->record("subnetset-add-merging", latencies.size(), total, &latencies);
+    else
+        this->record("subnetset-add-no-merging", latencies.size(), total, &latencies);
+
+    delete dest;
+    delete source;
+}
+
+Soil *Benchmark::benchGrowth()
+{
+    unsigned long nbSubnets = env->getSubnetSet()->getNbSubnets();
+
+    /*
+     * Post-processing is normally part of the preparation (i.e., after new traceroutes), which
+     * first gives each subnet a private copy of its routes, as they are edited in place.
+     */
+
+    list<SubnetSite*> *ssList = env->getSubnetSet()->getSubnetSiteList();
+    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
+        (*it)->unshareRoutes();
+
+    uint64_t start = now();
+    RoutePostProcessor *postProcessor = new RoutePostProcessor(env);
+    postProcessor->process();
+    delete postProcessor;
+    this->record("route-post-processing", nbSubnets, now() - start, NULL);
+
+    start = now();
+    ClassicGrower *grower = new ClassicGrower(env);
+    grower->grow();
+    Soil *soil = grower->getResult();
+    delete grower;
+    this->record("tree-growth", nbSubnets, now() - start, NULL);
+    return soil;
+}
+
+void Benchmark::benchSoil(Soil *soil)
+{
+    vector<uint64_t> latencies;
+    latencies.reserve(subnetIPs.size());
+    uint64_t total = 0;
+    for(size_t i = 0; i < subnetIPs.size(); i++)
+    {
+        uint64_t start = now();
+        soil->getSubnetContaining(subnetIPs[i]);
+        uint64_t elapsed = now() - start;
+        latencies.push_back(elapsed);
+        total += elapsed;
+    }
+    this->record("soil-lookup", subnetIPs.size(), total, &latencies);
+}
+
+void Benchmark::resolveRecursive(AliasResolver *ar,
+                                 NetworkTreeNode *cur,
+                                 unsigned short depth,
+                                 vector<uint64_t> *latencies)
+{
+    vector<NetworkTreeNode*> *children = cur->getChildren();
+    vector<InetAddress> *labels = cur->getLabels();
+
+    bool hasNeighborSubnets = false;
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    {
+        if((*i) != NULL && (*i)->isLeaf())
+        {
+            hasNeighborSubnets = true;
+            break;
+        }
+    }
+
+    // Same condition as in Crow::climbRecursive()
+    if(hasNeighborSubnets || labels->size() > 0)
+    {
+        uint64_t start = now();
+        ar->setCurrentTTL(depth);
+        ar->resolve(cur);
+        latencies->push_back(now() - start);
+    }
+
+    for(vector<NetworkTreeNode*>::iterator i = children->begin(); i != children->end(); ++i)
+    {
+        if((*i) != NULL && (*i)->isInternal())
+            this->resolveRecursive(ar, (*i), depth + 1, latencies);
+    }
+}
+
+void Benchmark::benchAliasResolution(Soil *soil)
+{
+    AliasResolver *ar = new AliasResolver(env);
+    vector<uint64_t> latencies;
+    uint64_t start = now();
+    list<NetworkTree*> *roots = soil->getRootsList();
+    if(roots->size() > 0)
+        this->resolveRecursive(ar, roots->front()->getRoot(), 0, &latencies);
+    uint64_t total = now() - start;
+    delete ar;
+    this->record("alias-resolution", latencies.size(), total, &latencies);
+}
+
+void Benchmark::benchClimbers(Soil *soil)
+{
+    uint64_t start = now();
+    env->openLogStream(label + ".tree", false);
+    Climber *robin = new Robin(env);
+    robin->climb(soil);
+    delete robin;
+    env->closeLogStream();
+    this->record("climber-robin", 1, now() - start, NULL);
+
+    // Aliases were already resolved (see benchAliasResolution()), Crow only outputs them
+    start = now();
+    Crow *crow = new Crow(env);
+    crow->outputAliases(label + ".alias");
+    delete crow;
+    this->record("climber-crow-output", 1, now() - start, NULL);
+
+    start = now();
+    env->openLogStream(label + ".neighborhoods", false);
+    Climber *cat = new Cat(env);
+    cat->climb(soil);
+    delete cat;
+    env->closeLogStream();
+    this->record("climber-cat", 1, now() - start, NULL);
+
+    start = now();
+    env->openLogStream(label + ".l2", false);
+    Climber *termite = new Termite(env);
+    termite->climb(soil);
+    delete termite;
+    env->closeLogStream();
+    this->record("climber-termite", 1, now() - start, NULL);
+
+    start = now();
+    soil->outputSubnets(label + ".subnet");
+    this->record("output-subnets", subnetIPs.size(), now() - start, NULL);
+
+    start = now();
+    env->getIPTable()->outputFingerprints(label + ".fingerprint");
+    this->record("output-fingerprints", 1, now() - start, NULL);
+}
+
+void Benchmark::benchTextCodec()
+{
+    /*
+     * A conversion takes a few dozens of nanoseconds, i.e., about as long as reading the clock,
+     * so each benchmark is timed once over all values rather than value by value. Both sides of
+     * a comparison sum their results, which must be equal.
+     */
+
+    vector<unsigned long> values(NB_CODEC_VALUES);
+    uint32_t x = 1;
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        x = x * 1664525U + 1013904223U;
+        values[i] = (unsigned long) x;
+    }
+
+    ostream *out = env->getOutputStream();
+    char buffer[TextCodec::MAX_ULONG_LENGTH];
+    unsigned long codecSum = 0, legacySum = 0;
+
+    // IPv4 formatting (legacy: InetAddress::getHumanReadableRepresentation() before TextCodec)
+    uint64_t start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+        codecSum += TextCodec::formatIPv4(values[i], buffer);
+    this->record("textcodec-format-ipv4", NB_CODEC_VALUES, now() - start, NULL);
+
+    start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        struct in_addr addr;
+        addr.s_addr = htonl(values[i]);
+        string text(inet_ntoa(addr));
+        legacySum += text.length();
+    }
+    this->record("legacy-format-ipv4", NB_CODEC_VALUES, now() - start, NULL);
+    if(codecSum != legacySum)
+        (*out) << "Warning: TextCodec and inet_ntoa() formatted different addresses." << endl;
+
+    // IPv4 parsing (legacy: inet_aton(), as in InetAddress::setInetAddress(string))
+    const size_t slot = TextCodec::MAX_IPV4_LENGTH + 1;
+    vector<char> texts(NB_CODEC_VALUES * slot);
+    vector<unsigned char> lengths(NB_CODEC_VALUES);
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        size_t length = TextCodec::formatIPv4(values[i], &texts[i * slot]);
+        texts[i * slot + length] = '\0';
+        lengths[i] = (unsigned char) length;
+    }
+
+    codecSum = legacySum = 0;
+    start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        unsigned long ip = 0;
+        TextCodec::parseIPv4(&texts[i * slot], lengths[i], &ip);
+        codecSum += ip;
+    }
+    this->record("textcodec-parse-ipv4", NB_CODEC_VALUES, now() - start, NULL);
+
+    start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        struct in_addr addr;
+        addr.s_addr = 0;
+        inet_aton(&texts[i * slot], &addr);
+        legacySum += (unsigned long) ntohl(addr.s_addr);
+    }
+    this->record("legacy-parse-ipv4", NB_CODEC_VALUES, now() - start, NULL);
+    if(codecSum != legacySum)
+        (*out) << "Warning: TextCodec and inet_aton() parsed different addresses." << endl;
+
+    // Integer formatting (legacy: StringUtils before TextCodec)
+    codecSum = legacySum = 0;
+    start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+        codecSum += TextCodec::formatULong(values[i], buffer);
+    this->record("textcodec-format-ulong", NB_CODEC_VALUES, now() - start, NULL);
+
+    start = now();
+    for(unsigned long i = 0; i < NB_CODEC_VALUES; i++)
+    {
+        stringstream ss;
+        ss << values[i];
+        legacySum += ss.str().length();
+    }
+    this->record("legacy-format-ulong", NB_CODEC_VALUES, now() - start, NULL);
+    if(codecSum != legacySum)
+        (*out) << "Warning: TextCodec and streams formatted different integers." << endl;
+}
+
+void Benchmark::outputResults(string filename)
+{
+    OutputBuffer output(filename);
+    output << "benchmark\tops\ttotal_ns\tops_per_s\tp50_ns\tp90_ns\tp99_ns\tmax_ns\tpeak_rss_kib\n";
+    for(list<Result>::iterator i = results.begin(); i != results.end(); ++i)
+    {
+        Result &r = (*i);
+        unsigned long throughput = 0;
+        if(r.total > 0)
+            throughput = (unsigned long) (((double) r.ops * 1000000000.0) / (double) r.total);
+
+        output << r.name << "\t" << r.ops << "\t" << r.total << "\t" << throughput << "\t";
+        output << r.p50 << "\t" << r.p90 << "\t" << r.p99 << "\t" << r.max << "\t";
+        output << r.peakRSS << "\n";
+    }
+    output.close();
+
+    // File must be accessible to all
+    string path = "./" + filename;
+    chmod(path.c_str(), 0766);
+}
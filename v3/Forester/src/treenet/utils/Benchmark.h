@@ -0,0 +1,119 @@
+/*
+ * Benchmark.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Benchmark runs the offline steps of Forester on a dataset one after the other and measures
+ * each of them, in order to track the performance of the core data structures and phases from a
+ * version to another. It covers the parsers, the IP dictionnary (creation and look-up of entries),
+ * the insertion of subnets in a set (with and without merging), route post-processing, tree
+ * growth, look-ups in the resulting Soil, alias resolution and the outputs of the climbers.
+ * Finally, the conversions of TextCodec (used by all parsers and outputs) are compared with the
+ * system functions and streams they replaced, on a fixed sequence of pseudo-random values.
+ *
+ * Operations which are repeated many times (e.g., look-ups) are timed one by one to get latency
+ * percentiles, while whole phases (e.g., tree growth) are timed once. For each benchmark, the
+ * amount of operations, the total time, the throughput, the percentiles of the latency (in
+ * nanoseconds) and the peak resident memory of the process at the end of the benchmark are
+ * recorded, then written as a tab-separated table (one line per benchmark, with a header) which
+ * can easily be compared from a run to another.
+ *
+ * No probing is involved: the benchmarks only rely on the content of the dataset, which can be a
+ * synthetic one (see DatasetGenerator) to benchmark Forester at various scales.
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <string>
+using std::string;
+#include <list>
+using std::list;
+#include <vector>
+using std::vector;
+#include <inttypes.h> // For uint64_t
+
+#include "../TreeNETEnvironment.h"
+#include "../tree/Soil.h"
+#include "../tree/NetworkTreeNode.h"
+#include "../aliasresolution/AliasResolver.h"
+
+class Benchmark
+{
+public:
+
+    /*
+     * Maximum amount of subnets inserted with merging: each insertion compares the new subnet
+     * with all subnets of the set, so a whole large dataset would take hours (20 000 subnets
+     * already take about a minute).
+     */
+
+    static const unsigned long MAX_MERGED_SUBNETS = 20000;
+
+    // Amount of values converted by each TextCodec benchmark and by its legacy counterpart
+    static const unsigned long NB_CODEC_VALUES = 1000000;
+
+    /*
+     * Constructor (dataset is the prefix of the input files, label the prefix of the files
+     * written by the climbers) and destructor. The subnet set and IP dictionnary of env should be
+     * empty, as the benchmark fills them.
+     */
+
+    Benchmark(TreeNETEnvironment *env, string dataset, string label);
+    ~Benchmark();
+
+    // Runs all benchmarks (false if the dataset could not be parsed)
+    bool run();
+
+    // Writes the results (tab-separated values)
+    void outputResults(string filename);
+
+private:
+
+    // Result of a benchmark (latencies in nanoseconds, peak memory in KiB)
+    struct Result
+    {
+        string name;
+        unsigned long ops;
+        uint64_t total;
+        uint64_t p50, p90, p99, max;
+        unsigned long peakRSS;
+    };
+
+    TreeNETEnvironment *env;
+    string dataset, label;
+    list<Result> results;
+
+    // IPs of the dataset (interfaces and route hops) and base IPs of the subnets
+    vector<InetAddress> IPs, subnetIPs;
+
+    // Records a result (latencies = NULL for a phase timed once) and displays it
+    void record(string name, unsigned long ops, uint64_t total, vector<uint64_t> *latencies);
+
+    // Benchmarks (see run())
+    bool benchParsing();
+    void benchIPTable();
+    void benchSubnetSet(bool merging);
+    Soil *benchGrowth();
+    void benchSoil(Soil *soil);
+    void benchAliasResolution(Soil *soil);
+    void benchClimbers(Soil *soil);
+    void benchTextCodec();
+
+    // Lists the IPs of the subnets currently in the subnet set of env
+    void listIPs();
+
+    // Resolves aliases in a neighborhood and below, timing each neighborhood (like Crow does)
+    void resolveRecursive(AliasResolver *ar,
+                          NetworkTreeNode *cur,
+                          unsigned short depth,
+                          vector<uint64_t> *latencies);
+
+    // Current time (monotonic clock, in nanoseconds) and peak resident memory (in KiB)
+    static uint64_t now();
+    static unsigned long getPeakRSS();
+
+};
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,570 @@
+/*
+ * DatasetGenerator.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in DatasetGenerator.h (see this file to learn further about the
+ * goals of such class).
+ */
+
+#include <cstdlib>
+#include <climits>
+#include <sstream>
+using std::stringstream;
+using std::endl;
+
+#include "DatasetGenerator.h"
+#include "../structure/SubnetSite.h"
+#include "../structure/RouteInterface.h"
+#include "../../common/utils/TextCodec.h"
+
+// Address spaces of router interfaces (10.0.0.0/8) and subnets (100.0.0.0 to 223.255.255.255)
+static const unsigned long ROUTERS_FIRST_IP = 0x0A000001UL;
+static const unsigned long ROUTERS_END_IP = 0x0B000000UL;
+static const unsigned long SUBNETS_FIRST_IP = 0x64000000UL;
+static const unsigned long SUBNETS_END_IP = 0xE0000000UL;
+
+DatasetGenerator::DatasetGenerator(unsigned short nbIPIDs)
+{
+    this->nbIPIDs = nbIPIDs;
+
+    seed = 1;
+    nbSubnets = 10000;
+    trunk = 3;
+    fanout = 4;
+    depth = 6;
+    hederaRate = 0.05;
+    anonymousRate = 0.01;
+    stretchRate = 0.005;
+    cycleRate = 0.005;
+    healthyRate = 0.6;
+    randomRate = 0.1;
+    echoRate = 0.1;
+    namedRate = 0.2;
+    parsePrefixes("24:1/28:2/29:4/30:8/31:2");
+
+    random = NULL;
+    layout = NULL;
+    nextRouterIP = ROUTERS_FIRST_IP;
+    nextSubnetIP = SUBNETS_FIRST_IP;
+    clock = 1000000;
+    nextToken = 1;
+    nbIPs = 0;
+    nbAliases = 0;
+    nbAnomalies = 0;
+}
+
+DatasetGenerator::~DatasetGenerator()
+{
+    if(random != NULL)
+        delete random;
+    if(layout != NULL)
+        delete layout;
+}
+
+bool DatasetGenerator::configure(string settings, string *error)
+{
+    stringstream ss(settings);
+    string setting;
+    while(std::getline(ss, setting, ','))
+    {
+        if(setting.empty())
+            continue;
+
+        size_t equal = setting.find('=');
+        if(equal == string::npos || equal == 0 || equal == setting.size() - 1)
+        {
+            (*error) = "\"" + setting + "\" is not of the form key=value.";
+            return false;
+        }
+
+        string key = setting.substr(0, equal);
+        string value = setting.substr(equal + 1);
+
+        if(key == "prefixes")
+        {
+            if(!parsePrefixes(value))
+            {
+                (*error) = "invalid prefix distribution \"" + value + "\" (expected ";
+                (*error) += "prefix:weight/prefix:weight/..., prefixes being in [20,31]).";
+                return false;
+            }
+            continue;
+        }
+
+        // Integer settings
+        unsigned long *integer = NULL;
+        unsigned short *shortInteger = NULL;
+        unsigned long minimum = 1, maximum = ULONG_MAX;
+        if(key == "seed")
+        {
+            integer = &seed;
+            maximum = 2147483646;
+        }
+        else if(key == "subnets")
+            integer = &nbSubnets;
+        else if(key == "trunk")
+        {
+            shortInteger = &trunk;
+            maximum = 32;
+        }
+        else if(key == "fanout")
+        {
+            shortInteger = &fanout;
+            maximum = 1000;
+        }
+        else if(key == "depth")
+        {
+            shortInteger = &depth;
+            maximum = 32;
+        }
+
+        if(integer != NULL || shortInteger != NULL)
+        {
+            unsigned long n = 0;
+            if(!TextCodec::parseULong(value.c_str(), value.size(), &n) || n < minimum || n > maximum)
+            {
+                stringstream msg;
+                msg << "value of \"" << key << "\" must be an integer in [";
+                msg << minimum << "," << maximum << "].";
+                (*error) = msg.str();
+                return false;
+            }
+
+            if(integer != NULL)
+                (*integer) = n;
+            else
+                (*shortInteger) = (unsigned short) n;
+            continue;
+        }
+
+        // Rates
+        double *rate = NULL;
+        if(key == "hedera")
+            rate = &hederaRate;
+        else if(key == "anonymous")
+            rate = &anonymousRate;
+        else if(key == "stretch")
+            rate = &stretchRate;
+        else if(key == "cycle")
+            rate = &cycleRate;
+        else if(key == "healthy")
+            rate = &healthyRate;
+        else if(key == "random")
+            rate = &randomRate;
+        else if(key == "echo")
+            rate = &echoRate;
+        else if(key == "named")
+            rate = &namedRate;
+
+        if(rate == NULL)
+        {
+            (*error) = "unknown setting \"" + key + "\".";
+            return false;
+        }
+
+        char *end = NULL;
+        double d = std::strtod(value.c_str(), &end);
+        if((*end) != '\0' || d < 0.0 || d > 1.0)
+        {
+            (*error) = "value of \"" + key + "\" must be a real number in [0,1].";
+            return false;
+        }
+        (*rate) = d;
+    }
+
+    if(healthyRate + randomRate + echoRate > 1.0)
+    {
+        (*error) = "the rates of healthy, random and echo counters add up to more than 1.";
+        return false;
+    }
+    return true;
+}
+
+bool DatasetGenerator::parsePrefixes(string value)
+{
+    vector<unsigned short> newPrefixes;
+    vector<double> newWeights;
+    double total = 0.0;
+
+    stringstream ss(value);
+    string entry;
+    while(std::getline(ss, entry, '/'))
+    {
+        size_t colon = entry.find(':');
+        if(colon == string::npos)
+            return false;
+
+        unsigned long prefix = 0;
+        if(!TextCodec::parseULong(entry.c_str(), colon, &prefix) || prefix < 20 || prefix > 31)
+            return false;
+
+        char *end = NULL;
+        double weight = std::strtod(entry.c_str() + colon + 1, &end);
+        if((*end) != '\0' || weight <= 0.0)
+            return false;
+
+        total += weight;
+        newPrefixes.push_back((unsigned short) prefix);
+        newWeights.push_back(total);
+    }
+
+    if(newPrefixes.empty())
+        return false;
+
+    for(size_t i = 0; i < newWeights.size(); i++)
+        newWeights[i] /= total;
+    prefixes = newPrefixes;
+    prefixWeights = newWeights;
+    return true;
+}
+
+double DatasetGenerator::uniform(PRNGenerator *generator)
+{
+    // PRNGenerator gives values in ]0,1[ (multiple of 1/m), shifted to [0,1[
+    double value = generator->getNextRandomNumber() - (1.0 / 2147483647.0);
+    return value < 0.0 ? 0.0 : value;
+}
+
+double DatasetGenerator::nextUniform()
+{
+    return uniform(random);
+}
+
+unsigned long DatasetGenerator::nextInteger(unsigned long n)
+{
+    unsigned long value = (unsigned long) (nextUniform() * (double) n);
+    return value < n ? value : n - 1;
+}
+
+unsigned short DatasetGenerator::nextPrefix()
+{
+    double draw = uniform(layout);
+    size_t index = 0;
+    while(index < prefixes.size() - 1 && draw >= prefixWeights[index])
+        index++;
+    return prefixes[index];
+}
+
+bool DatasetGenerator::nextStretch(unsigned short length)
+{
+    return length > 1 && uniform(layout) < stretchRate;
+}
+
+PRNGenerator *DatasetGenerator::newGenerator(double multiplier)
+{
+    PRNGenerator *generator = new PRNGenerator((double) seed, multiplier, 2147483647);
+
+    // Small seeds give small first values (Lehmer generator), hence a few draws are skipped
+    for(unsigned short i = 0; i < 8; i++)
+        generator->getNextRandomNumber();
+    return generator;
+}
+
+void DatasetGenerator::buildRouters()
+{
+    routers.clear();
+
+    // Routers are capped to the amount of subnets (most routers would be empty otherwise)
+    unsigned long maxRouters = (unsigned long) trunk + nbSubnets;
+
+    vector<unsigned int> frontier, nextFrontier;
+    for(unsigned short i = 0; i < trunk + depth && routers.size() < maxRouters; i++)
+    {
+        nextFrontier.clear();
+        unsigned int nbParents = (i == 0) ? 1 : frontier.size();
+        for(unsigned int j = 0; j < nbParents && routers.size() < maxRouters; j++)
+        {
+            unsigned long nbChildren = 1;
+            if(i >= trunk)
+                nbChildren += nextInteger((unsigned long) 2 * fanout - 1);
+
+            for(unsigned long k = 0; k < nbChildren && routers.size() < maxRouters; k++)
+            {
+                Router r;
+                r.parent = (i == 0) ? 0 : frontier[j];
+                r.depth = i;
+                r.nbIngress = (i > 0 && nextUniform() < hederaRate) ? 2 : 1;
+                for(unsigned short l = 0; l < r.nbIngress; l++)
+                    r.ingress[l] = nextRouterIP++;
+
+                double type = nextUniform();
+                if(type < healthyRate)
+                    r.counterType = IPTableEntry::HEALTHY_COUNTER;
+                else if(type < healthyRate + randomRate)
+                    r.counterType = IPTableEntry::RANDOM_COUNTER;
+                else if(type < healthyRate + randomRate + echoRate)
+                    r.counterType = IPTableEntry::ECHO_COUNTER;
+                else
+                    r.counterType = IPTableEntry::NO_IDEA;
+                r.counterBase = nextInteger(65536);
+                r.velocity = 10.0 + nextUniform() * 990.0;
+                r.initialTTL = (nextUniform() < 0.5) ? 64 : 255;
+                r.named = nextUniform() < namedRate;
+
+                nextFrontier.push_back((unsigned int) routers.size());
+                routers.push_back(r);
+            }
+        }
+        frontier.swap(nextFrontier);
+    }
+}
+
+bool DatasetGenerator::checkAddressSpace(const vector<unsigned int> &amounts, string *error)
+{
+    unsigned long nbRouterIPs = 0;
+    for(size_t i = 0; i < routers.size(); i++)
+        nbRouterIPs += routers[i].nbIngress;
+
+    // Same allocation as writeSubnet() (subnets are written router after router)
+    unsigned long subnetIP = SUBNETS_FIRST_IP;
+    for(size_t i = 0; i < routers.size(); i++)
+    {
+        for(unsigned int j = 0; j < amounts[i]; j++)
+        {
+            unsigned long size = 1UL << (32 - nextPrefix());
+            unsigned long base = (subnetIP + size - 1) & ~(size - 1);
+            if(base + size > SUBNETS_END_IP)
+            {
+                stringstream ss;
+                ss << "the subnets do not fit in the address space (";
+                ss << InetAddress(SUBNETS_FIRST_IP) << " to " << InetAddress(SUBNETS_END_IP - 1);
+                ss << "), try less subnets or longer prefixes.";
+                *error = ss.str();
+                return false;
+            }
+            subnetIP = base + size;
+
+            if(nextStretch(routers[i].depth + 1))
+                nbRouterIPs++;
+        }
+    }
+
+    if(ROUTERS_FIRST_IP + nbRouterIPs > ROUTERS_END_IP)
+    {
+        stringstream ss;
+        ss << "the " << nbRouterIPs << " router interfaces do not fit in the address space (";
+        ss << InetAddress(ROUTERS_FIRST_IP) << " to " << InetAddress(ROUTERS_END_IP - 1);
+        ss << "), try less subnets or a smaller fan-out.";
+        *error = ss.str();
+        return false;
+    }
+    return true;
+}
+
+void DatasetGenerator::writeInterface(OutputBuffer *out,
+                                      unsigned int router,
+                                      unsigned long ip,
+                                      unsigned char TTL)
+{
+    Router &r = routers[router];
+    IPTableEntry *entry = new IPTableEntry(InetAddress(ip), nbIPIDs);
+    entry->setTTL(TTL);
+
+    if(r.counterType == IPTableEntry::ECHO_COUNTER)
+    {
+        entry->setCounterType(IPTableEntry::ECHO_COUNTER);
+        entry->setEchoInitialTTL(r.initialTTL);
+    }
+    else if(r.counterType != IPTableEntry::NO_IDEA)
+    {
+        entry->setEchoInitialTTL(r.initialTTL);
+        for(unsigned short i = 0; i < nbIPIDs; i++)
+        {
+            unsigned long IPID;
+            if(r.counterType == IPTableEntry::HEALTHY_COUNTER)
+                IPID = (r.counterBase + (unsigned long) (r.velocity * (double) clock / 1000000.0)) % 65536;
+            else
+                IPID = nextInteger(65536);
+
+            // Null IP-IDs are seen as missing data (see IPTableEntry::hasIPIDData())
+            entry->setProbeToken(i, nextToken++);
+            entry->setIPIdentifier(i, IPID > 0 ? (unsigned short) IPID : 1);
+            if(i < nbIPIDs - 1)
+            {
+                unsigned long delay = 50000 + nextInteger(100000);
+                entry->setDelay(i, delay);
+                clock += delay;
+            }
+        }
+        clock += 10000;
+    }
+
+    if(r.named)
+    {
+        stringstream name;
+        name << "xe-" << (ip & 0xFFFF) << ".r" << router << ".synthetic.net";
+        entry->setHostName(name.str());
+    }
+
+    entry->writeTo(out);
+    (*out) << "\n";
+    delete entry;
+    nbIPs++;
+}
+
+void DatasetGenerator::writePlainIP(OutputBuffer *out, unsigned long ip, unsigned char TTL)
+{
+    (*out) << InetAddress(ip) << " - " << (unsigned short) TTL << "\n";
+    nbIPs++;
+}
+
+void DatasetGenerator::writeSubnet(unsigned int router,
+                                   OutputBuffer *subnets,
+                                   OutputBuffer *dictionnary,
+                                   vector<unsigned long> *contrapivots)
+{
+    // Prefix and base address (aligned on the size of the subnet, checked by checkAddressSpace())
+    unsigned short prefix = nextPrefix();
+    unsigned long size = 1UL << (32 - prefix);
+    unsigned long base = (nextSubnetIP + size - 1) & ~(size - 1);
+    nextSubnetIP = base + size;
+
+    // Route: ingress interfaces of the routers from the first one to the given one
+    unsigned short length = routers[router].depth + 1;
+    vector<unsigned long> hops(length, 0);
+    unsigned int current = router;
+    for(unsigned short i = length; i > 0; i--)
+    {
+        Router &r = routers[current];
+        hops[i - 1] = r.ingress[r.nbIngress > 1 ? nextInteger(2) : 0];
+        current = r.parent;
+    }
+
+    // Anomalies: extra hop (stretch), repeated hop (cycle) and anonymous hops
+    if(nextStretch(length))
+    {
+        unsigned short position = 1 + (unsigned short) nextInteger(length - 1);
+        unsigned long extraHop = nextRouterIP++;
+        hops.insert(hops.begin() + position, extraHop);
+        writePlainIP(dictionnary, extraHop, (unsigned char) (position + 1));
+        length++;
+        nbAnomalies++;
+    }
+    if(length > 2 && nextUniform() < cycleRate)
+    {
+        unsigned short position = 2 + (unsigned short) nextInteger(length - 2);
+        hops[position] = hops[position - 2];
+        nbAnomalies++;
+    }
+
+    RouteInterface *route = new RouteInterface[length];
+    for(unsigned short i = 0; i < length; i++)
+    {
+        if(nextUniform() < anonymousRate)
+        {
+            route[i] = RouteInterface(InetAddress(0), true);
+            nbAnomalies++;
+        }
+        else
+            route[i] = RouteInterface(InetAddress(hops[i]));
+    }
+
+    SubnetSite *ss = new SubnetSite();
+    ss->setInferredSubnetBaseIP(InetAddress(base));
+    ss->setInferredSubnetPrefixLength((unsigned char) prefix);
+    ss->setRouteSize(length);
+    ss->setRoute(route);
+
+    // Contra-pivot (interface of the router) and pivots
+    unsigned char pivotTTL = (unsigned char) (length + 1);
+    unsigned long contrapivot = (prefix < 31) ? base + 1 : base;
+    ss->insert(new SubnetSiteNode(InetAddress(contrapivot), (unsigned char) length));
+    ss->setStatus(SubnetSite::ACCURATE_SUBNET);
+    writeInterface(dictionnary, router, contrapivot, (unsigned char) length);
+    contrapivots->push_back(contrapivot);
+
+    unsigned long firstPivot = contrapivot + 1;
+    unsigned long nbPivots = (prefix < 30) ? 1 + nextInteger(3) : 1;
+
+    for(unsigned long i = 0; i < nbPivots; i++)
+    {
+        ss->insert(new SubnetSiteNode(InetAddress(firstPivot + i), pivotTTL));
+        writePlainIP(dictionnary, firstPivot + i, pivotTTL);
+    }
+
+    ss->writeTo(subnets);
+    (*subnets) << "\n";
+    delete ss;
+}
+
+bool DatasetGenerator::generate(string prefix, ostream *out)
+{
+    if(random != NULL)
+        delete random;
+    if(layout != NULL)
+        delete layout;
+    random = newGenerator(16807);
+    layout = newGenerator(48271);
+
+    nextRouterIP = ROUTERS_FIRST_IP;
+    nextSubnetIP = SUBNETS_FIRST_IP;
+    clock = 1000000;
+    nextToken = 1;
+    nbIPs = 0;
+    nbAliases = 0;
+    nbAnomalies = 0;
+
+    buildRouters();
+
+    // Subnets are located behind any router which is not part of the trunk (or the last one)
+    unsigned int firstLastHop = trunk - 1;
+    if(firstLastHop >= routers.size())
+        firstLastHop = routers.size() - 1;
+    vector<unsigned int> amounts(routers.size(), 0);
+    for(unsigned long i = 0; i < nbSubnets; i++)
+        amounts[firstLastHop + nextInteger(routers.size() - firstLastHop)]++;
+
+    // Layout is replayed (then drawn again while writing) to check the address spaces first
+    string error = "";
+    bool fits = checkAddressSpace(amounts, &error);
+    delete layout;
+    layout = newGenerator(48271);
+    if(!fits)
+    {
+        (*out) << "Cannot generate the synthetic dataset: " << error << endl;
+        return false;
+    }
+
+    OutputBuffer subnets(prefix + ".subnet");
+    OutputBuffer dictionnary(prefix + ".ip");
+    OutputBuffer aliases(prefix + ".alias");
+
+    unsigned long nbWritten = 0;
+    vector<unsigned long> contrapivots;
+    for(unsigned int i = 0; i < routers.size(); i++)
+    {
+        Router &r = routers[i];
+        for(unsigned short j = 0; j < r.nbIngress; j++)
+            writeInterface(&dictionnary, i, r.ingress[j], (unsigned char) (r.depth + 1));
+
+        contrapivots.clear();
+        for(unsigned int j = 0; j < amounts[i]; j++)
+        {
+            writeSubnet(i, &subnets, &dictionnary, &contrapivots);
+            nbWritten++;
+        }
+
+        // Ground truth alias (only routers with several interfaces)
+        if(r.nbIngress + contrapivots.size() < 2)
+            continue;
+
+        for(unsigned short j = 0; j < r.nbIngress; j++)
+            aliases << (j > 0 ? " " : "") << InetAddress(r.ingress[j]);
+        for(size_t j = 0; j < contrapivots.size(); j++)
+            aliases << " " << InetAddress(contrapivots[j]);
+        aliases << "\n";
+        nbAliases++;
+    }
+
+    subnets.close();
+    dictionnary.close();
+    aliases.close();
+
+    (*out) << "Generated " << nbWritten << " subnets behind " << routers.size() << " routers ";
+    (*out) << "(" << nbIPs << " IPs, " << nbAliases << " aliases, " << nbAnomalies << " route ";
+    (*out) << "anomalies) in " << prefix << ".subnet, " << prefix << ".ip and " << prefix;
+    (*out) << ".alias." << endl;
+    return true;
+}
@@ -0,0 +1,142 @@
+/*
+ * DatasetGenerator.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * DatasetGenerator creates synthetic datasets (a .subnet dump, an IP dictionnary and the
+ * corresponding .alias file) which Forester can parse like any dataset produced by Arborist. It
+ * is meant for benchmarking and profiling the offline steps of Forester (parsing, tree growth,
+ * alias resolution) at any scale, without any measurement campaign, and for reproducing a given
+ * workload exactly (the whole dataset only depends on the settings, including the seed).
+ *
+ * The generated network is a tree of routers: a trunk (chain of routers seen by all routes)
+ * followed by branches of random fan-out, each subnet being located behind a random router of
+ * the branches. A route to a subnet consists of the ingress interfaces of the routers on the path
+ * from the vantage point; a router can have two ingress interfaces (a "hedera" in the tree), each
+ * route using one of them. Routes can be altered with the anomalies Forester has to deal with:
+ * anonymous hops, stretched routes (an extra hop shifts the next ones) and cycles (a hop repeats
+ * an earlier one). The last interface of the router on the path of a subnet is its contra-pivot.
+ *
+ * Each router also gets an IP-ID counter behaviour (healthy, random, echo or no reply at all)
+ * which is used to forge the alias resolution hints of all its interfaces, such that the .alias
+ * file (one router per line) is the ground truth of alias resolution.
+ *
+ * Settings are given as a list of "key=value" separated by commas (see configure() and the
+ * usage of Forester for the list of keys). Subnets are generated router after router and written
+ * immediately, such that memory usage only depends on the amount of routers.
+ *
+ * The draws which decide how many addresses are used (prefix lengths and stretched routes) come
+ * from a second generator, such that they can be replayed before writing anything: a dataset
+ * which would not fit in the address space is rejected without creating any file.
+ */
+
+#ifndef DATASETGENERATOR_H_
+#define DATASETGENERATOR_H_
+
+#include <ostream>
+using std::ostream;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+
+#include "../../common/inet/InetAddress.h"
+#include "../../common/random/PRNGenerator.h"
+#include "../structure/IPTableEntry.h"
+#include "OutputBuffer.h"
+
+class DatasetGenerator
+{
+public:
+
+    // Constructor (nbIPIDs = amount of IP-IDs per IP in the dictionnary), destructor
+    DatasetGenerator(unsigned short nbIPIDs);
+    ~DatasetGenerator();
+
+    /*
+     * Parses the settings "key1=value1,key2=value2,...". Keys which are not set keep their
+     * default value. Returns false (and sets error) if a key is unknown or a value is invalid.
+     */
+
+    bool configure(string settings, string *error);
+
+    /*
+     * Writes [prefix].subnet, [prefix].ip and [prefix].alias, then sums up the dataset in out.
+     * Returns false (without writing any file) if the dataset does not fit in the address space.
+     */
+
+    bool generate(string prefix, ostream *out);
+
+private:
+
+    // Router of the synthetic network
+    struct Router
+    {
+        unsigned int parent; // Index of the parent router (itself for the first router)
+        unsigned short depth; // 0 for the first router, i.e., a TTL of 1
+        unsigned long ingress[2]; // Ingress interface(s)
+        unsigned short nbIngress;
+        unsigned short counterType; // See IPTableEntry::IPIDCounterClasses
+        unsigned long counterBase;
+        double velocity; // IP-ID increase per second (healthy counters)
+        unsigned char initialTTL;
+        bool named; // True if its interfaces have host names
+    };
+
+    // Settings
+    unsigned short nbIPIDs;
+    unsigned long seed, nbSubnets;
+    unsigned short trunk, fanout, depth;
+    double hederaRate, anonymousRate, stretchRate, cycleRate;
+    double healthyRate, randomRate, echoRate, namedRate;
+    vector<unsigned short> prefixes;
+    vector<double> prefixWeights; // Cumulative
+
+    // Generation state
+    PRNGenerator *random, *layout; // Layout: prefix lengths and stretches only
+    vector<Router> routers;
+    unsigned long nextRouterIP, nextSubnetIP;
+    unsigned long clock, nextToken; // Simulated time (in microseconds) and probe tokens
+    unsigned long nbIPs, nbAliases, nbAnomalies;
+
+    // Random values: uniform in [0,1[ and integer in [0,n[
+    static double uniform(PRNGenerator *generator);
+    double nextUniform();
+    unsigned long nextInteger(unsigned long n);
+
+    // Draws from the layout generator: prefix length of a subnet, stretch of its route
+    unsigned short nextPrefix();
+    bool nextStretch(unsigned short length);
+
+    // New generator starting from the seed (the multiplier selects the sequence)
+    PRNGenerator *newGenerator(double multiplier);
+
+    // Parses a prefix distribution ("prefix:weight/prefix:weight/...")
+    bool parsePrefixes(string value);
+
+    // Builds the tree of routers
+    void buildRouters();
+
+    /*
+     * Replays the layout of the subnets (amounts gives the amount of subnets behind each router)
+     * and checks it fits in the address spaces. Returns false and sets error otherwise.
+     */
+
+    bool checkAddressSpace(const vector<unsigned int> &amounts, string *error);
+
+    // Writes the entry of an interface of a router in the IP dictionnary
+    void writeInterface(OutputBuffer *out, unsigned int router, unsigned long ip, unsigned char TTL);
+
+    // Writes the entry of an interface which does not belong to a router (pivots, stretches)
+    void writePlainIP(OutputBuffer *out, unsigned long ip, unsigned char TTL);
+
+    // Generates and writes one subnet located behind a given router
+    void writeSubnet(unsigned int router,
+                     OutputBuffer *subnets,
+                     OutputBuffer *dictionnary,
+                     vector<unsigned long> *contrapivots);
+
+};
+
+#endif /* DATASETGENERATOR_H_ */
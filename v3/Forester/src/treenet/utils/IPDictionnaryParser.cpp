@@ -470,3 +470,87 @@ bool IPDictionnaryParser::parse(string inputFileName)
     
     return true;
 }
+
+bool IPDictionnaryParser::parseFreshness(string inputFileName)
+{
+    unsigned short displayMode = env->getDisplayMode();
+    IPLookUpTable *dictionnary = env->getIPTable();
+    ostream *out = env->getOutputStream();
+    
+    string inputFileContent = "";
+    ifstream inFile;
+    inFile.open((inputFileName).c_str());
+    if(inFile.is_open())
+    {
+        inputFileContent.assign((std::istreambuf_iterator<char>(inFile)),
+                                (std::istreambuf_iterator<char>()));
+        
+        inFile.close();
+    }
+    else
+    {
+        return false;
+    }
+    
+    (*out) << "Parsing " << inputFileName << "..." << endl;
+    
+    stringstream ss(inputFileContent);
+    string targetStr;
+    
+    unsigned int nbLine = 0, nbParsed = 0;
+    while (std::getline(ss, targetStr, '\n'))
+    {
+        nbLine++;
+    
+        if(targetStr.size() == 0)
+            continue;
+        
+        size_t pos = targetStr.find(" - ");
+        if(pos == std::string::npos)
+        {
+            if(displayMode >= TreeNETEnvironment::DISPLAY_MODE_SLIGHTLY_VERBOSE)
+                (*out) << "Line " << nbLine << " does not match expected IP - times syntax." << endl;
+            continue;
+        }
+        
+        string IPStr = targetStr.substr(0, pos);
+        list<string> timesLs = explode(targetStr.substr(pos + 3), ',');
+        if(timesLs.size() != IPTableEntry::NB_HINT_TYPES)
+        {
+            if(displayMode >= TreeNETEnvironment::DISPLAY_MODE_SLIGHTLY_VERBOSE)
+                (*out) << "Unexpected amount of collection times at line " << nbLine << "." << endl;
+            continue;
+        }
+        
+        InetAddress IP(0);
+        try
+        {
+            IP.setInetAddress(IPStr);
+        }
+        catch (InetAddressException &e)
+        {
+            if(displayMode >= TreeNETEnvironment::DISPLAY_MODE_SLIGHTLY_VERBOSE)
+            {
+                (*out) << "Malformed/Unrecognized IP \"" + IPStr;
+                (*out) << "\" at line " << nbLine << "." << endl;
+            }
+            continue;
+        }
+        
+        IPTableEntry *entry = dictionnary->lookUp(IP);
+        if(entry == NULL)
+            continue;
+        
+        for(unsigned short i = 0; i < IPTableEntry::NB_HINT_TYPES; i++)
+        {
+            entry->setHintCollectionTime(i, std::strtoul(timesLs.front().c_str(), NULL, 10));
+            timesLs.pop_front();
+        }
+        nbParsed++;
+    }
+    
+    (*out) << "Parsing of " << inputFileName << " completed. Collection times of alias ";
+    (*out) << "resolution hints were retrieved for " << nbParsed << " IPs.\n" << endl;
+    
+    return true;
+}
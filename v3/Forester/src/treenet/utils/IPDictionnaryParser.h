@@ -43,6 +43,15 @@ public:
     
     // Parsing method (returns true if a file was opened and parsed)
     bool parse(string inputFileName);
+    
+    /*
+     * Parses the collection times of the alias resolution hints (i.e., a .freshness file, with 
+     * lines "[IP] - [t0],[t1],[t2],[t3]", one time per IPTableEntry::AliasHintTypes value) and 
+     * assigns them to the IPs already in the dictionnary (other IPs are ignored). Returns true if 
+     * the file could be opened. It should be called after parse(), as it does not create entries.
+     */
+    
+    bool parseFreshness(string inputFileName);
 
 private:
     
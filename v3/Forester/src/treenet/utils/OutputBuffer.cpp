@@ -0,0 +1,139 @@
+/*
+ * OutputBuffer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in OutputBuffer.h (see this file to learn further about the goals
+ * of such class).
+ */
+
+#include "OutputBuffer.h"
+
+OutputBuffer::OutputBuffer()
+{
+    this->capacity = 0;
+    this->length = 0;
+    this->toFile = false;
+}
+
+OutputBuffer::OutputBuffer(string filename, size_t capacity)
+{
+    this->capacity = capacity;
+    this->length = 0;
+    this->toFile = true;
+    buffer.reserve(capacity);
+    file.open(filename.c_str());
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    this->close();
+}
+
+void OutputBuffer::write(const char *data, size_t length)
+{
+    if(toFile && buffer.size() + length > capacity)
+    {
+        this->flush();
+
+        // Data larger than the whole buffer goes directly to the file
+        if(length > capacity)
+        {
+            file.write(data, length);
+            this->length += length;
+            return;
+        }
+    }
+    buffer.append(data, length);
+    this->length += length;
+}
+
+OutputBuffer &OutputBuffer::operator<<(const char *str)
+{
+    const char *end = str;
+    while((*end) != '\0')
+        end++;
+    this->write(str, (size_t) (end - str));
+    return (*this);
+}
+
+OutputBuffer &OutputBuffer::operator<<(const string &str)
+{
+    this->write(str.data(), str.size());
+    return (*this);
+}
+
+OutputBuffer &OutputBuffer::operator<<(char c)
+{
+    this->write(&c, 1);
+    return (*this);
+}
+
+OutputBuffer &OutputBuffer::operator<<(unsigned long long n)
+{
+    char text[TextCodec::MAX_ULONG_LENGTH];
+    this->write(text, TextCodec::formatULongLong(n, text));
+    return (*this);
+}
+
+OutputBuffer &OutputBuffer::operator<<(unsigned long n)
+{
+    char text[TextCodec::MAX_ULONG_LENGTH];
+    this->write(text, TextCodec::formatULong(n, text));
+    return (*this);
+}
+
+OutputBuffer &OutputBuffer::operator<<(unsigned int n)
+{
+    return (*this) << (unsigned long) n;
+}
+
+OutputBuffer &OutputBuffer::operator<<(unsigned short n)
+{
+    return (*this) << (unsigned long) n;
+}
+
+OutputBuffer &OutputBuffer::operator<<(long n)
+{
+    if(n < 0)
+    {
+        this->write("-", 1);
+        return (*this) << (unsigned long) (-(n + 1)) + 1;
+    }
+    return (*this) << (unsigned long) n;
+}
+
+OutputBuffer &OutputBuffer::operator<<(int n)
+{
+    return (*this) << (long) n;
+}
+
+OutputBuffer &OutputBuffer::operator<<(const InetAddress &ip)
+{
+    char text[TextCodec::MAX_IPV4_LENGTH];
+    this->write(text, TextCodec::formatIPv4(ip.getULongAddress(), text));
+    return (*this);
+}
+
+void OutputBuffer::flush()
+{
+    if(!toFile)
+        return;
+
+    if(buffer.size() > 0)
+    {
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    file.flush();
+}
+
+void OutputBuffer::close()
+{
+    if(!toFile || !file.is_open())
+        return;
+
+    this->flush();
+    file.close();
+}
@@ -0,0 +1,80 @@
+/*
+ * OutputBuffer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * OutputBuffer is used to write the output files of TreeNET (subnet dumps, IP dictionnary,
+ * fingerprints, aliases, etc.). These files used to be built as one single string (each record
+ * being formatted with a stringstream then appended to the string) before being written, which
+ * doubled the memory needed to output large datasets and spent a lot of time re-allocating the
+ * string. Instead, records are now formatted directly in a large buffer of fixed capacity, which
+ * is written to the file each time it is full, such that the memory used to output a file does
+ * not depend on its size.
+ *
+ * Numbers and IPs are formatted with TextCodec rather than through a stream. The result is
+ * exactly the same as what a stream gives (no leading zero, IPs in dotted-decimal notation).
+ *
+ * An OutputBuffer created without a file name is never flushed and keeps all its content in
+ * memory (see str()). It is used to implement the toString() methods of the records on top of
+ * the methods writing them in a buffer.
+ */
+
+#ifndef OUTPUTBUFFER_H_
+#define OUTPUTBUFFER_H_
+
+#include <cstddef>
+using std::size_t;
+#include <string>
+using std::string;
+#include <fstream>
+using std::ofstream;
+
+#include "../../common/inet/InetAddress.h"
+#include "../../common/utils/TextCodec.h"
+
+class OutputBuffer
+{
+public:
+
+    // Default capacity of a buffer written to a file (1 MiB)
+    static const size_t DEFAULT_CAPACITY = 1048576;
+
+    // Constructors (the first keeps everything in memory) and destructor (flushes and closes)
+    OutputBuffer();
+    OutputBuffer(string filename, size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+
+    // Appends raw data
+    void write(const char *data, size_t length);
+
+    // Formatting operators
+    OutputBuffer &operator<<(const char *str);
+    OutputBuffer &operator<<(const string &str);
+    OutputBuffer &operator<<(char c);
+    OutputBuffer &operator<<(unsigned long long n);
+    OutputBuffer &operator<<(unsigned long n);
+    OutputBuffer &operator<<(unsigned int n);
+    OutputBuffer &operator<<(unsigned short n);
+    OutputBuffer &operator<<(long n);
+    OutputBuffer &operator<<(int n);
+    OutputBuffer &operator<<(const InetAddress &ip);
+
+    // Writes the buffered data to the file (if any), close() also closes the file
+    void flush();
+    void close();
+
+    // Amount of bytes appended so far (written or not) and content of an in-memory buffer
+    inline size_t getLength() { return this->length; }
+    inline string str() { return this->buffer; }
+
+private:
+
+    string buffer;
+    size_t capacity, length;
+    ofstream file;
+    bool toFile;
+
+};
+
+#endif /* OUTPUTBUFFER_H_ */
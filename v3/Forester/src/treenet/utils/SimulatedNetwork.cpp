@@ -0,0 +1,646 @@
+/*
+ * SimulatedNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in SimulatedNetwork.h (see this file to learn further about the
+ * goals of such class).
+ */
+
+#include <cstdlib>
+#include <sstream>
+using std::stringstream;
+#include <fstream>
+using std::ifstream;
+#include <algorithm>
+using std::sort;
+using std::unique;
+using std::endl;
+
+#include "SimulatedNetwork.h"
+#include "../../common/utils/TextCodec.h"
+#include "../structure/RouteInterface.h"
+
+const double SimulatedNetwork::RANDOM_COUNTER_VELOCITY = 50000.0;
+
+SimulatedNetwork::SimulatedNetwork():
+networkMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    seed = 1;
+    latency = 1000;
+    jitter = 500;
+    rateLimit = 0;
+    loadBalancingRate = 0.0;
+    anonymousRate = 0.0;
+    lossRate = 0.0;
+
+    clock = *(TimeVal::getCurrentSystemTime());
+    origin = clock;
+    nbProbes = 0;
+    nbReplies = 0;
+    nbLost = 0;
+    nbRateLimited = 0;
+    nbTimeouts = 0;
+    waitingTime = 0;
+}
+
+SimulatedNetwork::~SimulatedNetwork()
+{
+}
+
+bool SimulatedNetwork::configure(string settings, string *error)
+{
+    stringstream ss(settings);
+    string setting;
+    while(std::getline(ss, setting, ','))
+    {
+        if(setting.empty())
+            continue;
+
+        size_t equal = setting.find('=');
+        if(equal == string::npos || equal == 0 || equal == setting.size() - 1)
+        {
+            (*error) = "\"" + setting + "\" is not of the form key=value.";
+            return false;
+        }
+
+        string key = setting.substr(0, equal);
+        string value = setting.substr(equal + 1);
+
+        // Integer settings
+        unsigned long *integer = NULL;
+        unsigned long minimum = 0, maximum = 60000000;
+        if(key == "seed")
+        {
+            unsigned long n = 0;
+            if(!TextCodec::parseULong(value.c_str(), value.size(), &n))
+            {
+                (*error) = "value of \"seed\" must be a positive integer.";
+                return false;
+            }
+            seed = (uint64_t) n;
+            continue;
+        }
+        else if(key == "latency")
+            integer = &latency;
+        else if(key == "jitter")
+            integer = &jitter;
+        else if(key == "ratelimit")
+        {
+            integer = &rateLimit;
+            maximum = 1000000000;
+        }
+
+        if(integer != NULL)
+        {
+            unsigned long n = 0;
+            if(!TextCodec::parseULong(value.c_str(), value.size(), &n) || n < minimum || n > maximum)
+            {
+                stringstream msg;
+                msg << "value of \"" << key << "\" must be an integer in [";
+                msg << minimum << "," << maximum << "].";
+                (*error) = msg.str();
+                return false;
+            }
+            (*integer) = n;
+            continue;
+        }
+
+        // Rates
+        double *rate = NULL;
+        if(key == "loadbalancing")
+            rate = &loadBalancingRate;
+        else if(key == "anonymous")
+            rate = &anonymousRate;
+        else if(key == "loss")
+            rate = &lossRate;
+
+        if(rate == NULL)
+        {
+            (*error) = "unknown setting \"" + key + "\".";
+            return false;
+        }
+
+        char *end = NULL;
+        double d = std::strtod(value.c_str(), &end);
+        if((*end) != '\0' || d < 0.0 || d > 1.0)
+        {
+            (*error) = "value of \"" + key + "\" must be a real number in [0,1].";
+            return false;
+        }
+        (*rate) = d;
+    }
+    return true;
+}
+
+bool SimulatedNetwork::build(TreeNETEnvironment *env, string aliasFile)
+{
+    list<SubnetSite*> *ssList = env->getSubnetSet()->getSubnetSiteList();
+    if(ssList->size() == 0)
+        return false;
+
+    // Subnets, routes and interfaces
+    for(list<SubnetSite*>::iterator it = ssList->begin(); it != ssList->end(); ++it)
+    {
+        SubnetSite *ss = (*it);
+        unsigned short routeSize = ss->getRouteSize();
+        RouteView route = ss->getRouteView();
+        if(route.isEmpty())
+            routeSize = 0;
+
+        // N.B.: NetworkAddress::getUpperBorderAddress() assumes 32-bit longs, hence the computation
+        Subnet subnet;
+        unsigned char prefixLength = ss->getInferredSubnetPrefixLength();
+        subnet.lower = ss->getInferredSubnetBaseIP().getULongAddress();
+        subnet.upper = subnet.lower + (1UL << (32 - (prefixLength <= 32 ? prefixLength : 32))) - 1;
+        subnet.route = (unsigned int) hops.size();
+        subnet.routeSize = routeSize;
+        subnet.TTL = routeSize > 0 ? (unsigned char) (routeSize + 1) : ss->getGreatestTTL();
+        subnets.push_back(subnet);
+
+        for(unsigned short i = 0; i < routeSize; i++)
+        {
+            unsigned long hop = route[i].ip.getULongAddress();
+            hops.push_back(hop);
+            if(hop == 0)
+                continue;
+
+            Interface in;
+            in.ip = hop;
+            in.route = subnet.route;
+            in.routeSize = i;
+            in.TTL = (unsigned char) (i + 1);
+            in.live = false;
+            interfaces.push_back(in);
+
+            if(hopsPerTTL.size() <= i)
+                hopsPerTTL.resize(i + 1);
+            hopsPerTTL[i].push_back(hop);
+        }
+
+        list<SubnetSiteNode*> *IPs = ss->getSubnetIPList();
+        for(list<SubnetSiteNode*>::iterator i = IPs->begin(); i != IPs->end(); ++i)
+        {
+            Interface in;
+            in.ip = (*i)->ip.getULongAddress();
+            in.route = subnet.route;
+            in.TTL = (*i)->TTL;
+            in.routeSize = (in.TTL > 0 && in.TTL - 1 < routeSize) ? in.TTL - 1 : routeSize;
+            in.live = true;
+            interfaces.push_back(in);
+        }
+    }
+
+    sort(subnets.begin(), subnets.end(), compareSubnets);
+    sort(interfaces.begin(), interfaces.end(), compareInterfaces);
+    vector<Interface> distinct;
+    distinct.reserve(interfaces.size());
+    for(vector<Interface>::iterator it = interfaces.begin(); it != interfaces.end(); ++it)
+        if(distinct.size() == 0 || distinct.back().ip != it->ip)
+            distinct.push_back(*it);
+    interfaces.swap(distinct);
+
+    for(unsigned short i = 0; i < hopsPerTTL.size(); i++)
+    {
+        vector<unsigned long> &atTTL = hopsPerTTL[i];
+        sort(atTTL.begin(), atTTL.end());
+        atTTL.erase(unique(atTTL.begin(), atTTL.end()), atTTL.end());
+    }
+
+    // Routers: lines of the .alias file, then one router per remaining IP
+    map<unsigned long, unsigned int> routerOf;
+    ifstream aliases(aliasFile.c_str());
+    if(aliases.is_open())
+    {
+        string line;
+        while(std::getline(aliases, line))
+        {
+            stringstream ls(line);
+            string token;
+            bool newRouter = false;
+            while(ls >> token)
+            {
+                unsigned long ip = 0;
+                if(!TextCodec::parseIPv4(token.c_str(), token.size(), &ip))
+                    continue;
+                if(!newRouter)
+                {
+                    routers.push_back(Router());
+                    newRouter = true;
+                }
+                routerOf[ip] = (unsigned int) routers.size() - 1;
+            }
+        }
+        aliases.close();
+    }
+
+    IPLookUpTable *table = env->getIPTable();
+    unsigned short nbIPIDs = env->getNbIPIDs();
+    vector<bool> configured(routers.size(), false);
+    for(vector<Interface>::iterator it = interfaces.begin(); it != interfaces.end(); ++it)
+    {
+        map<unsigned long, unsigned int>::iterator r = routerOf.find(it->ip);
+        if(r != routerOf.end())
+        {
+            it->router = r->second;
+        }
+        else
+        {
+            it->router = (unsigned int) routers.size();
+            routers.push_back(Router());
+            configured.push_back(false);
+        }
+
+        it->replyingToTS = false;
+        it->portUnreachableSrcIP = 0;
+        IPTableEntry *entry = table->lookUp(InetAddress(it->ip));
+        if(entry == NULL)
+            continue;
+
+        it->replyingToTS = entry->repliesToTSRequest();
+        it->portUnreachableSrcIP = entry->getPortUnreachableSrcIP().getULongAddress();
+        string hostName = entry->getHostName();
+        if(!hostName.empty())
+            hostNames[it->ip] = hostName;
+
+        // IPs of the routes are only live if they replied during the alias resolution hints
+        if(entry->hasIPIDData() || entry->getIPIDCounterType() == IPTableEntry::ECHO_COUNTER)
+        {
+            it->live = true;
+            if(!configured[it->router])
+            {
+                setCounter(&routers[it->router], entry, nbIPIDs, it->ip);
+                configured[it->router] = true;
+            }
+        }
+    }
+
+    for(unsigned int i = 0; i < routers.size(); i++)
+    {
+        if(!configured[i])
+            setCounter(&routers[i], NULL, nbIPIDs, i);
+        routers[i].anonymous = uniform(1, i) < anonymousRate;
+        routers[i].tokens = (double) rateLimit;
+        routers[i].lastRefill = 0;
+    }
+
+    origin = clock;
+    return true;
+}
+
+ProbeRecord *SimulatedNetwork::respond(const InetAddress &dst,
+                                       unsigned short IPIdentifier,
+                                       unsigned char TTL,
+                                       int protocol,
+                                       bool timestampRequest,
+                                       bool,
+                                       unsigned short srcPortORICMPid,
+                                       unsigned short dstPortORICMPseq,
+                                       const TimeVal &timeout,
+                                       const TimeVal &reqTime)
+{
+    unsigned long target = dst.getULongAddress();
+    unsigned long timeoutMicro = timeout.getSecondsPart() * 1000000 + timeout.getMicroSecondsPart();
+    uint64_t flow = ((uint64_t) srcPortORICMPid << 16) | (uint64_t) dstPortORICMPseq;
+
+    ProbeRecord *record = new ProbeRecord(dst,
+                                          InetAddress(0),
+                                          reqTime,
+                                          reqTime + timeout,
+                                          TTL,
+                                          0,
+                                          255,
+                                          255,
+                                          IPIdentifier);
+
+    networkMutex.lock();
+    nbProbes++;
+    unsigned long time = toNetworkTime(reqTime);
+
+    // Route towards the destination and its distance
+    Interface *dstInterface = findInterface(target);
+    unsigned int route = 0;
+    unsigned short routeSize = 0;
+    unsigned char distance = 0;
+    if(dstInterface != NULL)
+    {
+        route = dstInterface->route;
+        routeSize = dstInterface->routeSize;
+        distance = dstInterface->TTL;
+    }
+    else
+    {
+        Subnet *subnet = findSubnet(target);
+        if(subnet != NULL)
+        {
+            route = subnet->route;
+            routeSize = subnet->routeSize;
+            distance = subnet->TTL;
+        }
+    }
+
+    // Replying IP and router (if any)
+    unsigned long replying = 0;
+    Router *router = NULL;
+    unsigned char type = 255, code = 255, travelled = 0;
+    if(distance > 0 && lossRate > 0.0 && uniform(2, target, ((uint64_t) TTL << 16) | IPIdentifier, flow) < lossRate)
+    {
+        nbLost++;
+    }
+    else if(distance > 0 && TTL < distance)
+    {
+        unsigned long hop = getHop(route, routeSize, TTL, flow);
+        Interface *hopInterface = hop != 0 ? findInterface(hop) : NULL;
+        if(hopInterface != NULL && !routers[hopInterface->router].anonymous)
+        {
+            replying = hop;
+            router = &routers[hopInterface->router];
+            type = DirectProber::ICMP_TYPE_TIME_EXCEEDED;
+            code = 0;
+            travelled = TTL;
+        }
+    }
+    else if(distance > 0 && dstInterface != NULL && dstInterface->live)
+    {
+        router = &routers[dstInterface->router];
+        travelled = distance;
+        if(protocol == IPPROTO_UDP)
+        {
+            replying = dstInterface->portUnreachableSrcIP != 0 ? dstInterface->portUnreachableSrcIP : target;
+            type = DirectProber::ICMP_TYPE_DESTINATION_UNREACHABLE;
+            code = DirectProber::ICMP_CODE_PORT_UNREACHABLE;
+        }
+        else if(protocol == IPPROTO_TCP)
+        {
+            replying = target;
+            type = DirectProber::PSEUDO_TCP_RESET_ICMP_TYPE;
+            code = DirectProber::PSEUDO_TCP_RESET_ICMP_CODE;
+        }
+        else if(timestampRequest)
+        {
+            if(dstInterface->replyingToTS)
+            {
+                replying = target;
+                type = DirectProber::ICMP_TYPE_TS_REPLY;
+                code = 0;
+            }
+        }
+        else
+        {
+            replying = target;
+            type = DirectProber::ICMP_TYPE_ECHO_REPLY;
+            code = 0;
+        }
+    }
+
+    if(replying != 0 && !takeToken(router, time))
+    {
+        nbRateLimited++;
+        replying = 0;
+    }
+
+    unsigned long RTT = timeoutMicro;
+    if(replying != 0)
+    {
+        RTT = latency * travelled;
+        if(jitter > 0)
+            RTT += (unsigned long) (hash(3, target, TTL, flow ^ IPIdentifier) % (jitter + 1));
+
+        if(RTT > timeoutMicro)
+        {
+            nbTimeouts++;
+            RTT = timeoutMicro;
+        }
+        else
+        {
+            TimeVal rplyTime = reqTime + TimeVal(RTT / 1000000, RTT % 1000000);
+            unsigned short hopsBack = travelled > 0 ? travelled - 1 : 0;
+            record->setRplyAddress(InetAddress(replying));
+            record->setRplyTime(rplyTime);
+            record->setRplyICMPtype(type);
+            record->setRplyICMPcode(code);
+            record->setRplyTTL(router->initialTTL > hopsBack ? router->initialTTL - hopsBack : 1);
+            record->setRplyIPidentifier(nextIPIdentifier(router, replying, IPIdentifier, time));
+            if(type == DirectProber::ICMP_TYPE_TIME_EXCEEDED)
+            {
+                record->setPayloadTTL(1);
+            }
+            else if(type == DirectProber::ICMP_TYPE_TS_REPLY)
+            {
+                unsigned long originate = (unsigned long) DirectProber::getUTTimeSinceMidnight();
+                record->setOriginateTs(originate);
+                record->setReceiveTs(originate + RTT / 2000);
+                record->setTransmitTs(originate + RTT / 2000);
+            }
+            nbReplies++;
+        }
+    }
+    waitingTime += RTT;
+    if(record->getRplyTime() > clock)
+        clock = record->getRplyTime();
+    networkMutex.unlock();
+
+    return record;
+}
+
+TimeVal SimulatedNetwork::getCurrentTime()
+{
+    networkMutex.lock();
+    TimeVal current = clock;
+    networkMutex.unlock();
+    return current;
+}
+
+string SimulatedNetwork::resolveHostName(const InetAddress &ip)
+{
+    map<unsigned long, string>::iterator it = hostNames.find(ip.getULongAddress());
+    if(it != hostNames.end())
+        return it->second;
+    return "";
+}
+
+void SimulatedNetwork::outputSummary(ostream *out)
+{
+    networkMutex.lock();
+    (*out) << "Simulated network: " << subnets.size() << " subnets, " << interfaces.size();
+    (*out) << " IPs and " << routers.size() << " routers.\n";
+    (*out) << "Simulated probes: " << nbProbes << " (" << nbReplies << " replies, ";
+    (*out) << nbLost << " lost, " << nbRateLimited << " rate-limited, " << nbTimeouts;
+    (*out) << " replies after the timeout).\n";
+    (*out) << "Time the probes would have spent waiting for replies or timeouts: ";
+    (*out) << (waitingTime / 1000) << " ms (summed over all probes)." << endl;
+    networkMutex.unlock();
+}
+
+uint64_t SimulatedNetwork::hash(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+    // Successive rounds of the SplitMix64 finalizer
+    uint64_t values[4] = {a, b, c, d};
+    uint64_t h = seed;
+    for(unsigned short i = 0; i < 4; i++)
+    {
+        h ^= values[i];
+        h += 0x9E3779B97F4A7C15ULL;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= (h >> 31);
+    }
+    return h;
+}
+
+double SimulatedNetwork::uniform(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+    return (double) (hash(a, b, c, d) >> 11) / 9007199254740992.0; // 2^53
+}
+
+unsigned long SimulatedNetwork::toNetworkTime(const TimeVal &time)
+{
+    if(time <= origin)
+        return 0;
+    TimeVal elapsed = time - origin;
+    return (unsigned long) elapsed.getSecondsPart() * 1000000UL + (unsigned long) elapsed.getMicroSecondsPart();
+}
+
+bool SimulatedNetwork::compareSubnets(const Subnet &s1, const Subnet &s2)
+{
+    return s1.lower < s2.lower;
+}
+
+bool SimulatedNetwork::compareInterfaces(const Interface &i1, const Interface &i2)
+{
+    if(i1.ip != i2.ip)
+        return i1.ip < i2.ip;
+    if(i1.live != i2.live)
+        return i1.live;
+    return i1.TTL < i2.TTL;
+}
+
+SimulatedNetwork::Interface *SimulatedNetwork::findInterface(unsigned long ip)
+{
+    size_t low = 0, high = interfaces.size();
+    while(low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if(interfaces[mid].ip < ip)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if(low < interfaces.size() && interfaces[low].ip == ip)
+        return &interfaces[low];
+    return NULL;
+}
+
+SimulatedNetwork::Subnet *SimulatedNetwork::findSubnet(unsigned long ip)
+{
+    // Last subnet whose lower border is not above the IP
+    size_t low = 0, high = subnets.size();
+    while(low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if(subnets[mid].lower <= ip)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if(low > 0 && subnets[low - 1].upper >= ip)
+        return &subnets[low - 1];
+    return NULL;
+}
+
+void SimulatedNetwork::setCounter(Router *router, IPTableEntry *entry, unsigned short nbIPIDs, unsigned long ip)
+{
+    router->nbReplies = 0;
+    router->initialTTL = 64;
+    if(entry != NULL && entry->getEchoInitialTTL() > 0)
+        router->initialTTL = entry->getEchoInitialTTL();
+
+    if(entry != NULL && entry->getIPIDCounterType() == IPTableEntry::ECHO_COUNTER)
+    {
+        router->counterType = IPTableEntry::ECHO_COUNTER;
+        router->base = 0.0;
+        router->velocity = 0.0;
+        return;
+    }
+
+    if(entry != NULL && entry->hasIPIDData())
+    {
+        // Velocity is estimated from the IP-IDs (0 means missing) and the delays between them
+        double increase = 0.0, elapsed = 0.0;
+        for(unsigned short i = 0; i + 1 < nbIPIDs; i++)
+        {
+            unsigned long first = entry->getIPIdentifier(i), second = entry->getIPIdentifier(i + 1);
+            if(first == 0 || second == 0)
+                continue;
+            increase += (double) ((second + 65536 - first) % 65536);
+            elapsed += (double) entry->getDelay(i);
+        }
+
+        router->base = (double) entry->getIPIdentifier(0);
+        router->velocity = elapsed > 0.0 ? increase / elapsed * 1000000.0 : 0.0;
+        if(router->velocity > RANDOM_COUNTER_VELOCITY)
+            router->counterType = IPTableEntry::RANDOM_COUNTER;
+        else
+            router->counterType = IPTableEntry::HEALTHY_COUNTER;
+        return;
+    }
+
+    // No data (e.g., IPs which were not probed for alias resolution): slow healthy counter
+    router->counterType = IPTableEntry::HEALTHY_COUNTER;
+    router->base = (double) (hash(4, ip) % 65536);
+    router->velocity = (double) (10 + hash(5, ip) % 1000);
+}
+
+unsigned long SimulatedNetwork::getHop(unsigned int route, unsigned short routeSize, unsigned char TTL, uint64_t flow)
+{
+    if(TTL == 0 || TTL > routeSize)
+        return 0;
+
+    unsigned long hop = hops[route + TTL - 1];
+    if(hop == 0 || loadBalancingRate == 0.0 || uniform(6, hop, TTL) >= loadBalancingRate)
+        return hop;
+
+    // Load-balanced hop: half of the flows go through another hop seen at the same TTL
+    vector<unsigned long> &alternatives = hopsPerTTL[TTL - 1];
+    uint64_t h = hash(7, hop, flow);
+    if((h & 1) == 0 || alternatives.size() < 2)
+        return hop;
+    return alternatives[(size_t) ((h >> 1) % alternatives.size())];
+}
+
+bool SimulatedNetwork::takeToken(Router *router, unsigned long time)
+{
+    if(rateLimit == 0)
+        return true;
+
+    // Probers have their own clocks, so a probe can be older than the last one of the router
+    if(time < router->lastRefill)
+        time = router->lastRefill;
+    double refill = (double) (time - router->lastRefill) * (double) rateLimit / 1000000.0;
+    router->tokens += refill;
+    if(router->tokens > (double) rateLimit)
+        router->tokens = (double) rateLimit;
+    router->lastRefill = time;
+
+    if(router->tokens < 1.0)
+        return false;
+    router->tokens -= 1.0;
+    return true;
+}
+
+unsigned short SimulatedNetwork::nextIPIdentifier(Router *router,
+                                                  unsigned long ip,
+                                                  unsigned short probeIPID,
+                                                  unsigned long time)
+{
+    router->nbReplies++;
+    if(router->counterType == IPTableEntry::ECHO_COUNTER)
+        return probeIPID;
+    if(router->counterType == IPTableEntry::RANDOM_COUNTER)
+        return (unsigned short) (hash(8, ip, router->nbReplies) % 65536);
+
+    // Healthy counter: increases with time and with each reply of the router
+    double value = router->base + router->velocity * (double) time / 1000000.0;
+    return (unsigned short) (((unsigned long) value + router->nbReplies) % 65536);
+}
@@ -0,0 +1,192 @@
+/*
+ * SimulatedNetwork.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * SimulatedNetwork answers the probes of SimulatedProber objects (see prober/simulated/) from an
+ * in-memory topology built out of a dataset (subnets and their routes, IP dictionnary and, if
+ * available, the .alias file). It allows to run all probing phases of Forester (traceroute,
+ * anonymous hops check, route verification and alias resolution hints collection) without
+ * privileges nor network access, e.g., to measure the throughput of the probing phases and the
+ * amount of probes they need on a large (possibly synthetic) dataset, or to check that an
+ * optimization does not change their outcome.
+ *
+ * The model is the following:
+ * -an IP of a subnet (or of a route) is located at the TTL given by the dataset, and a probe
+ *  with a smaller TTL gets a "time exceeded" reply from the hop of the route at that TTL (no
+ *  reply if the hop is anonymous or unknown);
+ * -each router (one line of the .alias file, otherwise one IP) has an IP-ID counter which
+ *  behaves like the IP dictionnary suggests (echo, random or healthy counter, the velocity of
+ *  the latter being estimated from the IP-IDs and delays of the dictionnary), an initial TTL,
+ *  and optionally a rate limit on its replies;
+ * -the timestamp replies, the source IP of port unreachable replies and the host names are the
+ *  ones of the IP dictionnary;
+ * -hops can be load-balanced (the flow ID of the probe then selects the hop among other hops
+ *  seen at the same TTL), routers can be anonymous and probes can be lost;
+ * -the round-trip time grows with the TTL (latency per hop plus some jitter), and a reply which
+ *  would arrive after the timeout is not seen.
+ *
+ * All "random" decisions are derived from a seed and the content of the probe, such that a run
+ * can be reproduced. Time is virtual (see ProbeResponder.h): a probe gets its reply immediately,
+ * but the prober which sent it moves its own clock to the time of the reply (or of the timeout),
+ * and a unit waiting for some time (e.g., the schedule of IP-ID probes) only moves this clock.
+ * The IP-ID counters and the rate limits follow the time of the probes, and the units
+ * collecting IP-IDs time them with the clock of their prober, so velocities are consistent
+ * while nothing is actually waited for. The time the replies would have taken is also summed
+ * (see outputSummary()).
+ *
+ * Settings are given as a list of "key=value" separated by commas (see configure() and the
+ * usage of Forester for the list of keys).
+ */
+
+#ifndef SIMULATEDNETWORK_H_
+#define SIMULATEDNETWORK_H_
+
+#include <ostream>
+using std::ostream;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include <map>
+using std::map;
+#include <inttypes.h>
+
+#include "../TreeNETEnvironment.h"
+#include "../../prober/simulated/ProbeResponder.h"
+#include "../../common/thread/Mutex.h"
+
+class SimulatedNetwork : public ProbeResponder
+{
+public:
+
+    // Constructor, destructor
+    SimulatedNetwork();
+    ~SimulatedNetwork();
+
+    /*
+     * Parses the settings "key1=value1,key2=value2,...". Keys which are not set keep their
+     * default value. Returns false (and sets error) if a key is unknown or a value is invalid.
+     */
+
+    bool configure(string settings, string *error);
+
+    /*
+     * Builds the topology from the subnets and the IP dictionnary of env, and from aliasFile if
+     * it exists (otherwise, each IP is a router on its own). It must be called right after the
+     * parsing, i.e., before routes or hints are collected again. Returns false if there is no
+     * subnet to build the topology from.
+     */
+
+    bool build(TreeNETEnvironment *env, string aliasFile);
+
+    // Methods of ProbeResponder (see ProbeResponder.h)
+    ProbeRecord *respond(const InetAddress &dst,
+                         unsigned short IPIdentifier,
+                         unsigned char TTL,
+                         int protocol,
+                         bool timestampRequest,
+                         bool usingFixedFlowID,
+                         unsigned short srcPortORICMPid,
+                         unsigned short dstPortORICMPseq,
+                         const TimeVal &timeout,
+                         const TimeVal &reqTime);
+    TimeVal getCurrentTime();
+    string resolveHostName(const InetAddress &ip);
+
+    // Sums up the topology and the probes which were answered so far
+    void outputSummary(ostream *out);
+
+private:
+
+    // Subnet (IPs of the subnet which are not listed as interfaces are located at its TTL)
+    struct Subnet
+    {
+        unsigned long lower, upper;
+        unsigned int route; // Offset of the route in hops
+        unsigned short routeSize;
+        unsigned char TTL;
+    };
+
+    // Known IP, either listed in a subnet or seen in a route
+    struct Interface
+    {
+        unsigned long ip;
+        unsigned int route;
+        unsigned short routeSize;
+        unsigned char TTL;
+        unsigned int router;
+        bool live; // Replies to probes it is the destination of
+        bool replyingToTS;
+        unsigned long portUnreachableSrcIP;
+    };
+
+    // Router, with its IP-ID counter (see IPTableEntry::IPIDCounterClasses) and rate limit
+    struct Router
+    {
+        unsigned short counterType;
+        double base, velocity; // Healthy counters (velocity in IP-IDs per second)
+        unsigned long nbReplies;
+        unsigned char initialTTL;
+        bool anonymous;
+        double tokens;
+        unsigned long lastRefill;
+    };
+
+    // Velocity (in IP-IDs per second) above which a counter is deemed random
+    static const double RANDOM_COUNTER_VELOCITY;
+
+    // Settings
+    uint64_t seed;
+    unsigned long latency, jitter; // In microseconds
+    unsigned long rateLimit; // Replies per second and per router (0 = no limit)
+    double loadBalancingRate, anonymousRate, lossRate;
+
+    // Topology
+    vector<unsigned long> hops; // Routes of all subnets, one after the other
+    vector<Subnet> subnets; // Sorted by lower border
+    vector<Interface> interfaces; // Sorted by IP
+    vector<Router> routers;
+    vector<vector<unsigned long> > hopsPerTTL; // Distinct hops seen at each TTL (load balancing)
+    map<unsigned long, string> hostNames;
+
+    // State and statistics (protected by the mutex)
+    Mutex networkMutex;
+    TimeVal origin; // Time 0 of the counters and rate limits (virtual clock)
+    TimeVal clock; // Latest time reached by the probers (see ProbeResponder.h)
+    unsigned long nbProbes, nbReplies, nbLost, nbRateLimited, nbTimeouts;
+    unsigned long long waitingTime; // Time spent waiting for replies or timeouts, in microseconds
+
+    // Hash of up to four values (with the seed), and the same mapped to [0,1[
+    uint64_t hash(uint64_t a, uint64_t b = 0, uint64_t c = 0, uint64_t d = 0);
+    double uniform(uint64_t a, uint64_t b = 0, uint64_t c = 0, uint64_t d = 0);
+
+    // Time of the network (in microseconds since origin) at a given time of the virtual clock
+    unsigned long toNetworkTime(const TimeVal &time);
+
+    // Orders subnets by lower border, and interfaces by IP (live entry first, then smallest TTL)
+    static bool compareSubnets(const Subnet &s1, const Subnet &s2);
+    static bool compareInterfaces(const Interface &i1, const Interface &i2);
+
+    // Finds an interface (resp. the subnet containing an IP), NULL if unknown
+    Interface *findInterface(unsigned long ip);
+    Subnet *findSubnet(unsigned long ip);
+
+    /*
+     * Builds the IP-ID counter of a router from the IP dictionnary entry of one of its IPs (with
+     * nbIPIDs IP-IDs), or from the hash of one of its IPs if there is no entry with IP-IDs.
+     */
+
+    void setCounter(Router *router, IPTableEntry *entry, unsigned short nbIPIDs, unsigned long ip);
+
+    // Hop replying at a given TTL (0 for none), given the route towards the destination
+    unsigned long getHop(unsigned int route, unsigned short routeSize, unsigned char TTL, uint64_t flow);
+
+    // Takes a token of a router (false if it is rate-limited) and gives its next IP-ID
+    bool takeToken(Router *router, unsigned long time);
+    unsigned short nextIPIdentifier(Router *router, unsigned long ip, unsigned short probeIPID, unsigned long time);
+
+};
+
+#endif /* SIMULATEDNETWORK_H_ */
@@ -26,6 +26,18 @@ using std::flush;
 SubnetParser::SubnetParser(TreeNETEnvironment *env)
 {
     this->env = env;
+    this->out = NULL;
+    this->parsedSubnets = 0;
+    this->credibleSubnets = 0;
+    this->mergedSubnets = 0;
+    this->duplicateSubnets = 0;
+    this->badSubnets = 0;
+}
+
+SubnetParser::SubnetParser(TreeNETEnvironment *env, ostream *out)
+{
+    this->env = env;
+    this->out = out;
     this->parsedSubnets = 0;
     this->credibleSubnets = 0;
     this->mergedSubnets = 0;
@@ -37,6 +49,13 @@ SubnetParser::~SubnetParser()
 {
 }
 
+ostream *SubnetParser::getOutputStream()
+{
+    if(this->out != NULL)
+        return this->out;
+    return env->getOutputStream();
+}
+
 bool SubnetParser::parse(string inputFileName)
 {
     return this->parse(inputFileName, env->getSubnetSet());
@@ -44,7 +63,7 @@ bool SubnetParser::parse(string inputFileName)
 
 bool SubnetParser::parse(string inputFileName, SubnetSiteSet *dest)
 {
-    ostream *out = env->getOutputStream();
+    ostream *out = this->getOutputStream();
     (*out) << "Parsing " << inputFileName << "..." << endl;
     
     // Resetting count fields for next parsing.
@@ -82,7 +101,7 @@ bool SubnetParser::parse(string inputFileName, SubnetSiteSet *dest)
 
 void SubnetParser::parse(SubnetSiteSet *dest, string inputFileContent)
 {
-    ostream *out = env->getOutputStream();
+    ostream *out = this->getOutputStream();
     unsigned short displayMode = env->getDisplayMode();
     bool useMerging = env->usingMergingAtParsing();
     
@@ -149,20 +168,16 @@ void SubnetParser::parse(SubnetSiteSet *dest, string inputFileContent)
                         this->duplicateSubnets++;
                         
                         if(displayMode >= TreeNETEnvironment::DISPLAY_MODE_SLIGHTLY_VERBOSE)
-                        {
                             (*out) << "Duplicate subnet: " << subnetStr << endl;
-                            delete temp;
-                        }
+                        delete temp;
                     }
                     else if(result == SubnetSiteSet::SMALLER_SUBNET)
                     {
                         this->mergedSubnets++;
                         
                         if(displayMode >= TreeNETEnvironment::DISPLAY_MODE_SLIGHTLY_VERBOSE)
-                        {
                             (*out) << "Merged with equivalent/larger subnet: " << subnetStr << endl;
-                            delete temp;
-                        }
+                        delete temp;
                     }
                     else if(result == SubnetSiteSet::BIGGER_SUBNET)
                     {
@@ -547,6 +562,12 @@ void SubnetParser::parse(SubnetSiteSet *dest, string inputFileContent)
     }
     delete temp;
     
+    // Subnets with identical routes share a single copy of them
+    RouteStore *store = env->getRouteStore();
+    list<SubnetSite*> *parsed = dest->getSubnetSiteList();
+    for(list<SubnetSite*>::iterator it = parsed->begin(); it != parsed->end(); ++it)
+        (*it)->shareRoutes(store);
+    
     // Summary of parsing
     if(this->parsedSubnets > 0)
     {
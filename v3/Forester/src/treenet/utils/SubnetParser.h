@@ -38,8 +38,9 @@ class SubnetParser
 {
 public:
 
-    // Constructor, destructor
+    // Constructors (second one writes messages in a given stream), destructor
     SubnetParser(TreeNETEnvironment *env);
+    SubnetParser(TreeNETEnvironment *env, ostream *out);
     ~SubnetParser();
     
     // Parsing methods (returns true if a file was indeed parsed)
@@ -51,6 +52,9 @@ private:
     // Pointer to the environment variable
     TreeNETEnvironment *env;
     
+    // Stream for messages (NULL for the output stream of the environment)
+    ostream *out;
+    
     // Fields to count, during parsing, correctly parsed subnets along merging and bad parsings
     unsigned int parsedSubnets, credibleSubnets, mergedSubnets, duplicateSubnets, badSubnets;
     
@@ -62,6 +66,9 @@ private:
      */
     
     void parse(SubnetSiteSet *dest, string inputFileContent);
+    
+    // Gets the stream for messages
+    ostream *getOutputStream();
 
 };
 
@@ -0,0 +1,396 @@
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in Telemetry.h (see this file to learn further about the goals
+ * of such class).
+ */
+
+#include <cstdio> // For rename()
+#include <ctime> // For clock_gettime()
+#include <sys/resource.h> // For getrusage()
+#include <iostream>
+using std::endl;
+#include <fstream>
+using std::ofstream;
+
+#include "Telemetry.h"
+
+const char *Telemetry::PHASE_NAMES[NB_PHASES] = {"unknown",
+                                                 "traceroute",
+                                                 "anonymous_check",
+                                                 "ip_id",
+                                                 "timestamp",
+                                                 "udp_unreachable_port"};
+
+const char *Telemetry::STEP_NAMES[NB_STEPS] = {"parsing",
+                                               "traceroute",
+                                               "repair",
+                                               "post_processing",
+                                               "growth",
+                                               "hints_collection",
+                                               "alias_resolution",
+                                               "output"};
+
+Telemetry::Telemetry():
+telemetryMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    for(unsigned short i = 0; i < NB_PHASES; i++)
+    {
+        PhaseFigures &p = phases[i];
+        p.probes = 0;
+        p.replies = 0;
+        p.timeouts = 0;
+        p.socketErrors = 0;
+        for(unsigned short j = 0; j < DirectProber::NB_RTT_BUCKETS; j++)
+            p.RTTHistogram[j] = 0;
+        p.RTTSum = 0;
+        p.probers = 0;
+        p.inFlight = 0;
+        p.maxInFlight = 0;
+    }
+    for(unsigned short i = 0; i < NB_STEPS; i++)
+    {
+        steps[i].elapsed = 0;
+        steps[i].probes = 0;
+        steps[i].peakRSS = 0;
+        steps[i].entered = 0;
+    }
+    this->start = now();
+    this->currentStep = -1;
+    this->stepStart = 0;
+    this->stepProbes = 0;
+}
+
+Telemetry::~Telemetry()
+{
+}
+
+void Telemetry::enterStep(unsigned short step)
+{
+    if(step >= NB_STEPS)
+        return;
+
+    telemetryMutex.lock();
+    uint64_t time = now();
+    this->closeStep(time);
+    this->currentStep = (int) step;
+    this->stepStart = time;
+    this->stepProbes = getTotalProbes();
+    steps[step].entered++;
+    telemetryMutex.unlock();
+}
+
+void Telemetry::leaveStep()
+{
+    telemetryMutex.lock();
+    this->closeStep(now());
+    telemetryMutex.unlock();
+}
+
+void Telemetry::newProber(unsigned char phase)
+{
+    if(phase >= NB_PHASES)
+        phase = 0;
+
+    PhaseFigures &p = phases[phase];
+    __sync_fetch_and_add(&p.probers, 1);
+    unsigned long inFlight = __sync_add_and_fetch(&p.inFlight, 1);
+    
+    // Raises the maximum unless another prober already raised it higher
+    unsigned long max = p.maxInFlight;
+    while(inFlight > max)
+    {
+        unsigned long seen = __sync_val_compare_and_swap(&p.maxInFlight, max, inFlight);
+        if(seen == max)
+            break;
+        max = seen;
+    }
+}
+
+void Telemetry::mergeProber(DirectProber *prober)
+{
+    unsigned char phase = prober->getPhase();
+    if(phase >= NB_PHASES)
+        phase = 0;
+
+    PhaseFigures &p = phases[phase];
+    __sync_fetch_and_add(&p.probes, (uint64_t) prober->getNbProbes());
+    __sync_fetch_and_add(&p.replies, (uint64_t) prober->getNbSuccessfulProbes());
+    __sync_fetch_and_add(&p.timeouts, (uint64_t) prober->getNbTimeouts());
+    __sync_fetch_and_add(&p.socketErrors, (uint64_t) prober->getNbSocketErrors());
+    for(unsigned short i = 0; i < DirectProber::NB_RTT_BUCKETS; i++)
+    {
+        uint64_t nbRTTs = (uint64_t) prober->getNbRTTs(i);
+        if(nbRTTs > 0)
+            __sync_fetch_and_add(&p.RTTHistogram[i], nbRTTs);
+    }
+    __sync_fetch_and_add(&p.RTTSum, (uint64_t) prober->getRTTSum());
+    
+    // Decrements the amount of probers in flight, without going below 0 (unregistered prober)
+    unsigned long inFlight = p.inFlight;
+    while(inFlight > 0)
+    {
+        unsigned long seen = __sync_val_compare_and_swap(&p.inFlight, inFlight, inFlight - 1);
+        if(seen == inFlight)
+            break;
+        inFlight = seen;
+    }
+}
+
+void Telemetry::output(ostream *out, unsigned short format)
+{
+    telemetryMutex.lock();
+    if(format == FORMAT_PROMETHEUS)
+        this->outputPrometheus(out, now());
+    else
+        this->outputJSON(out, now());
+    telemetryMutex.unlock();
+}
+
+bool Telemetry::output(string filename)
+{
+    string tmpFilename = filename + ".tmp";
+    ofstream file;
+    file.open(tmpFilename.c_str());
+    if(!file.is_open())
+        return false;
+    this->output(&file, getFormat(filename));
+    file.close();
+    return rename(tmpFilename.c_str(), filename.c_str()) == 0;
+}
+
+unsigned short Telemetry::getFormat(string filename)
+{
+    size_t dot = filename.find_last_of('.');
+    if(dot != string::npos)
+    {
+        string extension = filename.substr(dot);
+        if(extension == ".prom" || extension == ".txt")
+            return FORMAT_PROMETHEUS;
+    }
+    return FORMAT_JSON;
+}
+
+uint64_t Telemetry::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000ULL + (uint64_t) ts.tv_nsec / 1000ULL;
+}
+
+unsigned long Telemetry::getPeakRSS()
+{
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return (unsigned long) usage.ru_maxrss; // Already in KiB on Linux
+}
+
+uint64_t Telemetry::getTotalProbes()
+{
+    uint64_t total = 0;
+    for(unsigned short i = 0; i < NB_PHASES; i++)
+        total += __sync_fetch_and_add(&phases[i].probes, (uint64_t) 0);
+    return total;
+}
+
+void Telemetry::readPhase(unsigned short phase, PhaseFigures *copy)
+{
+    PhaseFigures &p = phases[phase];
+    copy->probes = __sync_fetch_and_add(&p.probes, (uint64_t) 0);
+    copy->replies = __sync_fetch_and_add(&p.replies, (uint64_t) 0);
+    copy->timeouts = __sync_fetch_and_add(&p.timeouts, (uint64_t) 0);
+    copy->socketErrors = __sync_fetch_and_add(&p.socketErrors, (uint64_t) 0);
+    for(unsigned short i = 0; i < DirectProber::NB_RTT_BUCKETS; i++)
+        copy->RTTHistogram[i] = __sync_fetch_and_add(&p.RTTHistogram[i], (uint64_t) 0);
+    copy->RTTSum = __sync_fetch_and_add(&p.RTTSum, (uint64_t) 0);
+    copy->probers = __sync_fetch_and_add(&p.probers, 0UL);
+    copy->inFlight = __sync_fetch_and_add(&p.inFlight, 0UL);
+    copy->maxInFlight = __sync_fetch_and_add(&p.maxInFlight, 0UL);
+}
+
+void Telemetry::closeStep(uint64_t time)
+{
+    if(currentStep < 0)
+        return;
+
+    StepFigures &s = steps[currentStep];
+    s.elapsed += time - stepStart;
+    s.probes += getTotalProbes() - stepProbes;
+    s.peakRSS = getPeakRSS();
+    this->currentStep = -1;
+}
+
+void Telemetry::outputJSON(ostream *out, uint64_t time)
+{
+    (*out) << "{\n";
+    (*out) << "  \"uptime_us\": " << (time - start) << ",\n";
+    (*out) << "  \"peak_rss_kib\": " << getPeakRSS() << ",\n";
+    (*out) << "  \"current_step\": ";
+    if(currentStep >= 0)
+        (*out) << "\"" << STEP_NAMES[currentStep] << "\",\n";
+    else
+        (*out) << "null,\n";
+
+    (*out) << "  \"steps\": [\n";
+    for(unsigned short i = 0; i < NB_STEPS; i++)
+    {
+        // The current step is accounted up to now
+        uint64_t elapsed = steps[i].elapsed, probes = steps[i].probes;
+        unsigned long peakRSS = steps[i].peakRSS;
+        if((int) i == currentStep)
+        {
+            elapsed += time - stepStart;
+            probes += getTotalProbes() - stepProbes;
+            peakRSS = getPeakRSS();
+        }
+
+        (*out) << "    {\"name\": \"" << STEP_NAMES[i] << "\", ";
+        (*out) << "\"entered\": " << steps[i].entered << ", ";
+        (*out) << "\"elapsed_us\": " << elapsed << ", ";
+        (*out) << "\"probes\": " << probes << ", ";
+        (*out) << "\"peak_rss_kib\": " << peakRSS << "}";
+        if(i < NB_STEPS - 1)
+            (*out) << ",";
+        (*out) << "\n";
+    }
+    (*out) << "  ],\n";
+
+    (*out) << "  \"phases\": [\n";
+    for(unsigned short i = 0; i < NB_PHASES; i++)
+    {
+        PhaseFigures p;
+        this->readPhase(i, &p);
+        (*out) << "    {\"name\": \"" << PHASE_NAMES[i] << "\", ";
+        (*out) << "\"probes\": " << p.probes << ", ";
+        (*out) << "\"replies\": " << p.replies << ", ";
+        (*out) << "\"timeouts\": " << p.timeouts << ", ";
+        (*out) << "\"socket_errors\": " << p.socketErrors << ", ";
+        (*out) << "\"probers\": " << p.probers << ", ";
+        (*out) << "\"probers_in_flight\": " << p.inFlight << ", ";
+        (*out) << "\"max_probers_in_flight\": " << p.maxInFlight << ",\n";
+        (*out) << "     \"rtt_sum_us\": " << p.RTTSum << ", ";
+        (*out) << "\"rtt_histogram_us\": [";
+        for(unsigned short j = 0; j < DirectProber::NB_RTT_BUCKETS; j++)
+        {
+            if(j > 0)
+                (*out) << ", ";
+            (*out) << "{\"lt\": ";
+            if(j < DirectProber::NB_RTT_BUCKETS - 1)
+                (*out) << DirectProber::getRTTBucketBound(j);
+            else
+                (*out) << "null";
+            (*out) << ", \"count\": " << p.RTTHistogram[j] << "}";
+        }
+        (*out) << "]}";
+        if(i < NB_PHASES - 1)
+            (*out) << ",";
+        (*out) << "\n";
+    }
+    (*out) << "  ]\n";
+    (*out) << "}" << endl;
+}
+
+void Telemetry::outputPrometheus(ostream *out, uint64_t time)
+{
+    (*out) << "# HELP forester_uptime_microseconds Time elapsed since the start of the run.\n";
+    (*out) << "# TYPE forester_uptime_microseconds gauge\n";
+    (*out) << "forester_uptime_microseconds " << (time - start) << "\n";
+    (*out) << "# HELP forester_peak_rss_kibibytes Peak resident memory of the process.\n";
+    (*out) << "# TYPE forester_peak_rss_kibibytes gauge\n";
+    (*out) << "forester_peak_rss_kibibytes " << getPeakRSS() << "\n";
+
+    // Steps
+    (*out) << "# HELP forester_step_microseconds Time spent in each algorithmic step.\n";
+    (*out) << "# TYPE forester_step_microseconds counter\n";
+    for(unsigned short i = 0; i < NB_STEPS; i++)
+    {
+        uint64_t elapsed = steps[i].elapsed;
+        if((int) i == currentStep)
+            elapsed += time - stepStart;
+        (*out) << "forester_step_microseconds{step=\"" << STEP_NAMES[i] << "\"} " << elapsed << "\n";
+    }
+    (*out) << "# HELP forester_step_probes_total Probes sent during each algorithmic step.\n";
+    (*out) << "# TYPE forester_step_probes_total counter\n";
+    for(unsigned short i = 0; i < NB_STEPS; i++)
+    {
+        uint64_t probes = steps[i].probes;
+        if((int) i == currentStep)
+            probes += getTotalProbes() - stepProbes;
+        (*out) << "forester_step_probes_total{step=\"" << STEP_NAMES[i] << "\"} " << probes << "\n";
+    }
+    (*out) << "# HELP forester_step_peak_rss_kibibytes Peak resident memory at the end of each step.\n";
+    (*out) << "# TYPE forester_step_peak_rss_kibibytes gauge\n";
+    for(unsigned short i = 0; i < NB_STEPS; i++)
+    {
+        unsigned long peakRSS = steps[i].peakRSS;
+        if((int) i == currentStep)
+            peakRSS = getPeakRSS();
+        (*out) << "forester_step_peak_rss_kibibytes{step=\"" << STEP_NAMES[i] << "\"} " << peakRSS << "\n";
+    }
+
+    // Phases (one metric at a time, as required by the format)
+    PhaseFigures figures[NB_PHASES];
+    for(unsigned short i = 0; i < NB_PHASES; i++)
+        this->readPhase(i, &figures[i]);
+    
+    const unsigned short NB_COUNTERS = 7;
+    const char *names[NB_COUNTERS] = {"probes_total",
+                                      "replies_total",
+                                      "timeouts_total",
+                                      "socket_errors_total",
+                                      "probers_total",
+                                      "probers_in_flight",
+                                      "probers_in_flight_max"};
+    const char *helps[NB_COUNTERS] = {"Probes sent.",
+                                      "Probes which got a reply.",
+                                      "Probes which got no reply before the timeout.",
+                                      "Probes which could not be sent or received.",
+                                      "Probers (i.e., probing tasks) created.",
+                                      "Probers currently running.",
+                                      "Maximum amount of probers running at once."};
+    for(unsigned short i = 0; i < NB_COUNTERS; i++)
+    {
+        bool gauge = i >= 5;
+        (*out) << "# HELP forester_" << names[i] << " " << helps[i] << "\n";
+        (*out) << "# TYPE forester_" << names[i] << " " << (gauge ? "gauge" : "counter") << "\n";
+        for(unsigned short j = 0; j < NB_PHASES; j++)
+        {
+            PhaseFigures &p = figures[j];
+            uint64_t values[NB_COUNTERS] = {p.probes,
+                                            p.replies,
+                                            p.timeouts,
+                                            p.socketErrors,
+                                            p.probers,
+                                            p.inFlight,
+                                            p.maxInFlight};
+            (*out) << "forester_" << names[i] << "{phase=\"" << PHASE_NAMES[j] << "\"} ";
+            (*out) << values[i] << "\n";
+        }
+    }
+
+    // RTT histograms (buckets are cumulative in this format)
+    (*out) << "# HELP forester_rtt_microseconds Round-trip time of the replies.\n";
+    (*out) << "# TYPE forester_rtt_microseconds histogram\n";
+    for(unsigned short i = 0; i < NB_PHASES; i++)
+    {
+        PhaseFigures &p = figures[i];
+        uint64_t cumulated = 0;
+        for(unsigned short j = 0; j < DirectProber::NB_RTT_BUCKETS; j++)
+        {
+            cumulated += p.RTTHistogram[j];
+            (*out) << "forester_rtt_microseconds_bucket{phase=\"" << PHASE_NAMES[i] << "\",le=\"";
+            if(j < DirectProber::NB_RTT_BUCKETS - 1)
+                (*out) << (DirectProber::getRTTBucketBound(j) - 1);
+            else
+                (*out) << "+Inf";
+            (*out) << "\"} " << cumulated << "\n";
+        }
+        (*out) << "forester_rtt_microseconds_sum{phase=\"" << PHASE_NAMES[i] << "\"} " << p.RTTSum << "\n";
+        (*out) << "forester_rtt_microseconds_count{phase=\"" << PHASE_NAMES[i] << "\"} " << cumulated << "\n";
+    }
+    out->flush();
+}
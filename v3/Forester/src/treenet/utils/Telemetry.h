@@ -0,0 +1,135 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Telemetry gathers performance figures over a whole run of Forester, in order to tune the
+ * probing parameters (timeout, regulating period, threads...) and to plan measurement campaigns:
+ * -for each phase of the probing (see ProbeTrace.h for the phases), the amounts of probes, of
+ *  replies, of timeouts and of socket errors, the histogram of the round-trip times, and the
+ *  amounts of probers (i.e., probing tasks or threads) created, in flight and in flight at once
+ *  at most;
+ * -for each algorithmic step (parsing, traceroute, route repair and post-processing, growth,
+ *  hints collection, alias resolution and outputs), the time spent in it, the amount of probes
+ *  sent during it and the peak memory usage of the process at its end.
+ *
+ * The probers keep their own statistics (see DirectProber.h), without any lock, which are merged
+ * in the telemetry when they are deleted (through TreeNETEnvironment::updateProbeAmounts()).
+ * Counting and merging a prober only use atomic operations (GCC __sync built-ins) on the figures
+ * of its phase, such that probing threads never wait for each other nor for the reporter. A
+ * consequence is that the probes of a prober are only counted once it is done, which matters
+ * little as each prober handles a single target or route. The mutex of the telemetry only
+ * protects the steps, which are entered by the main thread and read by the reporter.
+ *
+ * The figures are written either as JSON or as Prometheus text (exposition format), depending on
+ * the extension of the output file (see getFormat()). The file can be re-written at any time,
+ * e.g., periodically during the run by a TelemetryReporter, and is replaced atomically.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <ostream>
+using std::ostream;
+#include <string>
+using std::string;
+#include <inttypes.h> // For uint64_t
+
+#include "../../prober/DirectProber.h"
+#include "../../common/thread/Mutex.h"
+
+class Telemetry
+{
+public:
+
+    // Algorithmic steps
+    const static unsigned short STEP_PARSING = 0;
+    const static unsigned short STEP_TRACEROUTE = 1;
+    const static unsigned short STEP_REPAIR = 2;
+    const static unsigned short STEP_POST_PROCESSING = 3;
+    const static unsigned short STEP_GROWTH = 4;
+    const static unsigned short STEP_HINTS_COLLECTION = 5;
+    const static unsigned short STEP_ALIAS_RESOLUTION = 6;
+    const static unsigned short STEP_OUTPUT = 7;
+    const static unsigned short NB_STEPS = 8;
+
+    // Amount of phases (see ProbeTrace::PHASE_*)
+    const static unsigned short NB_PHASES = 6;
+
+    // Output formats
+    const static unsigned short FORMAT_JSON = 0;
+    const static unsigned short FORMAT_PROMETHEUS = 1;
+
+    // Constructor, destructor
+    Telemetry();
+    ~Telemetry();
+
+    /*
+     * Ends the current step (if any) and starts the given one. A step can be entered several
+     * times (e.g., outputs), its figures being summed. leaveStep() ends the current step.
+     */
+
+    void enterStep(unsigned short step);
+    void leaveStep();
+
+    // Counts a new prober of some phase, then merges its statistics once it is done (lock-free)
+    void newProber(unsigned char phase);
+    void mergeProber(DirectProber *prober);
+
+    // Writes the current figures in a stream, or in a file (replaced atomically)
+    void output(ostream *out, unsigned short format);
+    bool output(string filename);
+
+    // Format to use for a file: Prometheus text for .prom and .txt files, JSON otherwise
+    static unsigned short getFormat(string filename);
+
+    // Current time (monotonic clock, in microseconds) and peak resident memory (in KiB)
+    static uint64_t now();
+    static unsigned long getPeakRSS();
+
+private:
+
+    struct PhaseFigures
+    {
+        uint64_t probes, replies, timeouts, socketErrors;
+        uint64_t RTTHistogram[DirectProber::NB_RTT_BUCKETS];
+        uint64_t RTTSum; // Microseconds
+        unsigned long probers, inFlight, maxInFlight;
+    };
+
+    struct StepFigures
+    {
+        uint64_t elapsed; // Microseconds
+        uint64_t probes;
+        unsigned long peakRSS; // KiB
+        unsigned int entered;
+    };
+
+    static const char *PHASE_NAMES[NB_PHASES];
+    static const char *STEP_NAMES[NB_STEPS];
+
+    Mutex telemetryMutex;
+    uint64_t start; // Creation time (monotonic clock)
+    PhaseFigures phases[NB_PHASES];
+    StepFigures steps[NB_STEPS];
+    int currentStep; // -1 if none
+    uint64_t stepStart;
+    uint64_t stepProbes; // Total amount of probes at the start of the current step
+
+    // Total amount of probes (all phases)
+    uint64_t getTotalProbes();
+    
+    // Copies the figures of a phase (each figure is read atomically)
+    void readPhase(unsigned short phase, PhaseFigures *copy);
+
+    // Ends the current step (the mutex must be locked)
+    void closeStep(uint64_t time);
+
+    // Both formats (the mutex must be locked)
+    void outputJSON(ostream *out, uint64_t time);
+    void outputPrometheus(ostream *out, uint64_t time);
+
+};
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,57 @@
+/*
+ * TelemetryReporter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Implements the class defined in TelemetryReporter.h (see this file to learn further about the
+ * goals of such class).
+ */
+
+#include "TelemetryReporter.h"
+#include "../../common/thread/Thread.h"
+
+TelemetryReporter::TelemetryReporter(Telemetry *telemetry, string filename, unsigned int period):
+reporterMutex(Mutex::ERROR_CHECKING_MUTEX)
+{
+    this->telemetry = telemetry;
+    this->filename = filename;
+    this->period = period;
+    this->stopping = false;
+}
+
+TelemetryReporter::~TelemetryReporter()
+{
+}
+
+void TelemetryReporter::run()
+{
+    // Sleeps by slices of one second, such that stop() does not wait for a whole period
+    unsigned int slept = 0;
+    while(!this->isStopping())
+    {
+        Thread::invokeSleep(TimeVal(1, 0));
+        slept++;
+        if(slept >= period)
+        {
+            telemetry->output(filename);
+            slept = 0;
+        }
+    }
+    telemetry->output(filename);
+}
+
+void TelemetryReporter::stop()
+{
+    reporterMutex.lock();
+    this->stopping = true;
+    reporterMutex.unlock();
+}
+
+bool TelemetryReporter::isStopping()
+{
+    reporterMutex.lock();
+    bool result = this->stopping;
+    reporterMutex.unlock();
+    return result;
+}
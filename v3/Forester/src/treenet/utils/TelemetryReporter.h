@@ -0,0 +1,49 @@
+/*
+ * TelemetryReporter.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * TelemetryReporter is a Runnable which periodically writes the figures of a Telemetry object in
+ * a file while Forester is running, such that long phases (e.g., a traceroute campaign or the
+ * collection of alias resolution hints on a large dataset) can be monitored. It runs until
+ * stop() is called, then writes the file a last time.
+ */
+
+#ifndef TELEMETRYREPORTER_H_
+#define TELEMETRYREPORTER_H_
+
+#include <string>
+using std::string;
+
+#include "Telemetry.h"
+#include "../../common/thread/Runnable.h"
+#include "../../common/thread/Mutex.h"
+#include "../../common/date/TimeVal.h"
+
+class TelemetryReporter : public Runnable
+{
+public:
+
+    // Default period between two writes (in seconds)
+    static const unsigned int DEFAULT_PERIOD = 10;
+
+    TelemetryReporter(Telemetry *telemetry, string filename, unsigned int period = DEFAULT_PERIOD);
+    ~TelemetryReporter();
+
+    void run();
+    void stop();
+
+private:
+
+    Telemetry *telemetry;
+    string filename;
+    unsigned int period;
+    bool stopping;
+    Mutex reporterMutex;
+
+    bool isStopping();
+
+};
+
+#endif /* TELEMETRYREPORTER_H_ */